@@ -665,6 +665,25 @@ class V8_EXPORT HeapProfiler {
       ActivityControl* control = NULL,
       ObjectNameResolver* global_object_name_resolver = NULL);
 
+  /**
+   * Takes a heap snapshot and writes it to |stream| in a compact binary
+   * format while the heap is walked. Unlike TakeHeapSnapshot, the edges of
+   * the heap graph are not kept in memory and no snapshot is retained.
+   * Returns false if the snapshot was aborted by |control| or |stream|.
+   * Use ConvertBinaryHeapSnapshotToJSON to obtain the JSON format.
+   */
+  bool TakeHeapSnapshotToStream(
+      OutputStream* stream, ActivityControl* control = NULL,
+      ObjectNameResolver* global_object_name_resolver = NULL);
+
+  /**
+   * Converts a snapshot written by TakeHeapSnapshotToStream into the JSON
+   * format described at HeapSnapshot::Serialize. Does not require an
+   * isolate. Returns false if |data| is malformed or |stream| aborted.
+   */
+  static bool ConvertBinaryHeapSnapshotToJSON(const char* data, size_t size,
+                                              OutputStream* stream);
+
   /**
    * Starts tracking of heap objects population statistics. After calling
    * this method, all heap objects relocations done by the garbage collector
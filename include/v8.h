@@ -19,6 +19,7 @@
 #include <stdint.h>
 #include <stdio.h>
 #include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -5362,6 +5363,144 @@ class V8_EXPORT HeapCodeStatistics {
   friend class Isolate;
 };
 
+/**
+ * Distribution of the main thread pauses of one kind of garbage collection
+ * work since the isolate was created. Percentiles are approximate: they are
+ * at most 12.5% (and at least one microsecond) above the exact value.
+ */
+class V8_EXPORT GCPauseStatistics {
+ public:
+  GCPauseStatistics();
+  size_t count() const { return count_; }
+  double total_ms() const { return total_ms_; }
+  double p50_ms() const { return p50_ms_; }
+  double p90_ms() const { return p90_ms_; }
+  double p99_ms() const { return p99_ms_; }
+  double max_ms() const { return max_ms_; }
+
+ private:
+  size_t count_;
+  double total_ms_;
+  double p50_ms_;
+  double p90_ms_;
+  double p99_ms_;
+  double max_ms_;
+
+  friend class Isolate;
+};
+
+/**
+ * Garbage collection pause distributions and allocation counters. Collected
+ * continuously, independent of --trace-gc.
+ */
+class V8_EXPORT GCStatistics {
+ public:
+  GCStatistics();
+  /** Scavenges of the young generation. */
+  const GCPauseStatistics& scavenge() const { return scavenge_; }
+  /** Incremental marking steps, including finalization steps. */
+  const GCPauseStatistics& incremental_marking_step() const {
+    return incremental_marking_step_;
+  }
+  /** Atomic pauses of full mark-compact collections. */
+  const GCPauseStatistics& mark_compact() const { return mark_compact_; }
+  /** Bytes allocated in the young generation since the isolate was created. */
+  size_t new_space_allocated_bytes() const {
+    return new_space_allocated_bytes_;
+  }
+  /** Bytes allocated in or promoted to the old generation. */
+  size_t old_generation_allocated_bytes() const {
+    return old_generation_allocated_bytes_;
+  }
+  /** Recent allocation throughput of the whole heap, 0 if unknown. */
+  double allocation_throughput_bytes_per_ms() const {
+    return allocation_throughput_bytes_per_ms_;
+  }
+
+ private:
+  GCPauseStatistics scavenge_;
+  GCPauseStatistics incremental_marking_step_;
+  GCPauseStatistics mark_compact_;
+  size_t new_space_allocated_bytes_;
+  size_t old_generation_allocated_bytes_;
+  double allocation_throughput_bytes_per_ms_;
+
+  friend class Isolate;
+};
+
+/**
+ * Time and zone memory spent in one phase of the optimizing compiler,
+ * accumulated over all compilations since the isolate was created.
+ */
+class V8_EXPORT CompilePhaseStatistics {
+ public:
+  CompilePhaseStatistics();
+  const char* phase_name() const { return phase_name_.c_str(); }
+  /** The group of phases this phase belongs to, e.g. "register allocation". */
+  const char* phase_kind_name() const { return phase_kind_name_.c_str(); }
+  double time_ms() const { return time_ms_; }
+  size_t total_allocated_bytes() const { return total_allocated_bytes_; }
+  /** Peak zone memory of the phase during a single compilation. */
+  size_t max_allocated_bytes() const { return max_allocated_bytes_; }
+
+ private:
+  std::string phase_name_;
+  std::string phase_kind_name_;
+  double time_ms_;
+  size_t total_allocated_bytes_;
+  size_t max_allocated_bytes_;
+
+  friend class Isolate;
+};
+
+/**
+ * Number of optimizations that were aborted, or of deoptimizations that
+ * happened, for one reason.
+ */
+class V8_EXPORT CompileReasonStatistics {
+ public:
+  CompileReasonStatistics();
+  const char* reason() const { return reason_; }
+  size_t count() const { return count_; }
+
+ private:
+  const char* reason_;
+  size_t count_;
+
+  friend class Isolate;
+};
+
+/**
+ * Totals of the optimizing compilers since compile statistics were enabled,
+ * see Isolate::EnableCompileStatistics.
+ */
+class V8_EXPORT CompileStatistics {
+ public:
+  CompileStatistics();
+  /** Functions that were optimized successfully. */
+  size_t optimization_count() const { return optimization_count_; }
+  /** Optimizations that were aborted, for any reason. */
+  size_t bailout_count() const { return bailout_count_; }
+  /** Deoptimizations of optimized code, for any reason. */
+  size_t deoptimization_count() const { return deoptimization_count_; }
+  /** Time spent in the TurboFan pipeline for JavaScript functions. */
+  double time_ms() const { return time_ms_; }
+  /** Zone memory allocated by the TurboFan pipeline. */
+  size_t total_allocated_bytes() const { return total_allocated_bytes_; }
+  /** Peak zone memory of a single TurboFan compilation. */
+  size_t max_allocated_bytes() const { return max_allocated_bytes_; }
+
+ private:
+  size_t optimization_count_;
+  size_t bailout_count_;
+  size_t deoptimization_count_;
+  double time_ms_;
+  size_t total_allocated_bytes_;
+  size_t max_allocated_bytes_;
+
+  friend class Isolate;
+};
+
 class RetainedObjectInfo;
 
 
@@ -5937,6 +6076,74 @@ class V8_EXPORT Isolate {
    */
   bool GetHeapCodeAndMetadataStatistics(HeapCodeStatistics* object_statistics);
 
+  /**
+   * Get pause time distributions of the garbage collector and allocation
+   * counters of the heap. Cheap enough to be polled periodically.
+   */
+  void GetGCStatistics(GCStatistics* gc_statistics);
+
+  /**
+   * Starts collecting the statistics returned by GetCompileStatistics,
+   * GetCompilePhaseStatistics, GetBailoutStatistics and
+   * GetDeoptimizationStatistics. Collecting them adds some time to every
+   * optimization, so they report nothing until this is called.
+   */
+  void EnableCompileStatistics();
+
+  /**
+   * Get the totals of the optimizing compilers. Cheap enough to be polled
+   * periodically.
+   */
+  void GetCompileStatistics(CompileStatistics* compile_statistics);
+
+  /**
+   * Returns the number of optimizing compiler phases that have run so far.
+   */
+  size_t NumberOfCompilePhases();
+
+  /**
+   * Get the time and memory spent in a phase of the optimizing compiler.
+   *
+   * \param phase_statistics The CompilePhaseStatistics object to fill in.
+   * \param index The index of the phase, in the order the phases first ran,
+   *   which ranges from 0 to NumberOfCompilePhases() - 1.
+   * \returns true on success.
+   */
+  bool GetCompilePhaseStatistics(CompilePhaseStatistics* phase_statistics,
+                                 size_t index);
+
+  /**
+   * Returns the number of reasons for aborting an optimization.
+   */
+  size_t NumberOfBailoutReasons();
+
+  /**
+   * Get the number of optimizations aborted for one reason.
+   *
+   * \param reason_statistics The CompileReasonStatistics object to fill in.
+   * \param index The index of the reason, which ranges from 0 to
+   *   NumberOfBailoutReasons() - 1.
+   * \returns true on success.
+   */
+  bool GetBailoutStatistics(CompileReasonStatistics* reason_statistics,
+                            size_t index);
+
+  /**
+   * Returns the number of reasons for deoptimizing optimized code.
+   */
+  size_t NumberOfDeoptimizationReasons();
+
+  /**
+   * Get the number of deoptimizations for one reason.
+   *
+   * \param reason_statistics The CompileReasonStatistics object to fill in.
+   * \param index The index of the reason, which ranges from 0 to
+   *   NumberOfDeoptimizationReasons() - 1.
+   * \returns true on success.
+   */
+  bool GetDeoptimizationStatistics(CompileReasonStatistics* reason_statistics,
+                                   size_t index);
+
   /**
    * Get a call stack sample from the isolate.
    * \param state Execution state.
@@ -28,6 +28,7 @@
 #include "src/bootstrapper.h"
 #include "src/char-predicates-inl.h"
 #include "src/code-stubs.h"
+#include "src/compilation-statistics.h"
 #include "src/compiler.h"
 #include "src/context-measure.h"
 #include "src/contexts.h"
@@ -40,6 +41,7 @@
 #include "src/gdb-jit.h"
 #include "src/global-handles.h"
 #include "src/globals.h"
+#include "src/heap/gc-tracer.h"
 #include "src/icu_util.h"
 #include "src/isolate-inl.h"
 #include "src/json-parser.h"
@@ -5581,6 +5583,35 @@ HeapObjectStatistics::HeapObjectStatistics()
 HeapCodeStatistics::HeapCodeStatistics()
     : code_and_metadata_size_(0), bytecode_and_metadata_size_(0) {}
 
+GCPauseStatistics::GCPauseStatistics()
+    : count_(0),
+      total_ms_(0),
+      p50_ms_(0),
+      p90_ms_(0),
+      p99_ms_(0),
+      max_ms_(0) {}
+
+GCStatistics::GCStatistics()
+    : new_space_allocated_bytes_(0),
+      old_generation_allocated_bytes_(0),
+      allocation_throughput_bytes_per_ms_(0) {}
+
+CompilePhaseStatistics::CompilePhaseStatistics()
+    : time_ms_(0),
+      total_allocated_bytes_(0),
+      max_allocated_bytes_(0) {}
+
+CompileReasonStatistics::CompileReasonStatistics()
+    : reason_(nullptr), count_(0) {}
+
+CompileStatistics::CompileStatistics()
+    : optimization_count_(0),
+      bailout_count_(0),
+      deoptimization_count_(0),
+      time_ms_(0),
+      total_allocated_bytes_(0),
+      max_allocated_bytes_(0) {}
+
 bool v8::V8::InitializeICU(const char* icu_data_file) {
   return i::InitializeICU(icu_data_file);
 }
@@ -7673,6 +7704,106 @@ bool Isolate::GetHeapCodeAndMetadataStatistics(
   return true;
 }
 
+void Isolate::GetGCStatistics(GCStatistics* gc_statistics) {
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
+  i::Heap* heap = isolate->heap();
+  i::GCTracer* tracer = heap->tracer();
+  auto fill = [](const i::PauseHistogram& histogram,
+                 GCPauseStatistics* pause_statistics) {
+    pause_statistics->count_ = static_cast<size_t>(histogram.count());
+    pause_statistics->total_ms_ = histogram.total_ms();
+    pause_statistics->p50_ms_ = histogram.Percentile(50);
+    pause_statistics->p90_ms_ = histogram.Percentile(90);
+    pause_statistics->p99_ms_ = histogram.Percentile(99);
+    pause_statistics->max_ms_ = histogram.max_ms();
+  };
+  fill(tracer->scavenge_pauses(), &gc_statistics->scavenge_);
+  fill(tracer->incremental_marking_pauses(),
+       &gc_statistics->incremental_marking_step_);
+  fill(tracer->mark_compact_pauses(), &gc_statistics->mark_compact_);
+  gc_statistics->new_space_allocated_bytes_ = heap->NewSpaceAllocationCounter();
+  gc_statistics->old_generation_allocated_bytes_ =
+      heap->OldGenerationAllocationCounter();
+  gc_statistics->allocation_throughput_bytes_per_ms_ =
+      tracer->CurrentAllocationThroughputInBytesPerMillisecond();
+}
+
+void Isolate::EnableCompileStatistics() {
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
+  isolate->set_compile_statistics_enabled(true);
+}
+
+void Isolate::GetCompileStatistics(CompileStatistics* compile_statistics) {
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
+  i::CompilationStatistics* stats = isolate->turbo_statistics();
+  if (stats == nullptr) return;
+  i::CompilationStatistics::BasicStats total;
+  stats->GetTotalStats(&total);
+  compile_statistics->optimization_count_ = stats->optimization_count();
+  compile_statistics->bailout_count_ = stats->total_bailout_count();
+  compile_statistics->deoptimization_count_ =
+      stats->total_deoptimization_count();
+  compile_statistics->time_ms_ = total.delta_.InMillisecondsF();
+  compile_statistics->total_allocated_bytes_ = total.total_allocated_bytes_;
+  compile_statistics->max_allocated_bytes_ =
+      total.absolute_max_allocated_bytes_;
+}
+
+size_t Isolate::NumberOfCompilePhases() {
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
+  i::CompilationStatistics* stats = isolate->turbo_statistics();
+  return stats == nullptr ? 0 : stats->NumberOfPhases();
+}
+
+bool Isolate::GetCompilePhaseStatistics(
+    CompilePhaseStatistics* phase_statistics, size_t index) {
+  if (!phase_statistics) return false;
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
+  if (isolate->turbo_statistics() == nullptr) return false;
+  i::CompilationStatistics::BasicStats stats;
+  if (!isolate->turbo_statistics()->GetPhaseStats(
+          index, &phase_statistics->phase_name_,
+          &phase_statistics->phase_kind_name_, &stats)) {
+    return false;
+  }
+  phase_statistics->time_ms_ = stats.delta_.InMillisecondsF();
+  phase_statistics->total_allocated_bytes_ = stats.total_allocated_bytes_;
+  phase_statistics->max_allocated_bytes_ = stats.max_allocated_bytes_;
+  return true;
+}
+
+size_t Isolate::NumberOfBailoutReasons() { return i::kLastErrorMessage; }
+
+bool Isolate::GetBailoutStatistics(CompileReasonStatistics* reason_statistics,
+                                   size_t index) {
+  if (!reason_statistics) return false;
+  if (index >= NumberOfBailoutReasons()) return false;
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
+  i::BailoutReason reason = static_cast<i::BailoutReason>(index);
+  i::CompilationStatistics* stats = isolate->turbo_statistics();
+  reason_statistics->reason_ = i::GetBailoutReason(reason);
+  reason_statistics->count_ =
+      stats == nullptr ? 0 : stats->bailout_count(reason);
+  return true;
+}
+
+size_t Isolate::NumberOfDeoptimizationReasons() {
+  return i::kDeoptimizeReasonCount;
+}
+
+bool Isolate::GetDeoptimizationStatistics(
+    CompileReasonStatistics* reason_statistics, size_t index) {
+  if (!reason_statistics) return false;
+  if (index >= NumberOfDeoptimizationReasons()) return false;
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
+  i::DeoptimizeReason reason = static_cast<i::DeoptimizeReason>(index);
+  i::CompilationStatistics* stats = isolate->turbo_statistics();
+  reason_statistics->reason_ = i::DeoptimizeReasonToString(reason);
+  reason_statistics->count_ =
+      stats == nullptr ? 0 : stats->deoptimization_count(reason);
+  return true;
+}
+
 void Isolate::GetStackSample(const RegisterState& state, void** frames,
                              size_t frames_limit, SampleInfo* sample_info) {
   RegisterState regs = state;
@@ -8712,6 +8843,29 @@ const HeapSnapshot* HeapProfiler::TakeHeapSnapshot(
 }
 
 
+bool HeapProfiler::TakeHeapSnapshotToStream(OutputStream* stream,
+                                            ActivityControl* control,
+                                            ObjectNameResolver* resolver) {
+  Utils::ApiCheck(stream->GetChunkSize() > 0,
+                  "v8::HeapProfiler::TakeHeapSnapshotToStream",
+                  "Invalid stream chunk size");
+  return reinterpret_cast<i::HeapProfiler*>(this)->TakeSnapshotToStream(
+      stream, control, resolver);
+}
+
+
+// static
+bool HeapProfiler::ConvertBinaryHeapSnapshotToJSON(const char* data,
+                                                   size_t size,
+                                                   OutputStream* stream) {
+  Utils::ApiCheck(stream->GetChunkSize() > 0,
+                  "v8::HeapProfiler::ConvertBinaryHeapSnapshotToJSON",
+                  "Invalid stream chunk size");
+  i::HeapSnapshotBinaryToJSONConverter converter(data, size);
+  return converter.Convert(stream);
+}
+
+
 void HeapProfiler::StartTrackingHeapObjects(bool track_allocations) {
   reinterpret_cast<i::HeapProfiler*>(this)->StartHeapObjectsTracking(
       track_allocations);
@@ -8835,7 +8989,8 @@ void Testing::PrepareStressRun(int run) {
 void Testing::DeoptimizeAll(Isolate* isolate) {
   i::Isolate* i_isolate = reinterpret_cast<i::Isolate*>(isolate);
   i::HandleScope scope(i_isolate);
-  internal::Deoptimizer::DeoptimizeAll(i_isolate);
+  internal::Deoptimizer::DeoptimizeAll(i_isolate,
+                                       i::DeoptimizeReason::kTesting);
 }
 
 
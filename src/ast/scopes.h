@@ -174,6 +174,10 @@ class Scope: public ZoneObject {
     return proxy;
   }
 
+  // The unresolved variables of this scope, linked through
+  // VariableProxy::next_unresolved().
+  VariableProxy* unresolved() const { return unresolved_; }
+
   void AddUnresolved(VariableProxy* proxy) {
     DCHECK(!already_resolved_);
     DCHECK(!proxy->is_resolved());
@@ -224,6 +228,11 @@ class Scope: public ZoneObject {
   // Inform the scope that the corresponding code contains an eval call.
   void RecordEvalCall() { scope_calls_eval_ = true; }
 
+  // Inform the scope that an inner scope contains an eval call. This is only
+  // needed when the inner scopes are not parsed, see
+  // Parser::SkipAnalysedFunctionBody.
+  void RecordInnerScopeEvalCall() { inner_scope_calls_eval_ = true; }
+
   // Inform the scope that the corresponding code uses "super".
   void RecordSuperPropertyUsage() { scope_uses_super_property_ = true; }
 
@@ -313,6 +322,7 @@ class Scope: public ZoneObject {
   bool calls_sloppy_eval() const {
     return scope_calls_eval_ && is_sloppy(language_mode());
   }
+  bool inner_scope_calls_eval() const { return inner_scope_calls_eval_; }
   bool outer_scope_calls_sloppy_eval() const {
     return outer_scope_calls_sloppy_eval_;
   }
@@ -10,11 +10,121 @@
 #include <malloc.h>  // NOLINT
 #endif
 
+#include "src/base/bits.h"
+#include "src/base/lazy-instance.h"
+#include "src/base/logging.h"
+#include "src/base/platform/mutex.h"
+
 namespace v8 {
 namespace base {
 
+const size_t AccountingAllocator::kMinPooledSize;
+const size_t AccountingAllocator::kMaxPooledSize;
+const size_t AccountingAllocator::kDefaultMaxPoolSize;
+
+namespace {
+
+// Free lists of unused blocks, one per size class. Shared by all allocators
+// in the process, so a block freed by one zone can be reused by any other
+// zone on any thread.
+class Pool {
+ public:
+  Pool() : size_(0), max_size_(AccountingAllocator::kDefaultMaxPoolSize) {
+    for (int i = 0; i < kNumSizeClasses; i++) free_lists_[i] = nullptr;
+  }
+
+  void* Get(size_t bytes) {
+    int size_class = SizeClass(bytes);
+    if (size_class < 0) return nullptr;
+    LockGuard<Mutex> guard(&mutex_);
+    FreeBlock* block = free_lists_[size_class];
+    if (block == nullptr) return nullptr;
+    free_lists_[size_class] = block->next;
+    size_ -= bytes;
+    return block;
+  }
+
+  bool Put(void* memory, size_t bytes) {
+    int size_class = SizeClass(bytes);
+    if (size_class < 0) return false;
+    LockGuard<Mutex> guard(&mutex_);
+    if (size_ + bytes > max_size_) return false;
+    FreeBlock* block = reinterpret_cast<FreeBlock*>(memory);
+    block->next = free_lists_[size_class];
+    free_lists_[size_class] = block;
+    size_ += bytes;
+    return true;
+  }
+
+  void Configure(size_t max_size) {
+    {
+      LockGuard<Mutex> guard(&mutex_);
+      max_size_ = max_size;
+    }
+    if (max_size < size()) Release();
+  }
+
+  void Release() {
+    FreeBlock* lists[kNumSizeClasses];
+    {
+      LockGuard<Mutex> guard(&mutex_);
+      for (int i = 0; i < kNumSizeClasses; i++) {
+        lists[i] = free_lists_[i];
+        free_lists_[i] = nullptr;
+      }
+      size_ = 0;
+    }
+    // Free outside of the lock, other threads can keep using the pool.
+    for (int i = 0; i < kNumSizeClasses; i++) {
+      while (lists[i] != nullptr) {
+        FreeBlock* next = lists[i]->next;
+        free(lists[i]);
+        lists[i] = next;
+      }
+    }
+  }
+
+  size_t size() {
+    LockGuard<Mutex> guard(&mutex_);
+    return size_;
+  }
+
+ private:
+  static const int kMinSizeLog2 = 13;
+  static const int kMaxSizeLog2 = 20;
+  static const int kNumSizeClasses = kMaxSizeLog2 - kMinSizeLog2 + 1;
+  STATIC_ASSERT(AccountingAllocator::kMinPooledSize == 1u << kMinSizeLog2);
+  STATIC_ASSERT(AccountingAllocator::kMaxPooledSize == 1u << kMaxSizeLog2);
+
+  struct FreeBlock {
+    FreeBlock* next;
+  };
+
+  // Returns -1 for sizes that aren't pooled.
+  static int SizeClass(size_t bytes) {
+    if (bytes < AccountingAllocator::kMinPooledSize ||
+        bytes > AccountingAllocator::kMaxPooledSize ||
+        !bits::IsPowerOfTwo64(bytes)) {
+      return -1;
+    }
+    return bits::CountTrailingZeros64(bytes) - kMinSizeLog2;
+  }
+
+  Mutex mutex_;
+  FreeBlock* free_lists_[kNumSizeClasses];
+  size_t size_;
+  size_t max_size_;
+
+  DISALLOW_COPY_AND_ASSIGN(Pool);
+};
+
+LazyInstance<Pool>::type pool = LAZY_INSTANCE_INITIALIZER;
+
+}  // namespace
+
 void* AccountingAllocator::Allocate(size_t bytes) {
-  void* memory = malloc(bytes);
+  void* memory = pool.Pointer()->Get(bytes);
+  if (memory == nullptr) memory = malloc(bytes);
   if (memory) {
     AtomicWord current =
         NoBarrier_AtomicIncrement(&current_memory_usage_, bytes);
@@ -27,7 +137,7 @@ void* AccountingAllocator::Allocate(size_t bytes) {
 }
 
 void AccountingAllocator::Free(void* memory, size_t bytes) {
-  free(memory);
+  if (!pool.Pointer()->Put(memory, bytes)) free(memory);
   NoBarrier_AtomicIncrement(&current_memory_usage_,
                             -static_cast<AtomicWord>(bytes));
 }
@@ -40,5 +150,23 @@ size_t AccountingAllocator::GetMaxMemoryUsage() const {
   return NoBarrier_Load(&max_memory_usage_);
 }
 
+// static
+size_t AccountingAllocator::RoundUpToPooledSize(size_t bytes) {
+  if (bytes <= kMinPooledSize) return kMinPooledSize;
+  if (bytes > kMaxPooledSize) return bytes;
+  return bits::RoundUpToPowerOfTwo32(static_cast<uint32_t>(bytes));
+}
+
+// static
+void AccountingAllocator::ConfigurePool(size_t max_pool_size) {
+  pool.Pointer()->Configure(max_pool_size);
+}
+
+// static
+void AccountingAllocator::ReleasePool() { pool.Pointer()->Release(); }
+
+// static
+size_t AccountingAllocator::GetPoolSize() { return pool.Pointer()->size(); }
+
 }  // namespace base
 }  // namespace v8
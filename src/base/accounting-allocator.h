@@ -13,6 +13,13 @@ namespace base {
 
 class AccountingAllocator {
  public:
+  // Freed blocks whose size is a power of two between these bounds are kept
+  // in a process wide pool and handed out again by later allocations of the
+  // same size, instead of going back to malloc.
+  static const size_t kMinPooledSize = 8 * 1024;
+  static const size_t kMaxPooledSize = 1024 * 1024;
+  static const size_t kDefaultMaxPoolSize = 8 * 1024 * 1024;
+
   AccountingAllocator() = default;
   virtual ~AccountingAllocator() = default;
 
@@ -23,6 +30,15 @@ class AccountingAllocator {
   size_t GetCurrentMemoryUsage() const;
   size_t GetMaxMemoryUsage() const;
 
+  // Rounds {bytes} up to the next pooled size, if there is one.
+  static size_t RoundUpToPooledSize(size_t bytes);
+
+  // Sets the maximum number of bytes retained by the pool; 0 disables it.
+  static void ConfigurePool(size_t max_pool_size);
+  // Returns all pooled blocks to the system, e.g. under memory pressure.
+  static void ReleasePool();
+  static size_t GetPoolSize();
+
  private:
   AtomicWord current_memory_usage_ = 0;
   AtomicWord max_memory_usage_ = 0;
@@ -187,6 +187,10 @@ class OS {
   // Assign memory as a guard page so that access will cause an exception.
   static void Guard(void* address, const size_t size);
 
+  // Advises the OS to back the committed region with transparent huge pages.
+  // Returns false if the OS does not support them.
+  static bool AdviseHugePages(void* address, const size_t size);
+
   // Generate a random address to be used for hinting mmap().
   static void* GetRandomMmapAddr();
 
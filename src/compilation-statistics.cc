@@ -2,6 +2,7 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <algorithm>
 #include <ostream>  // NOLINT(readability/streams)
 #include <vector>
 
@@ -11,9 +12,17 @@
 namespace v8 {
 namespace internal {
 
+CompilationStatistics::CompilationStatistics() : optimization_count_(0) {
+  std::fill(bailout_counts_, bailout_counts_ + arraysize(bailout_counts_), 0);
+  std::fill(deoptimization_counts_,
+            deoptimization_counts_ + arraysize(deoptimization_counts_), 0);
+}
+
+
 void CompilationStatistics::RecordPhaseStats(const char* phase_kind_name,
                                              const char* phase_name,
                                              const BasicStats& stats) {
+  base::LockGuard<base::Mutex> guard(&record_mutex_);
   std::string phase_name_str(phase_name);
   auto it = phase_map_.find(phase_name_str);
   if (it == phase_map_.end()) {
@@ -26,6 +35,7 @@ void CompilationStatistics::RecordPhaseStats(const char* phase_kind_name,
 
 void CompilationStatistics::RecordPhaseKindStats(const char* phase_kind_name,
                                                  const BasicStats& stats) {
+  base::LockGuard<base::Mutex> guard(&record_mutex_);
   std::string phase_kind_name_str(phase_kind_name);
   auto it = phase_kind_map_.find(phase_kind_name_str);
   if (it == phase_kind_map_.end()) {
@@ -39,11 +49,98 @@ void CompilationStatistics::RecordPhaseKindStats(const char* phase_kind_name,
 
 void CompilationStatistics::RecordTotalStats(size_t source_size,
                                              const BasicStats& stats) {
-  source_size += source_size;
+  base::LockGuard<base::Mutex> guard(&record_mutex_);
+  total_stats_.source_size_ += source_size;
   total_stats_.Accumulate(stats);
 }
 
 
+void CompilationStatistics::RecordOptimization() {
+  base::LockGuard<base::Mutex> guard(&record_mutex_);
+  optimization_count_++;
+}
+
+
+void CompilationStatistics::RecordBailout(BailoutReason reason) {
+  DCHECK_LT(reason, kLastErrorMessage);
+  base::LockGuard<base::Mutex> guard(&record_mutex_);
+  bailout_counts_[reason]++;
+}
+
+
+void CompilationStatistics::RecordDeoptimization(DeoptimizeReason reason) {
+  size_t const index = static_cast<size_t>(reason);
+  DCHECK_LT(index, arraysize(deoptimization_counts_));
+  base::LockGuard<base::Mutex> guard(&record_mutex_);
+  deoptimization_counts_[index]++;
+}
+
+
+size_t CompilationStatistics::NumberOfPhases() {
+  base::LockGuard<base::Mutex> guard(&record_mutex_);
+  return phase_map_.size();
+}
+
+
+bool CompilationStatistics::GetPhaseStats(size_t index,
+                                          std::string* phase_name,
+                                          std::string* phase_kind_name,
+                                          BasicStats* stats) {
+  base::LockGuard<base::Mutex> guard(&record_mutex_);
+  for (auto& phase : phase_map_) {
+    if (phase.second.insert_order_ != index) continue;
+    *phase_name = phase.first;
+    *phase_kind_name = phase.second.phase_kind_name_;
+    *stats = phase.second;
+    return true;
+  }
+  return false;
+}
+
+
+void CompilationStatistics::GetTotalStats(BasicStats* stats) {
+  base::LockGuard<base::Mutex> guard(&record_mutex_);
+  *stats = total_stats_;
+}
+
+
+size_t CompilationStatistics::optimization_count() {
+  base::LockGuard<base::Mutex> guard(&record_mutex_);
+  return optimization_count_;
+}
+
+
+size_t CompilationStatistics::bailout_count(BailoutReason reason) {
+  DCHECK_LT(reason, kLastErrorMessage);
+  base::LockGuard<base::Mutex> guard(&record_mutex_);
+  return bailout_counts_[reason];
+}
+
+
+size_t CompilationStatistics::deoptimization_count(DeoptimizeReason reason) {
+  size_t const index = static_cast<size_t>(reason);
+  DCHECK_LT(index, arraysize(deoptimization_counts_));
+  base::LockGuard<base::Mutex> guard(&record_mutex_);
+  return deoptimization_counts_[index];
+}
+
+
+size_t CompilationStatistics::total_bailout_count() {
+  base::LockGuard<base::Mutex> guard(&record_mutex_);
+  size_t count = 0;
+  for (size_t bailouts : bailout_counts_) count += bailouts;
+  return count;
+}
+
+
+size_t CompilationStatistics::total_deoptimization_count() {
+  base::LockGuard<base::Mutex> guard(&record_mutex_);
+  size_t count = 0;
+  for (size_t deopts : deoptimization_counts_) count += deopts;
+  return count;
+}
+
+
 void CompilationStatistics::BasicStats::Accumulate(const BasicStats& stats) {
   delta_ += stats.delta_;
   total_allocated_bytes_ += stats.total_allocated_bytes_;
@@ -9,7 +9,10 @@
 #include <string>
 
 #include "src/allocation.h"
+#include "src/bailout-reason.h"
+#include "src/base/platform/mutex.h"
 #include "src/base/platform/time.h"
+#include "src/deoptimize-reason.h"
 
 namespace v8 {
 namespace internal {
@@ -22,9 +25,13 @@ struct AsPrintableStatistics {
   const bool machine_output;
 };
 
+// Aggregates the phase statistics of TurboFan compilations, together with
+// the number of optimizations, bailouts and deoptimizations of both
+// optimizing compilers. Collected while Isolate::collect_compile_statistics()
+// holds, and safe to update from the concurrent recompilation threads.
 class CompilationStatistics final : public Malloced {
  public:
-  CompilationStatistics() {}
+  CompilationStatistics();
 
   class BasicStats {
    public:
@@ -50,6 +57,23 @@ class CompilationStatistics final : public Malloced {
 
   void RecordTotalStats(size_t source_size, const BasicStats& stats);
 
+  void RecordOptimization();
+  void RecordBailout(BailoutReason reason);
+  void RecordDeoptimization(DeoptimizeReason reason);
+
+  // Accessors for the embedder API. Phases are numbered in the order they
+  // were first seen. Names are copied, since the maps may be updated
+  // concurrently.
+  size_t NumberOfPhases();
+  bool GetPhaseStats(size_t index, std::string* phase_name,
+                     std::string* phase_kind_name, BasicStats* stats);
+  void GetTotalStats(BasicStats* stats);
+  size_t optimization_count();
+  size_t bailout_count(BailoutReason reason);
+  size_t deoptimization_count(DeoptimizeReason reason);
+  size_t total_bailout_count();
+  size_t total_deoptimization_count();
+
  private:
   class TotalStats : public BasicStats {
    public:
@@ -81,6 +105,12 @@ class CompilationStatistics final : public Malloced {
   PhaseKindMap phase_kind_map_;
   PhaseMap phase_map_;
 
+  size_t optimization_count_;
+  size_t bailout_counts_[kLastErrorMessage];
+  size_t deoptimization_counts_[kDeoptimizeReasonCount];
+
+  base::Mutex record_mutex_;
+
   DISALLOW_COPY_AND_ASSIGN(CompilationStatistics);
 };
 
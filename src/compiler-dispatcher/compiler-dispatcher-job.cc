@@ -5,7 +5,9 @@
 #include "src/compiler-dispatcher/compiler-dispatcher-job.h"
 
 #include "src/assert-scope.h"
+#include "src/compiler.h"
 #include "src/global-handles.h"
+#include "src/interpreter/interpreter.h"
 #include "src/isolate.h"
 #include "src/objects-inl.h"
 #include "src/parsing/parser.h"
@@ -20,11 +22,15 @@ CompilerDispatcherJob::CompilerDispatcherJob(Isolate* isolate,
                                              Handle<JSFunction> function,
                                              size_t max_stack_size)
     : isolate_(isolate),
-      function_(Handle<JSFunction>::cast(
-          isolate_->global_handles()->Create(*function))),
+      function_(reinterpret_cast<JSFunction**>(
+          isolate_->global_handles()->Create(*function).location())),
       max_stack_size_(max_stack_size) {
+  // The job must not keep the closure and its context chain alive, since the
+  // function might never be called. If the closure dies, the dispatcher drops
+  // the job.
+  GlobalHandles::MakeWeak(reinterpret_cast<Object***>(&function_));
   HandleScope scope(isolate_);
-  Handle<SharedFunctionInfo> shared(function_->shared(), isolate_);
+  Handle<SharedFunctionInfo> shared(function->shared(), isolate_);
   Handle<Script> script(Script::cast(shared->script()), isolate_);
   Handle<String> source(String::cast(script->source()), isolate_);
   can_parse_on_background_thread_ =
@@ -35,16 +41,21 @@ CompilerDispatcherJob::~CompilerDispatcherJob() {
   DCHECK(ThreadId::Current().Equals(isolate_->thread_id()));
   DCHECK(status_ == CompileJobStatus::kInitial ||
          status_ == CompileJobStatus::kDone);
-  i::GlobalHandles::Destroy(Handle<Object>::cast(function_).location());
+  DCHECK(!compile_job_);
+  if (function_ != nullptr) {
+    i::GlobalHandles::Destroy(reinterpret_cast<Object**>(function_));
+  }
 }
 
 void CompilerDispatcherJob::PrepareToParseOnMainThread() {
   DCHECK(ThreadId::Current().Equals(isolate_->thread_id()));
   DCHECK(status() == CompileJobStatus::kInitial);
+  DCHECK(!function_collected());
   HandleScope scope(isolate_);
+  Handle<JSFunction> function(*function_, isolate_);
   unicode_cache_.reset(new UnicodeCache());
   zone_.reset(new Zone(isolate_->allocator()));
-  Handle<SharedFunctionInfo> shared(function_->shared(), isolate_);
+  Handle<SharedFunctionInfo> shared(function->shared(), isolate_);
   Handle<Script> script(Script::cast(shared->script()), isolate_);
   DCHECK(script->type() != Script::TYPE_NATIVE);
 
@@ -77,11 +88,17 @@ void CompilerDispatcherJob::PrepareToParseOnMainThread() {
   parse_info_->set_end_position(shared->end_position());
   parse_info_->set_unicode_cache(unicode_cache_.get());
   parse_info_->set_language_mode(shared->language_mode());
+  // Inner functions are compiled lazily, so their bodies can be skipped if
+  // an earlier parse recorded their scope data.
+  parse_info_->set_allow_lazy_parsing(FLAG_lazy_inner_functions &&
+                                      !FLAG_ignition_eager);
 
   parser_.reset(new Parser(parse_info_.get()));
   parser_->DeserializeScopeChain(
-      parse_info_.get(), handle(function_->context(), isolate_),
+      parse_info_.get(), handle(function->context(), isolate_),
       Scope::DeserializationMode::kDeserializeOffHeap);
+  parser_->LoadSkippableFunctions(script, shared->start_position(),
+                                  shared->end_position());
 
   Handle<String> name(String::cast(shared->name()));
   parse_info_->set_function_name(
@@ -134,15 +151,72 @@ void CompilerDispatcherJob::FinalizeParsingOnMainThread() {
 
   InternalizeParsingResult();
 
+  status_ = CompileJobStatus::kReadyToAnalyse;
+}
+
+void CompilerDispatcherJob::PrepareToCompileOnMainThread() {
+  DCHECK(ThreadId::Current().Equals(isolate_->thread_id()));
+  DCHECK(status() == CompileJobStatus::kReadyToAnalyse);
+  DCHECK(!function_collected());
+
+  // The handles created while analysing have to survive until the bytecode
+  // is finalized, so they go into a deferred handle scope owned by the
+  // compilation info. This includes the closure, which is only kept alive
+  // until the job is done.
+  DeferredHandleScope scope(isolate_);
+  compile_info_.reset(new CompilationInfo(parse_info_.get(),
+                                          handle(*function_, isolate_)));
+  {
+    CanonicalHandleScope canonical(isolate_);
+    compile_job_.reset(
+        Compiler::PrepareBytecodeCompilationJob(compile_info_.get()));
+  }
+  compile_info_->set_deferred_handles(scope.Detach());
+
+  if (!compile_job_) {
+    status_ = CompileJobStatus::kFailed;
+    return;
+  }
+
   status_ = CompileJobStatus::kReadyToCompile;
 }
 
+void CompilerDispatcherJob::Compile() {
+  DCHECK(status() == CompileJobStatus::kReadyToCompile);
+
+  // Generating bytecode neither allocates nor dereferences handles, so it can
+  // always happen on a background thread.
+  uintptr_t stack_limit =
+      reinterpret_cast<uintptr_t>(&stack_limit) - max_stack_size_ * KB;
+
+  compile_job_->Execute(stack_limit);
+
+  status_ = CompileJobStatus::kCompiled;
+}
+
+void CompilerDispatcherJob::FinalizeCompilingOnMainThread() {
+  DCHECK(ThreadId::Current().Equals(isolate_->thread_id()));
+  DCHECK(status() == CompileJobStatus::kCompiled);
+
+  bool succeeded;
+  {
+    HandleScope scope(isolate_);
+    succeeded = Compiler::FinalizeBytecodeCompilationJob(compile_job_.get());
+  }
+  compile_job_.reset();
+  compile_info_.reset();
+
+  status_ = succeeded ? CompileJobStatus::kDone : CompileJobStatus::kFailed;
+}
+
 void CompilerDispatcherJob::ReportErrorsOnMainThread() {
   DCHECK(ThreadId::Current().Equals(isolate_->thread_id()));
   DCHECK(status() == CompileJobStatus::kFailed);
 
-  // Internalizing the parsing result will throw the error.
-  InternalizeParsingResult();
+  // Internalizing the parsing result will throw parse errors. Errors from
+  // later steps are already pending.
+  if (parser_) InternalizeParsingResult();
+  DCHECK(isolate_->has_pending_exception());
 
   status_ = CompileJobStatus::kDone;
 }
@@ -150,6 +224,9 @@ void CompilerDispatcherJob::ReportErrorsOnMainThread() {
 void CompilerDispatcherJob::ResetOnMainThread() {
   DCHECK(ThreadId::Current().Equals(isolate_->thread_id()));
 
+  compile_job_.reset();
+  compile_info_.reset();
+  handles_from_parsing_.reset();
   parser_.reset();
   unicode_cache_.reset();
   character_stream_.reset();
@@ -169,23 +246,29 @@ void CompilerDispatcherJob::InternalizeParsingResult() {
   DCHECK(status() == CompileJobStatus::kParsed ||
          status() == CompileJobStatus::kFailed);
 
-  HandleScope scope(isolate_);
-
-  // Create a canonical handle scope before internalizing parsed values if
-  // compiling bytecode. This is required for off-thread bytecode generation.
-  std::unique_ptr<CanonicalHandleScope> canonical;
-  if (FLAG_ignition) canonical.reset(new CanonicalHandleScope(isolate_));
-
-  Handle<SharedFunctionInfo> shared(function_->shared(), isolate_);
-  Handle<Script> script(Script::cast(shared->script()), isolate_);
-
-  parse_info_->set_script(script);
-  parse_info_->set_context(handle(function_->context(), isolate_));
-
-  // Do the parsing tasks which need to be done on the main thread. This will
-  // also handle parse errors.
-  parser_->Internalize(isolate_, script, parse_info_->literal() == nullptr);
-  parser_->HandleSourceURLComments(isolate_, script);
+  // The internalized values are used when compiling, so they are kept alive
+  // in a deferred handle scope.
+  DeferredHandleScope scope(isolate_);
+  {
+    // Create a canonical handle scope before internalizing parsed values if
+    // compiling bytecode. This is required for off-thread bytecode generation.
+    std::unique_ptr<CanonicalHandleScope> canonical;
+    if (FLAG_ignition) canonical.reset(new CanonicalHandleScope(isolate_));
+
+    DCHECK(!function_collected());
+    Handle<SharedFunctionInfo> shared((*function_)->shared(), isolate_);
+    Handle<Script> script(Script::cast(shared->script()), isolate_);
+
+    parse_info_->set_script(script);
+    parse_info_->set_context(handle((*function_)->context(), isolate_));
+    parse_info_->set_shared_info(shared);
+
+    // Do the parsing tasks which need to be done on the main thread. This will
+    // also handle parse errors.
+    parser_->Internalize(isolate_, script, parse_info_->literal() == nullptr);
+    parser_->HandleSourceURLComments(isolate_, script);
+  }
+  handles_from_parsing_.reset(scope.Detach());
 
   parse_info_->set_character_stream(nullptr);
   parse_info_->set_unicode_cache(nullptr);
@@ -15,6 +15,7 @@ namespace v8 {
 namespace internal {
 
 class CompilationInfo;
+class DeferredHandles;
 class Isolate;
 class JSFunction;
 class ParseInfo;
@@ -24,11 +25,17 @@ class UnicodeCache;
 class Utf16CharacterStream;
 class Zone;
 
+namespace interpreter {
+class InterpreterCompilationJob;
+}  // namespace interpreter
+
 enum class CompileJobStatus {
   kInitial,
   kReadyToParse,
   kParsed,
+  kReadyToAnalyse,
   kReadyToCompile,
+  kCompiled,
   kFailed,
   kDone,
 };
@@ -40,6 +47,9 @@ class CompilerDispatcherJob {
   ~CompilerDispatcherJob();
 
   CompileJobStatus status() const { return status_; }
+  // Returns true if the closure the job was created for was garbage
+  // collected. The job can't make progress then and has to be reset.
+  bool function_collected() const { return function_ == nullptr; }
   bool can_parse_on_background_thread() const {
     return can_parse_on_background_thread_;
   }
@@ -50,10 +60,20 @@ class CompilerDispatcherJob {
   // Transition from kReadyToParse to kParsed.
   void Parse();
 
-  // Transition from kParsed to kReadyToCompile (or kFailed).
+  // Transition from kParsed to kReadyToAnalyse (or kFailed).
   void FinalizeParsingOnMainThread();
 
-  // Transition from kFailed to kDone.
+  // Transition from kReadyToAnalyse to kReadyToCompile (or kFailed).
+  void PrepareToCompileOnMainThread();
+
+  // Transition from kReadyToCompile to kCompiled.
+  void Compile();
+
+  // Transition from kCompiled to kDone (or kFailed).
+  void FinalizeCompilingOnMainThread();
+
+  // Transition from kFailed to kDone, leaving the error as a pending
+  // exception on the isolate.
   void ReportErrorsOnMainThread();
 
   // Transition from any state to kInitial and free all resources.
@@ -66,8 +86,8 @@ class CompilerDispatcherJob {
 
   CompileJobStatus status_ = CompileJobStatus::kInitial;
   Isolate* isolate_;
-  Handle<JSFunction> function_;  // Global handle.
-  Handle<String> source_;        // Global handle.
+  JSFunction** function_;   // Weak global handle.
+  Handle<String> source_;  // Global handle.
   size_t max_stack_size_;
 
   // Members required for parsing.
@@ -76,6 +96,11 @@ class CompilerDispatcherJob {
   std::unique_ptr<Utf16CharacterStream> character_stream_;
   std::unique_ptr<ParseInfo> parse_info_;
   std::unique_ptr<Parser> parser_;
+  std::unique_ptr<DeferredHandles> handles_from_parsing_;
+
+  // Members required for compiling.
+  std::unique_ptr<CompilationInfo> compile_info_;
+  std::unique_ptr<interpreter::InterpreterCompilationJob> compile_job_;
 
   bool can_parse_on_background_thread_;
 
@@ -0,0 +1,378 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/compiler-dispatcher/compiler-dispatcher.h"
+
+#include <algorithm>
+
+#include "include/v8-platform.h"
+#include "src/cancelable-task.h"
+#include "src/compiler-dispatcher/compiler-dispatcher-job.h"
+#include "src/debug/debug.h"
+#include "src/isolate.h"
+#include "src/objects-inl.h"
+
+namespace v8 {
+namespace internal {
+
+namespace {
+
+bool IsFinished(CompilerDispatcherJob* job) {
+  return job->status() == CompileJobStatus::kDone ||
+         job->status() == CompileJobStatus::kFailed;
+}
+
+bool CanRunOnAnyThread(CompilerDispatcherJob* job) {
+  return (job->status() == CompileJobStatus::kReadyToParse &&
+          job->can_parse_on_background_thread()) ||
+         job->status() == CompileJobStatus::kReadyToCompile;
+}
+
+// Performs the one step of |job| that may run on a background thread.
+void DoNextStepOnBackgroundThread(CompilerDispatcherJob* job) {
+  DCHECK(CanRunOnAnyThread(job));
+  switch (job->status()) {
+    case CompileJobStatus::kReadyToParse:
+      job->Parse();
+      break;
+
+    case CompileJobStatus::kReadyToCompile:
+      job->Compile();
+      break;
+
+    default:
+      UNREACHABLE();
+  }
+}
+
+}  // namespace
+
+class CompilerDispatcher::BackgroundTask : public CancelableTask {
+ public:
+  BackgroundTask(Isolate* isolate, CompilerDispatcher* dispatcher)
+      : CancelableTask(isolate), dispatcher_(dispatcher) {}
+  ~BackgroundTask() override {}
+
+  // CancelableTask implementation.
+  void RunInternal() override { dispatcher_->DoBackgroundWork(); }
+
+ private:
+  CompilerDispatcher* dispatcher_;
+
+  DISALLOW_COPY_AND_ASSIGN(BackgroundTask);
+};
+
+class CompilerDispatcher::IdleTask : public CancelableIdleTask {
+ public:
+  IdleTask(Isolate* isolate, CompilerDispatcher* dispatcher)
+      : CancelableIdleTask(isolate), dispatcher_(dispatcher) {}
+  ~IdleTask() override {}
+
+  // CancelableIdleTask implementation.
+  void RunInternal(double deadline_in_seconds) override {
+    dispatcher_->DoIdleWork(deadline_in_seconds);
+  }
+
+ private:
+  CompilerDispatcher* dispatcher_;
+
+  DISALLOW_COPY_AND_ASSIGN(IdleTask);
+};
+
+const size_t CompilerDispatcher::kMaxJobs;
+
+CompilerDispatcher::CompilerDispatcher(Isolate* isolate, Platform* platform,
+                                       size_t max_stack_size)
+    : isolate_(isolate),
+      platform_(platform),
+      max_stack_size_(max_stack_size),
+      idle_task_scheduled_(false),
+      num_scheduled_background_tasks_(0),
+      main_thread_blocking_on_job_(nullptr) {}
+
+CompilerDispatcher::~CompilerDispatcher() {
+  // AbortAll must be called before the isolate tears down the heap, and the
+  // task manager must have canceled all tasks referring to the dispatcher.
+  DCHECK(jobs_.empty());
+  DCHECK(pending_background_jobs_.empty());
+  DCHECK(running_background_jobs_.empty());
+}
+
+// static
+CompilerDispatcher::JobKey CompilerDispatcher::KeyFor(
+    SharedFunctionInfo* shared) {
+  return std::make_pair(Script::cast(shared->script())->id(),
+                        shared->start_position());
+}
+
+bool CompilerDispatcher::CanEnqueue(Handle<SharedFunctionInfo> shared) const {
+  // The dispatcher only produces bytecode, so functions have to be compiled
+  // by Ignition. Since asm.js modules are validated and translated on the main
+  // thread, these are left alone when validation is on.
+  if (!FLAG_ignition || FLAG_validate_asm) return false;
+  if (shared->asm_function()) return false;
+  if (!shared->PassesFilter(FLAG_ignition_filter)) return false;
+
+  // Code for the debugger is compiled on the main thread.
+  if (isolate_->debug()->is_active()) return false;
+
+  // The main thread parts of a job only run in idle tasks, so without idle
+  // time, jobs would only finish when the function is called.
+  v8::Isolate* v8_isolate = reinterpret_cast<v8::Isolate*>(isolate_);
+  if (!platform_->IdleTasksEnabled(v8_isolate)) return false;
+
+  // Pending jobs hold on to their parse and AST zones.
+  if (jobs_.size() >= kMaxJobs) return false;
+
+  if (shared->is_compiled() || shared->HasBytecodeArray()) return false;
+  if (!shared->allows_lazy_compilation() || shared->is_toplevel()) return false;
+  if (!shared->script()->IsScript()) return false;
+  Script* script = Script::cast(shared->script());
+  return script->type() != Script::TYPE_NATIVE && script->source()->IsString();
+}
+
+bool CompilerDispatcher::Enqueue(Handle<JSFunction> function) {
+  Handle<SharedFunctionInfo> shared(function->shared(), isolate_);
+  if (!CanEnqueue(shared)) return false;
+  JobMap::iterator it = jobs_.find(KeyFor(*shared));
+  if (it != jobs_.end()) {
+    if (!it->second->function_collected()) return false;
+    // Start over with the new closure.
+    AbortJob(it);
+  }
+
+  std::unique_ptr<CompilerDispatcherJob> job(
+      new CompilerDispatcherJob(isolate_, function, max_stack_size_));
+  if (FLAG_trace_compiler_dispatcher) {
+    PrintF("CompilerDispatcher: enqueuing ");
+    shared->ShortPrint();
+    PrintF("\n");
+  }
+
+  // Preparing to parse is cheap, and allows the parse step to start on a
+  // background thread right away.
+  job->PrepareToParseOnMainThread();
+  CompilerDispatcherJob* raw_job = job.get();
+  jobs_.insert(std::make_pair(KeyFor(*shared), std::move(job)));
+  ConsiderJobForBackgroundProcessing(raw_job);
+  ScheduleIdleTaskIfNeeded();
+  return true;
+}
+
+bool CompilerDispatcher::IsEnqueued(Handle<SharedFunctionInfo> function) const {
+  if (!function->script()->IsScript()) return false;
+  JobMap::const_iterator it = jobs_.find(KeyFor(*function));
+  // Jobs whose closure died can't be finished, and are dropped in the next
+  // idle task.
+  return it != jobs_.end() && !it->second->function_collected();
+}
+
+bool CompilerDispatcher::FinishNow(Handle<SharedFunctionInfo> function) {
+  JobMap::iterator it = jobs_.find(KeyFor(*function));
+  CHECK(it != jobs_.end());
+  CompilerDispatcherJob* job = it->second.get();
+  DCHECK(!job->function_collected());
+
+  if (FLAG_trace_compiler_dispatcher) {
+    PrintF("CompilerDispatcher: finishing ");
+    function->ShortPrint();
+    PrintF(" now\n");
+  }
+
+  WaitForJobIfRunningOnBackground(job);
+  while (!IsFinished(job)) {
+    DoNextStepOnMainThread(job, ExceptionHandling::kThrow);
+  }
+  bool result = job->status() != CompileJobStatus::kFailed;
+  if (!result) job->ReportErrorsOnMainThread();
+
+  job->ResetOnMainThread();
+  jobs_.erase(it);
+  return result;
+}
+
+void CompilerDispatcher::AbortAll() {
+  {
+    base::LockGuard<base::Mutex> lock(&mutex_);
+    pending_background_jobs_.clear();
+  }
+  for (auto& it : jobs_) {
+    WaitForJobIfRunningOnBackground(it.second.get());
+    it.second->ResetOnMainThread();
+  }
+  jobs_.clear();
+}
+
+CompilerDispatcher::JobMap::iterator CompilerDispatcher::AbortJob(
+    JobMap::iterator it) {
+  WaitForJobIfRunningOnBackground(it->second.get());
+  it->second->ResetOnMainThread();
+  return jobs_.erase(it);
+}
+
+void CompilerDispatcher::DoNextStepOnMainThread(
+    CompilerDispatcherJob* job, ExceptionHandling exception_handling) {
+  DCHECK(!IsFinished(job));
+  switch (job->status()) {
+    case CompileJobStatus::kInitial:
+      job->PrepareToParseOnMainThread();
+      break;
+
+    case CompileJobStatus::kReadyToParse:
+      job->Parse();
+      break;
+
+    case CompileJobStatus::kParsed:
+      job->FinalizeParsingOnMainThread();
+      break;
+
+    case CompileJobStatus::kReadyToAnalyse:
+      job->PrepareToCompileOnMainThread();
+      break;
+
+    case CompileJobStatus::kReadyToCompile:
+      job->Compile();
+      break;
+
+    case CompileJobStatus::kCompiled:
+      job->FinalizeCompilingOnMainThread();
+      break;
+
+    case CompileJobStatus::kFailed:
+    case CompileJobStatus::kDone:
+      UNREACHABLE();
+  }
+
+  // Errors encountered in idle time are not reported. Instead, the job is
+  // discarded and the error is reported again when the function is compiled
+  // lazily.
+  if (exception_handling == ExceptionHandling::kSwallow &&
+      isolate_->has_pending_exception()) {
+    isolate_->clear_pending_exception();
+  }
+}
+
+void CompilerDispatcher::WaitForJobIfRunningOnBackground(
+    CompilerDispatcherJob* job) {
+  base::LockGuard<base::Mutex> lock(&mutex_);
+  if (running_background_jobs_.find(job) == running_background_jobs_.end()) {
+    pending_background_jobs_.erase(job);
+    return;
+  }
+  DCHECK_NULL(main_thread_blocking_on_job_);
+  main_thread_blocking_on_job_ = job;
+  while (main_thread_blocking_on_job_ != nullptr) {
+    main_thread_blocking_signal_.Wait(&mutex_);
+  }
+  DCHECK(pending_background_jobs_.find(job) == pending_background_jobs_.end());
+  DCHECK(running_background_jobs_.find(job) == running_background_jobs_.end());
+}
+
+void CompilerDispatcher::ConsiderJobForBackgroundProcessing(
+    CompilerDispatcherJob* job) {
+  if (!CanRunOnAnyThread(job)) return;
+  {
+    base::LockGuard<base::Mutex> lock(&mutex_);
+    pending_background_jobs_.insert(job);
+  }
+  ScheduleMoreBackgroundTasksIfNeeded();
+}
+
+void CompilerDispatcher::ScheduleMoreBackgroundTasksIfNeeded() {
+  {
+    base::LockGuard<base::Mutex> lock(&mutex_);
+    if (pending_background_jobs_.empty()) return;
+    // Don't post more tasks than there are jobs or background threads.
+    size_t max_tasks = std::min(
+        pending_background_jobs_.size(),
+        std::max<size_t>(1, platform_->NumberOfAvailableBackgroundThreads()));
+    if (num_scheduled_background_tasks_ >= max_tasks) return;
+    ++num_scheduled_background_tasks_;
+  }
+  platform_->CallOnBackgroundThread(new BackgroundTask(isolate_, this),
+                                    v8::Platform::kShortRunningTask);
+}
+
+void CompilerDispatcher::ScheduleIdleTaskIfNeeded() {
+  if (idle_task_scheduled_ || jobs_.empty()) return;
+  v8::Isolate* v8_isolate = reinterpret_cast<v8::Isolate*>(isolate_);
+  if (!platform_->IdleTasksEnabled(v8_isolate)) return;
+  idle_task_scheduled_ = true;
+  platform_->CallIdleOnForegroundThread(v8_isolate,
+                                        new IdleTask(isolate_, this));
+}
+
+void CompilerDispatcher::DoBackgroundWork() {
+  CompilerDispatcherJob* job = nullptr;
+  {
+    base::LockGuard<base::Mutex> lock(&mutex_);
+    --num_scheduled_background_tasks_;
+    if (!pending_background_jobs_.empty()) {
+      auto it = pending_background_jobs_.begin();
+      job = *it;
+      pending_background_jobs_.erase(it);
+      running_background_jobs_.insert(job);
+    }
+  }
+  if (job == nullptr) return;
+  DoNextStepOnBackgroundThread(job);
+
+  ScheduleMoreBackgroundTasksIfNeeded();
+
+  {
+    base::LockGuard<base::Mutex> lock(&mutex_);
+    running_background_jobs_.erase(job);
+    if (main_thread_blocking_on_job_ == job) {
+      main_thread_blocking_on_job_ = nullptr;
+      main_thread_blocking_signal_.NotifyOne();
+    }
+  }
+  // The job now waits for the main thread, which picks it up in the next idle
+  // task or when the function is called.
+}
+
+void CompilerDispatcher::DoIdleWork(double deadline_in_seconds) {
+  idle_task_scheduled_ = false;
+
+  // Advance jobs that need the main thread, one step at a time, until the
+  // idle time is used up.
+  for (JobMap::iterator it = jobs_.begin();
+       it != jobs_.end() &&
+       platform_->MonotonicallyIncreasingTime() < deadline_in_seconds;) {
+    CompilerDispatcherJob* job = it->second.get();
+    {
+      base::LockGuard<base::Mutex> lock(&mutex_);
+      if (running_background_jobs_.find(job) !=
+              running_background_jobs_.end() ||
+          pending_background_jobs_.find(job) !=
+              pending_background_jobs_.end()) {
+        ++it;
+        continue;
+      }
+    }
+
+    if (job->function_collected()) {
+      if (FLAG_trace_compiler_dispatcher) {
+        PrintF("CompilerDispatcher: dropping job of a collected closure\n");
+      }
+      it = AbortJob(it);
+      continue;
+    }
+
+    DoNextStepOnMainThread(job, ExceptionHandling::kSwallow);
+    if (IsFinished(job)) {
+      // Finished jobs already installed their bytecode, failed jobs are
+      // redone when the function is compiled lazily.
+      job->ResetOnMainThread();
+      it = jobs_.erase(it);
+    } else {
+      ConsiderJobForBackgroundProcessing(job);
+    }
+  }
+
+  ScheduleIdleTaskIfNeeded();
+}
+
+}  // namespace internal
+}  // namespace v8
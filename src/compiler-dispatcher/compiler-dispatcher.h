@@ -0,0 +1,138 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_COMPILER_DISPATCHER_COMPILER_DISPATCHER_H_
+#define V8_COMPILER_DISPATCHER_COMPILER_DISPATCHER_H_
+
+#include <map>
+#include <memory>
+#include <unordered_set>
+#include <utility>
+
+#include "src/base/macros.h"
+#include "src/base/platform/condition-variable.h"
+#include "src/base/platform/mutex.h"
+#include "src/flags.h"
+#include "src/handles.h"
+#include "testing/gtest/include/gtest/gtest_prod.h"
+
+namespace v8 {
+
+class Platform;
+
+namespace internal {
+
+class CompilerDispatcherJob;
+class Isolate;
+class JSFunction;
+class SharedFunctionInfo;
+
+// The CompilerDispatcher keeps track of lazy functions that should be parsed
+// and compiled to bytecode before they are first called. Each function gets a
+// CompilerDispatcherJob. Steps that don't need the heap, i.e. parsing external
+// source strings and generating bytecode, are posted to background threads.
+// The remaining steps run on the main thread in idle tasks, or when a function
+// is called before its job is done, in which case the main thread finishes the
+// job right away.
+//
+// Jobs only hold their closure weakly, and are dropped when it dies. Functions
+// are only enqueued if the platform provides idle time to finish their jobs,
+// and only up to kMaxJobs at a time. The heap aborts all jobs under memory
+// pressure.
+//
+// Jobs are owned by the main thread. Background tasks only take jobs from the
+// pending set, which, like the set of running jobs, is guarded by |mutex_|.
+class CompilerDispatcher {
+ public:
+  CompilerDispatcher(Isolate* isolate, Platform* platform,
+                     size_t max_stack_size);
+  ~CompilerDispatcher();
+
+  // Returns true if a job was enqueued for the given function.
+  bool Enqueue(Handle<JSFunction> function);
+
+  // Returns true if there is a pending job for the given function.
+  bool IsEnqueued(Handle<SharedFunctionInfo> function) const;
+
+  // Blocks until the given function is compiled, doing all remaining steps on
+  // the main thread. Returns false and leaves an exception pending if the job
+  // failed.
+  bool FinishNow(Handle<SharedFunctionInfo> function);
+
+  // Aborts all jobs, waiting for jobs that are running on background threads
+  // to return first.
+  void AbortAll();
+
+  static bool Enabled() { return FLAG_compiler_dispatcher; }
+
+ private:
+  FRIEND_TEST(CompilerDispatcherTest, IdleTaskFinishesJob);
+  FRIEND_TEST(CompilerDispatcherTest, LimitsNumberOfJobs);
+  FRIEND_TEST(CompilerDispatcherTest, DropsJobsOfCollectedClosures);
+
+  class BackgroundTask;
+  class IdleTask;
+
+  enum class ExceptionHandling { kSwallow, kThrow };
+
+  // Jobs are keyed by the script id and start position of their function.
+  typedef std::pair<int, int> JobKey;
+  typedef std::map<JobKey, std::unique_ptr<CompilerDispatcherJob>> JobMap;
+
+  // Maximum number of jobs that are pending at the same time.
+  static const size_t kMaxJobs = 64;
+
+  static JobKey KeyFor(SharedFunctionInfo* shared);
+
+  bool CanEnqueue(Handle<SharedFunctionInfo> shared) const;
+
+  // Resets the job |it| refers to and removes it from |jobs_|.
+  JobMap::iterator AbortJob(JobMap::iterator it);
+
+  // Advances |job| by one step on the main thread.
+  void DoNextStepOnMainThread(CompilerDispatcherJob* job,
+                              ExceptionHandling exception_handling);
+
+  void WaitForJobIfRunningOnBackground(CompilerDispatcherJob* job);
+  void ConsiderJobForBackgroundProcessing(CompilerDispatcherJob* job);
+  void ScheduleMoreBackgroundTasksIfNeeded();
+  void ScheduleIdleTaskIfNeeded();
+
+  // Called from the tasks.
+  void DoBackgroundWork();
+  void DoIdleWork(double deadline_in_seconds);
+
+  Isolate* isolate_;
+  Platform* platform_;
+  size_t max_stack_size_;
+
+  // Mapping from (script id, function start position) to job. Only accessed
+  // on the main thread.
+  JobMap jobs_;
+
+  bool idle_task_scheduled_;
+
+  // Protects all members below.
+  base::Mutex mutex_;
+
+  // Jobs that are ready to be processed on a background thread, and jobs a
+  // background thread is processing right now.
+  std::unordered_set<CompilerDispatcherJob*> pending_background_jobs_;
+  std::unordered_set<CompilerDispatcherJob*> running_background_jobs_;
+
+  // Number of background tasks that were posted and did not run yet.
+  size_t num_scheduled_background_tasks_;
+
+  // Set while the main thread is waiting for a background thread to return
+  // the given job.
+  CompilerDispatcherJob* main_thread_blocking_on_job_;
+  base::ConditionVariable main_thread_blocking_signal_;
+
+  DISALLOW_COPY_AND_ASSIGN(CompilerDispatcher);
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_COMPILER_DISPATCHER_COMPILER_DISPATCHER_H_
@@ -31,11 +31,10 @@ void DisposeCompilationJob(CompilationJob* job, bool restore_function_code) {
 
 class OptimizingCompileDispatcher::CompileTask : public v8::Task {
  public:
-  explicit CompileTask(Isolate* isolate) : isolate_(isolate) {
-    OptimizingCompileDispatcher* dispatcher =
-        isolate_->optimizing_compile_dispatcher();
-    base::LockGuard<base::Mutex> lock_guard(&dispatcher->ref_count_mutex_);
-    ++dispatcher->ref_count_;
+  CompileTask(Isolate* isolate, OptimizingCompileDispatcher* dispatcher)
+      : isolate_(isolate), dispatcher_(dispatcher) {
+    base::LockGuard<base::Mutex> lock_guard(&dispatcher_->ref_count_mutex_);
+    ++dispatcher_->ref_count_;
   }
 
   virtual ~CompileTask() {}
@@ -47,34 +46,54 @@ class OptimizingCompileDispatcher::CompileTask : public v8::Task {
     DisallowHandleAllocation no_handles;
     DisallowHandleDereference no_deref;
 
-    OptimizingCompileDispatcher* dispatcher =
-        isolate_->optimizing_compile_dispatcher();
-    {
+    // Keep taking jobs until the input queue is empty, so that at most
+    // max_tasks() jobs are optimized at the same time.
+    CompilationJob* job = nullptr;
+    while (dispatcher_->NextInputForTask(&job)) {
       TimerEventScope<TimerEventRecompileConcurrent> timer(isolate_);
 
       TRACE_EVENT0(TRACE_DISABLED_BY_DEFAULT("v8.compile"),
                    "V8.RecompileConcurrent");
 
-      if (dispatcher->recompilation_delay_ != 0) {
+      if (dispatcher_->recompilation_delay_ != 0) {
         base::OS::Sleep(base::TimeDelta::FromMilliseconds(
-            dispatcher->recompilation_delay_));
+            dispatcher_->recompilation_delay_));
       }
 
-      dispatcher->CompileNext(dispatcher->NextInput(true));
+      dispatcher_->CompileNext(job);
     }
     {
-      base::LockGuard<base::Mutex> lock_guard(&dispatcher->ref_count_mutex_);
-      if (--dispatcher->ref_count_ == 0) {
-        dispatcher->ref_count_zero_.NotifyOne();
+      base::LockGuard<base::Mutex> lock_guard(&dispatcher_->ref_count_mutex_);
+      if (--dispatcher_->ref_count_ == 0) {
+        dispatcher_->ref_count_zero_.NotifyOne();
       }
     }
   }
 
   Isolate* isolate_;
+  OptimizingCompileDispatcher* dispatcher_;
 
   DISALLOW_COPY_AND_ASSIGN(CompileTask);
 };
 
+OptimizingCompileDispatcher::OptimizingCompileDispatcher(Isolate* isolate)
+    : isolate_(isolate),
+      input_queue_capacity_(FLAG_concurrent_recompilation_queue_length),
+      input_queue_length_(0),
+      running_tasks_(0),
+      max_tasks_(FLAG_concurrent_recompilation_tasks),
+      blocked_jobs_(0),
+      ref_count_(0),
+      recompilation_delay_(FLAG_concurrent_recompilation_delay) {
+  base::NoBarrier_Store(&mode_, static_cast<base::AtomicWord>(COMPILE));
+  input_queue_ = NewArray<InputQueueEntry>(input_queue_capacity_);
+  if (max_tasks_ <= 0) {
+    int available_threads = static_cast<int>(
+        V8::GetCurrentPlatform()->NumberOfAvailableBackgroundThreads());
+    max_tasks_ = Max(1, available_threads / 2);
+  }
+}
+
 OptimizingCompileDispatcher::~OptimizingCompileDispatcher() {
 #ifdef DEBUG
   {
@@ -83,26 +102,69 @@ OptimizingCompileDispatcher::~OptimizingCompileDispatcher() {
   }
 #endif
   DCHECK_EQ(0, input_queue_length_);
+  DCHECK_EQ(0, running_tasks_);
   DeleteArray(input_queue_);
 }
 
-CompilationJob* OptimizingCompileDispatcher::NextInput(bool check_if_flushing) {
-  base::LockGuard<base::Mutex> access_input_queue_(&input_queue_mutex_);
-  if (input_queue_length_ == 0) return NULL;
-  CompilationJob* job = input_queue_[InputQueueIndex(0)];
+// static
+int OptimizingCompileDispatcher::JobPriority(CompilationJob* job) {
+  // Prefer functions that ran longer before they were marked for
+  // optimization. Ignition counts ticks on the shared function info,
+  // full-codegen on the unoptimized code.
+  SharedFunctionInfo* shared = *job->info()->shared_info();
+  int ticks = shared->profiler_ticks();
+  if (shared->code()->kind() == Code::FUNCTION) {
+    ticks = Max(ticks, shared->code()->profiler_ticks());
+  }
+  return ticks;
+}
+
+CompilationJob* OptimizingCompileDispatcher::RemoveNextInput() {
+  DCHECK_LT(0, input_queue_length_);
+  int next = 0;
+  for (int i = 1; i < input_queue_length_; i++) {
+    if (input_queue_[i].priority > input_queue_[next].priority) next = i;
+  }
+  CompilationJob* job = input_queue_[next].job;
   DCHECK_NOT_NULL(job);
-  input_queue_shift_ = InputQueueIndex(1);
+  for (int i = next + 1; i < input_queue_length_; i++) {
+    input_queue_[i - 1] = input_queue_[i];
+  }
   input_queue_length_--;
-  if (check_if_flushing) {
-    if (static_cast<ModeFlag>(base::Acquire_Load(&mode_)) == FLUSH) {
-      AllowHandleDereference allow_handle_dereference;
-      DisposeCompilationJob(job, true);
-      return NULL;
-    }
+  return job;
+}
+
+CompilationJob* OptimizingCompileDispatcher::DisposeIfFlushing(
+    CompilationJob* job) {
+  if (static_cast<ModeFlag>(base::Acquire_Load(&mode_)) == FLUSH) {
+    AllowHandleDereference allow_handle_dereference;
+    DisposeCompilationJob(job, true);
+    return NULL;
   }
   return job;
 }
 
+CompilationJob* OptimizingCompileDispatcher::NextInput(bool check_if_flushing) {
+  base::LockGuard<base::Mutex> access_input_queue_(&input_queue_mutex_);
+  if (input_queue_length_ == 0) return NULL;
+  CompilationJob* job = RemoveNextInput();
+  if (check_if_flushing) job = DisposeIfFlushing(job);
+  return job;
+}
+
+bool OptimizingCompileDispatcher::NextInputForTask(CompilationJob** job) {
+  // Retiring has to happen under the same lock as queueing, so that a job is
+  // never queued without a task that will take it.
+  base::LockGuard<base::Mutex> access_input_queue_(&input_queue_mutex_);
+  if (input_queue_length_ == 0) {
+    DCHECK_LT(0, running_tasks_);
+    running_tasks_--;
+    return false;
+  }
+  *job = DisposeIfFlushing(RemoveNextInput());
+  return true;
+}
+
 void OptimizingCompileDispatcher::CompileNext(CompilationJob* job) {
   if (!job) return;
 
@@ -193,28 +255,40 @@ void OptimizingCompileDispatcher::InstallOptimizedFunctions() {
 
 void OptimizingCompileDispatcher::QueueForOptimization(CompilationJob* job) {
   DCHECK(IsQueueAvailable());
+  // OSR is compiled synchronously, so there is no OSR job to run first.
+  DCHECK(!job->info()->is_osr());
+  int priority = JobPriority(job);
   {
     // Add job to the back of the input queue.
     base::LockGuard<base::Mutex> access_input_queue(&input_queue_mutex_);
     DCHECK_LT(input_queue_length_, input_queue_capacity_);
-    input_queue_[InputQueueIndex(input_queue_length_)] = job;
+    input_queue_[input_queue_length_].job = job;
+    input_queue_[input_queue_length_].priority = priority;
     input_queue_length_++;
   }
   if (FLAG_block_concurrent_recompilation) {
     blocked_jobs_++;
   } else {
-    V8::GetCurrentPlatform()->CallOnBackgroundThread(
-        new CompileTask(isolate_), v8::Platform::kShortRunningTask);
+    StartTaskIfNeeded();
   }
 }
 
 void OptimizingCompileDispatcher::Unblock() {
   while (blocked_jobs_ > 0) {
-    V8::GetCurrentPlatform()->CallOnBackgroundThread(
-        new CompileTask(isolate_), v8::Platform::kShortRunningTask);
+    StartTaskIfNeeded();
     blocked_jobs_--;
   }
 }
 
+void OptimizingCompileDispatcher::StartTaskIfNeeded() {
+  {
+    base::LockGuard<base::Mutex> access_input_queue(&input_queue_mutex_);
+    if (running_tasks_ >= max_tasks_) return;
+    running_tasks_++;
+  }
+  V8::GetCurrentPlatform()->CallOnBackgroundThread(
+      new CompileTask(isolate_, this), v8::Platform::kShortRunningTask);
+}
+
 }  // namespace internal
 }  // namespace v8
@@ -20,19 +20,15 @@ namespace internal {
 class CompilationJob;
 class SharedFunctionInfo;
 
+// Optimizes functions on background threads. The main thread builds, types
+// and lowers the graph of a function (CompilationJob::CreateGraph) and queues
+// the job. Up to max_tasks() background tasks take jobs from the input queue,
+// hotter functions first, and run the remaining, heap independent phases
+// (CompilationJob::OptimizeGraph) in parallel. Finished jobs are installed on
+// the main thread. OSR is compiled synchronously and never queued here.
 class OptimizingCompileDispatcher {
  public:
-  explicit OptimizingCompileDispatcher(Isolate* isolate)
-      : isolate_(isolate),
-        input_queue_capacity_(FLAG_concurrent_recompilation_queue_length),
-        input_queue_length_(0),
-        input_queue_shift_(0),
-        blocked_jobs_(0),
-        ref_count_(0),
-        recompilation_delay_(FLAG_concurrent_recompilation_delay) {
-    base::NoBarrier_Store(&mode_, static_cast<base::AtomicWord>(COMPILE));
-    input_queue_ = NewArray<CompilationJob*>(input_queue_capacity_);
-  }
+  explicit OptimizingCompileDispatcher(Isolate* isolate);
 
   ~OptimizingCompileDispatcher();
 
@@ -48,6 +44,8 @@ class OptimizingCompileDispatcher {
     return input_queue_length_ < input_queue_capacity_;
   }
 
+  int max_tasks() const { return max_tasks_; }
+
   static bool Enabled() { return FLAG_concurrent_recompilation; }
 
  private:
@@ -55,24 +53,37 @@ class OptimizingCompileDispatcher {
 
   enum ModeFlag { COMPILE, FLUSH };
 
+  // A queued job and the priority it was queued with. Jobs with a higher
+  // priority are taken first, jobs with equal priority in queue order.
+  struct InputQueueEntry {
+    CompilationJob* job;
+    int priority;
+  };
+
+  static int JobPriority(CompilationJob* job);
+
   void FlushOutputQueue(bool restore_function_code);
   void CompileNext(CompilationJob* job);
   CompilationJob* NextInput(bool check_if_flushing = false);
-
-  inline int InputQueueIndex(int i) {
-    int result = (i + input_queue_shift_) % input_queue_capacity_;
-    DCHECK_LE(0, result);
-    DCHECK_LT(result, input_queue_capacity_);
-    return result;
-  }
+  // Removes the job with the highest priority from the non-empty input queue.
+  // Must be called with |input_queue_mutex_| held.
+  CompilationJob* RemoveNextInput();
+  // Returns null and disposes |job| if the dispatcher is being flushed.
+  CompilationJob* DisposeIfFlushing(CompilationJob* job);
+  // Takes the next job for a compile task. Returns false and retires the task
+  // if the input queue is empty. |job| is null if the job was flushed.
+  bool NextInputForTask(CompilationJob** job);
+  void StartTaskIfNeeded();
 
   Isolate* isolate_;
 
-  // Circular queue of incoming recompilation tasks (including OSR).
-  CompilationJob** input_queue_;
+  // Incoming recompilation tasks in queue order.
+  InputQueueEntry* input_queue_;
   int input_queue_capacity_;
   int input_queue_length_;
-  int input_queue_shift_;
+  // Number of compile tasks that were posted and did not retire yet.
+  int running_tasks_;
+  int max_tasks_;
   base::Mutex input_queue_mutex_;
 
   // Queue of recompilation tasks ready to be installed (excluding OSR).
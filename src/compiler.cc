@@ -15,6 +15,8 @@
 #include "src/bootstrapper.h"
 #include "src/codegen.h"
 #include "src/compilation-cache.h"
+#include "src/compilation-statistics.h"
+#include "src/compiler-dispatcher/compiler-dispatcher.h"
 #include "src/compiler/pipeline.h"
 #include "src/crankshaft/hydrogen.h"
 #include "src/debug/debug.h"
@@ -144,6 +146,10 @@ CompilationInfo::CompilationInfo(ParseInfo* parse_info,
       debug_name_(debug_name) {}
 
 CompilationInfo::~CompilationInfo() {
+  if (IsOptimizing() && bailout_reason() != kNoReason &&
+      isolate()->collect_compile_statistics()) {
+    isolate()->GetTurboStatistics()->RecordBailout(bailout_reason());
+  }
   if (GetFlag(kDisableFutureOptimization) && has_shared_info()) {
     shared_info()->DisableOptimization(bailout_reason());
   }
@@ -347,6 +353,9 @@ void CompilationJob::RecordOptimizationStats() {
     int opt_count = function->shared()->opt_count();
     function->shared()->set_opt_count(opt_count + 1);
   }
+  if (isolate()->collect_compile_statistics()) {
+    isolate()->GetTurboStatistics()->RecordOptimization();
+  }
   double ms_creategraph = time_taken_to_create_graph_.InMillisecondsF();
   double ms_optimize = time_taken_to_optimize_.InMillisecondsF();
   double ms_codegen = time_taken_to_codegen_.InMillisecondsF();
@@ -1040,8 +1049,27 @@ MaybeHandle<Code> GetLazyCode(Handle<JSFunction> function) {
     return entry;
   }
 
+  // Finish a job of the compiler dispatcher that is already parsing or
+  // compiling the function in the background.
+  CompilerDispatcher* dispatcher = isolate->compiler_dispatcher();
+  if (dispatcher != nullptr &&
+      dispatcher->IsEnqueued(handle(function->shared(), isolate))) {
+    if (!dispatcher->FinishNow(handle(function->shared(), isolate))) {
+      return MaybeHandle<Code>();
+    }
+    DCHECK(function->shared()->is_compiled());
+    return handle(function->shared()->code(), isolate);
+  }
+
   Zone zone(isolate->allocator());
   ParseInfo parse_info(&zone, function);
+  // Inner functions are compiled lazily, so their bodies can be skipped if
+  // an earlier parse recorded their scope data.
+  bool allow_lazy_inner_functions =
+      FLAG_lazy_inner_functions && !function->shared()->is_toplevel();
+  allow_lazy_inner_functions &=
+      !(FLAG_ignition && FLAG_ignition_eager && !isolate->serializer_enabled());
+  parse_info.set_allow_lazy_parsing(allow_lazy_inner_functions);
   CompilationInfo info(&parse_info, function);
   Handle<Code> result;
   ASSIGN_RETURN_ON_EXCEPTION(isolate, result, GetUnoptimizedCode(&info), Code);
@@ -1642,6 +1670,11 @@ Handle<SharedFunctionInfo> Compiler::GetSharedFunctionInfoForScript(
     timer.Start();
   }
 
+  // The warm instance of the script, if any, tells which functions ended up
+  // being optimized. It is recompiled below when producing a code cache.
+  Handle<SharedFunctionInfo> warm_result;
+  maybe_result.ToHandle(&warm_result);
+
   if (!maybe_result.ToHandle(&result) ||
       (FLAG_serialize_toplevel &&
        compile_options == ScriptCompiler::kProduceCodeCache)) {
@@ -1699,6 +1732,11 @@ Handle<SharedFunctionInfo> Compiler::GetSharedFunctionInfoForScript(
                                            &RuntimeCallStats::CompileSerialize);
         TRACE_EVENT_RUNTIME_CALL_STATS_TRACING_SCOPED(
             isolate, &tracing::TraceEventStatsTable::CompileSerialize);
+        if (FLAG_serialize_optimization_hints && !warm_result.is_null() &&
+            warm_result->script()->IsScript()) {
+          Script::SetOptimizationHints(
+              script, handle(Script::cast(warm_result->script()), isolate));
+        }
         *cached_data = CodeSerializer::Serialize(isolate, result, source);
         if (FLAG_profile_deserialization) {
           PrintF("[Compiling and serializing took %0.3f ms]\n",
@@ -1943,6 +1981,52 @@ void Compiler::FinalizeCompilationJob(CompilationJob* raw_job) {
   info->closure()->ReplaceCode(shared->code());
 }
 
+interpreter::InterpreterCompilationJob*
+Compiler::PrepareBytecodeCompilationJob(CompilationInfo* info) {
+  Isolate* isolate = info->isolate();
+  VMState<COMPILER> state(isolate);
+  DCHECK(AllowCompilation::IsAllowed(isolate));
+  DCHECK(ShouldUseIgnition(info));
+
+  if (!Compiler::Analyze(info->parse_info())) {
+    if (!isolate->has_pending_exception()) isolate->StackOverflow();
+    return nullptr;
+  }
+  EnsureFeedbackMetadata(info);
+  return new interpreter::InterpreterCompilationJob(info);
+}
+
+bool Compiler::FinalizeBytecodeCompilationJob(
+    interpreter::InterpreterCompilationJob* job) {
+  CompilationInfo* info = job->info();
+  Isolate* isolate = info->isolate();
+  VMState<COMPILER> state(isolate);
+  PostponeInterruptsScope postpone(isolate);
+
+  if (!job->Finalize()) {
+    if (!isolate->has_pending_exception()) isolate->StackOverflow();
+    return false;
+  }
+
+  // The function might have been compiled on the main thread in the meantime,
+  // in which case the result is dropped.
+  Handle<SharedFunctionInfo> shared = info->shared_info();
+  if (shared->is_compiled()) return true;
+
+  Counters* counters = isolate->counters();
+  counters->total_baseline_code_size()->Increment(CodeAndMetadataSize(info));
+  counters->total_baseline_compile_count()->Increment(1);
+
+  // Update the shared function info with the scope info and install the
+  // compilation result on it.
+  InstallSharedScopeInfo(info, shared);
+  InstallSharedCompilationResult(info, shared);
+
+  // Record the function compilation event.
+  RecordFunctionCompilation(CodeEventListener::LAZY_COMPILE_TAG, info);
+  return true;
+}
+
 void Compiler::PostInstantiation(Handle<JSFunction> function,
                                  PretenureFlag pretenure) {
   Handle<SharedFunctionInfo> shared(function->shared());
@@ -1951,6 +2035,17 @@ void Compiler::PostInstantiation(Handle<JSFunction> function,
     function->MarkForOptimization();
   }
 
+  // Start parsing and compiling functions that are still lazy in the
+  // background, so that their first call doesn't have to. Closures created
+  // by the FastNewClosure stub don't get here, so this only covers closures
+  // in top-level code and pretenured closures, i.e. mostly functions that
+  // are created once.
+  CompilerDispatcher* dispatcher =
+      function->GetIsolate()->compiler_dispatcher();
+  if (dispatcher != nullptr && !shared->is_compiled()) {
+    dispatcher->Enqueue(function);
+  }
+
   CodeAndLiterals cached = shared->SearchOptimizedCodeMap(
       function->context()->native_context(), BailoutId::None());
   if (cached.code != nullptr) {
@@ -28,6 +28,10 @@ class JavaScriptFrame;
 class ParseInfo;
 class ScriptData;
 
+namespace interpreter {
+class InterpreterCompilationJob;
+}  // namespace interpreter
+
 // The V8 compiler API.
 //
 // This is the central hub for dispatching to the various compilers within V8.
@@ -60,6 +64,16 @@ class Compiler : public AllStatic {
   // Generate and install code from previously queued compilation job.
   static void FinalizeCompilationJob(CompilationJob* job);
 
+  // Analyze a lazy function that was parsed by the compiler dispatcher and
+  // return a job that generates its bytecode, or null (with a pending
+  // exception) on failure. The job may be executed off the main thread.
+  static interpreter::InterpreterCompilationJob* PrepareBytecodeCompilationJob(
+      CompilationInfo* info);
+  // Install the bytecode generated by a job from the above method on the
+  // shared function info.
+  static bool FinalizeBytecodeCompilationJob(
+      interpreter::InterpreterCompilationJob* job);
+
   // Give the compiler a chance to perform low-latency initialization tasks of
   // the given {function} on its instantiation. Note that only the runtime will
   // offer this chance, optimized closure instantiation will not call this.
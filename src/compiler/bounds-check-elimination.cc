@@ -0,0 +1,56 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/compiler/bounds-check-elimination.h"
+
+#include "src/compiler/loop-variable-optimizer.h"
+#include "src/compiler/node-properties.h"
+#include "src/type-cache.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+BoundsCheckElimination::BoundsCheckElimination(
+    Editor* editor, LoopVariableOptimizer* induction_vars)
+    : AdvancedReducer(editor), induction_vars_(induction_vars) {}
+
+Reduction BoundsCheckElimination::ReduceCheckBounds(Node* node) {
+  DCHECK_EQ(IrOpcode::kCheckBounds, node->opcode());
+  Node* const index = NodeProperties::GetValueInput(node, 0);
+  Node* const length = NodeProperties::GetValueInput(node, 1);
+  Node* const effect = NodeProperties::GetEffectInput(node);
+  Node* const control = NodeProperties::GetControlInput(node);
+
+  // The {index} must be a non-negative integer, i.e. an induction variable
+  // that starts at a non-negative value and counts upwards.
+  if (!NodeProperties::IsTyped(index)) return NoChange();
+  Type* const index_type = NodeProperties::GetType(index);
+  if (!index_type->IsInhabited() ||
+      !index_type->Is(TypeCache::Get().kInteger) || index_type->Min() < 0) {
+    return NoChange();
+  }
+
+  // The check is redundant if a branch that dominates it already compared
+  // the {index} against the {length}.
+  if (!induction_vars_->IsKnownLessThan(control, index, length)) {
+    return NoChange();
+  }
+  ReplaceWithValue(node, index, effect);
+  return Replace(index);
+}
+
+Reduction BoundsCheckElimination::Reduce(Node* node) {
+  switch (node->opcode()) {
+    case IrOpcode::kCheckBounds:
+      return ReduceCheckBounds(node);
+    default:
+      break;
+  }
+  return NoChange();
+}
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,38 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_COMPILER_BOUNDS_CHECK_ELIMINATION_H_
+#define V8_COMPILER_BOUNDS_CHECK_ELIMINATION_H_
+
+#include "src/compiler/graph-reducer.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+class LoopVariableOptimizer;
+
+// Removes bounds checks whose index is a non-negative integer that the
+// dominating branch conditions keep below the length, i.e. the checks on
+// {a[i]} inside of {for (i = 0; i < a.length; ++i)} loops. The conditions are
+// collected by the {LoopVariableOptimizer}, which must have been run on the
+// current graph.
+class BoundsCheckElimination final : public AdvancedReducer {
+ public:
+  BoundsCheckElimination(Editor* editor, LoopVariableOptimizer* induction_vars);
+  ~BoundsCheckElimination() final {}
+
+  Reduction Reduce(Node* node) final;
+
+ private:
+  Reduction ReduceCheckBounds(Node* node);
+
+  LoopVariableOptimizer* const induction_vars_;
+};
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_COMPILER_BOUNDS_CHECK_ELIMINATION_H_
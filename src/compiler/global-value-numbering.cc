@@ -0,0 +1,258 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/compiler/global-value-numbering.h"
+
+#include "src/base/bits.h"
+#include "src/base/functional.h"
+#include "src/compiler/graph.h"
+#include "src/compiler/node-properties.h"
+#include "src/compiler/node.h"
+#include "src/ostreams.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+GlobalValueNumbering::GlobalValueNumbering(Graph* graph, Schedule* schedule,
+                                           Zone* temp_zone)
+    : graph_(graph),
+      schedule_(schedule),
+      temp_zone_(temp_zone),
+      entries_(temp_zone),
+      buckets_(temp_zone),
+      generation_(0),
+      next_generation_(1),
+      block_writes_(temp_zone),
+      visited_(temp_zone),
+      visit_stamp_(0),
+      worklist_(temp_zone),
+      eliminated_count_(0) {}
+
+void GlobalValueNumbering::Run() {
+  size_t const block_count = schedule_->BasicBlockCount();
+  block_writes_.resize(block_count, false);
+  visited_.resize(block_count, 0);
+  buckets_.resize(base::bits::RoundUpToPowerOfTwo32(
+                      static_cast<uint32_t>(graph_->NodeCount()) + 1),
+                  -1);
+
+  // Link the children of each block in the dominator tree, in RPO.
+  BasicBlockVector* rpo = schedule_->rpo_order();
+  BasicBlockVector first_child(block_count, nullptr, temp_zone_);
+  BasicBlockVector next_sibling(block_count, nullptr, temp_zone_);
+  for (auto it = rpo->rbegin(); it != rpo->rend(); ++it) {
+    BasicBlock* block = *it;
+    for (Node* node : *block) {
+      if (Writes(node)) block_writes_[BlockIndex(block)] = true;
+    }
+    if (block->control_input() != nullptr && Writes(block->control_input())) {
+      block_writes_[BlockIndex(block)] = true;
+    }
+    BasicBlock* dominator = block->dominator();
+    if (dominator == nullptr) continue;
+    next_sibling[BlockIndex(block)] = first_child[BlockIndex(dominator)];
+    first_child[BlockIndex(dominator)] = block;
+  }
+
+  // Walk the dominator tree depth first. Each frame remembers the size of the
+  // scoped table and the memory generation at the end of its block.
+  struct Frame {
+    BasicBlock* next_child;
+    size_t mark;
+    uint32_t generation;
+  };
+  ZoneVector<Frame> stack(temp_zone_);
+  BasicBlock* block = rpo->front();
+  while (true) {
+    if (block != nullptr) {
+      size_t const mark = entries_.size();
+      if (HasWriteOnPathsFromDominator(block)) {
+        generation_ = next_generation_++;
+      }
+      VisitBlock(block);
+      stack.push_back({first_child[BlockIndex(block)], mark, generation_});
+    }
+    if (stack.empty()) break;
+    Frame& top = stack.back();
+    block = top.next_child;
+    if (block == nullptr) {
+      PopTo(top.mark);
+      stack.pop_back();
+      continue;
+    }
+    top.next_child = next_sibling[BlockIndex(block)];
+    generation_ = top.generation;
+  }
+
+  if (FLAG_trace_turbo_reduction) {
+    OFStream os(stdout);
+    os << "- Global value numbering eliminated " << eliminated_count_
+       << " nodes" << std::endl;
+  }
+}
+
+// static
+bool GlobalValueNumbering::IsLoad(Node* node) {
+  switch (node->opcode()) {
+    case IrOpcode::kLoadField:
+    case IrOpcode::kLoadElement:
+    case IrOpcode::kLoadBuffer:
+    case IrOpcode::kLoadTypedElement:
+    case IrOpcode::kLoad:
+    case IrOpcode::kCheckedLoad:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// static
+bool GlobalValueNumbering::IsCheck(Node* node) {
+  return node->opcode() == IrOpcode::kDeoptimizeIf ||
+         node->opcode() == IrOpcode::kDeoptimizeUnless;
+}
+
+// static
+bool GlobalValueNumbering::IsPure(Node* node) {
+  return node->op()->HasProperty(Operator::kPure) &&
+         node->op()->EffectInputCount() == 0 &&
+         node->op()->ControlInputCount() == 0;
+}
+
+// static
+bool GlobalValueNumbering::Writes(Node* node) {
+  return node->op()->EffectOutputCount() > 0 &&
+         !node->op()->HasProperty(Operator::kNoWrite);
+}
+
+// static
+size_t GlobalValueNumbering::HashCode(Node* node) {
+  // Checks only differ in their deoptimization reason and frame state, which
+  // don't matter once an equivalent check has passed.
+  if (IsCheck(node)) {
+    return base::hash_combine(node->opcode(),
+                              NodeProperties::GetValueInput(node, 0)->id());
+  }
+  size_t h = node->op()->HashCode();
+  for (int i = 0; i < node->op()->ValueInputCount(); ++i) {
+    h = base::hash_combine(h, NodeProperties::GetValueInput(node, i)->id());
+  }
+  return h;
+}
+
+// static
+bool GlobalValueNumbering::Equals(Node* a, Node* b) {
+  if (IsCheck(a)) {
+    return a->opcode() == b->opcode() &&
+           NodeProperties::GetValueInput(a, 0) ==
+               NodeProperties::GetValueInput(b, 0);
+  }
+  if (!a->op()->Equals(b->op())) return false;
+  if (a->op()->ValueInputCount() != b->op()->ValueInputCount()) return false;
+  for (int i = 0; i < a->op()->ValueInputCount(); ++i) {
+    if (NodeProperties::GetValueInput(a, i) !=
+        NodeProperties::GetValueInput(b, i)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void GlobalValueNumbering::VisitBlock(BasicBlock* block) {
+  for (Node* node : *block) VisitNode(node);
+  if (block->control_input() != nullptr && Writes(block->control_input())) {
+    generation_ = next_generation_++;
+  }
+}
+
+void GlobalValueNumbering::VisitNode(Node* node) {
+  if (IsLoad(node) || IsCheck(node) || IsPure(node)) {
+    size_t const hash = HashCode(node);
+    Node* replacement = Lookup(node, hash);
+    if (replacement != nullptr) {
+      Eliminate(node, replacement);
+      return;
+    }
+    Insert(node, hash);
+  }
+  if (Writes(node)) generation_ = next_generation_++;
+}
+
+bool GlobalValueNumbering::HasWriteOnPathsFromDominator(BasicBlock* block) {
+  // Walk backwards from the predecessors of {block} until the dominator is
+  // reached. For loop headers this includes the whole loop.
+  BasicBlock* dominator = block->dominator();
+  if (dominator == nullptr) return false;
+  if (block->PredecessorCount() == 1) {
+    DCHECK_EQ(dominator, block->PredecessorAt(0));
+    return false;
+  }
+  visit_stamp_++;
+  worklist_.clear();
+  for (BasicBlock* predecessor : block->predecessors()) {
+    worklist_.push_back(predecessor);
+  }
+  while (!worklist_.empty()) {
+    BasicBlock* current = worklist_.back();
+    worklist_.pop_back();
+    if (current == dominator) continue;
+    size_t const index = BlockIndex(current);
+    if (visited_[index] == visit_stamp_) continue;
+    visited_[index] = visit_stamp_;
+    if (block_writes_[index]) return true;
+    for (BasicBlock* predecessor : current->predecessors()) {
+      worklist_.push_back(predecessor);
+    }
+  }
+  return false;
+}
+
+Node* GlobalValueNumbering::Lookup(Node* node, size_t hash) {
+  bool const is_load = IsLoad(node);
+  size_t const bucket = hash & (buckets_.size() - 1);
+  for (int i = buckets_[bucket]; i >= 0; i = entries_[i].next) {
+    Entry const& entry = entries_[i];
+    if (is_load && entry.generation != generation_) continue;
+    if (Equals(node, entry.node)) return entry.node;
+  }
+  return nullptr;
+}
+
+void GlobalValueNumbering::Insert(Node* node, size_t hash) {
+  size_t const bucket = hash & (buckets_.size() - 1);
+  entries_.push_back({node, generation_, bucket, buckets_[bucket]});
+  buckets_[bucket] = static_cast<int>(entries_.size() - 1);
+}
+
+void GlobalValueNumbering::PopTo(size_t mark) {
+  while (entries_.size() > mark) {
+    Entry const& entry = entries_.back();
+    buckets_[entry.bucket] = entry.next;
+    entries_.pop_back();
+  }
+}
+
+void GlobalValueNumbering::Eliminate(Node* node, Node* replacement) {
+  if (FLAG_trace_turbo_reduction) {
+    OFStream os(stdout);
+    os << "- Replacing " << *node << " with " << *replacement
+       << " by global value numbering" << std::endl;
+  }
+  Node* effect = node->op()->EffectInputCount() > 0
+                     ? NodeProperties::GetEffectInput(node)
+                     : nullptr;
+  Node* control = node->op()->ControlInputCount() > 0
+                      ? NodeProperties::GetControlInput(node)
+                      : nullptr;
+  // A passed check has no value to replace uses with.
+  NodeProperties::ReplaceUses(node, IsCheck(node) ? nullptr : replacement,
+                              effect, control);
+  node->Kill();
+  eliminated_count_++;
+}
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
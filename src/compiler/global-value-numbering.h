@@ -0,0 +1,84 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_COMPILER_GLOBAL_VALUE_NUMBERING_H_
+#define V8_COMPILER_GLOBAL_VALUE_NUMBERING_H_
+
+#include "src/compiler/schedule.h"
+#include "src/zone-containers.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+class Graph;
+
+// Eliminates loads, checks and pure nodes that are redundant with an
+// equivalent node in a dominating block. Runs on the effect and control
+// linearized graph, where checks have been lowered to DeoptimizeIf and
+// DeoptimizeUnless, and walks the dominator tree of a schedule of the graph
+// with a scoped table of available nodes.
+//
+// A load is only reused if nothing writes to memory between the two loads,
+// neither in the blocks on the dominator tree path between them nor in any
+// block on a path from the dominating block into a join point or loop header
+// on the way. Checks and pure nodes only depend on their inputs.
+class GlobalValueNumbering final {
+ public:
+  GlobalValueNumbering(Graph* graph, Schedule* schedule, Zone* temp_zone);
+
+  void Run();
+
+  size_t eliminated_count() const { return eliminated_count_; }
+
+ private:
+  struct Entry {
+    Node* node;
+    uint32_t generation;
+    size_t bucket;
+    int next;
+  };
+
+  static bool IsLoad(Node* node);
+  static bool IsCheck(Node* node);
+  static bool IsPure(Node* node);
+  static bool Writes(Node* node);
+  static size_t HashCode(Node* node);
+  static bool Equals(Node* a, Node* b);
+
+  void VisitBlock(BasicBlock* block);
+  void VisitNode(Node* node);
+  bool HasWriteOnPathsFromDominator(BasicBlock* block);
+
+  Node* Lookup(Node* node, size_t hash);
+  void Insert(Node* node, size_t hash);
+  void PopTo(size_t mark);
+  void Eliminate(Node* node, Node* replacement);
+
+  static size_t BlockIndex(BasicBlock* block) { return block->id().ToSize(); }
+
+  Graph* const graph_;
+  Schedule* const schedule_;
+  Zone* const temp_zone_;
+
+  // Scoped hash table, chained through {Entry::next}.
+  ZoneVector<Entry> entries_;
+  ZoneVector<int> buckets_;
+
+  // Loads are only available in the memory generation they were seen in.
+  uint32_t generation_;
+  uint32_t next_generation_;
+
+  ZoneVector<bool> block_writes_;
+  ZoneVector<uint32_t> visited_;
+  uint32_t visit_stamp_;
+  BasicBlockVector worklist_;
+  size_t eliminated_count_;
+};
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_COMPILER_GLOBAL_VALUE_NUMBERING_H_
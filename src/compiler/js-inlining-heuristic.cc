@@ -5,13 +5,41 @@
 #include "src/compiler/js-inlining-heuristic.h"
 
 #include "src/compiler.h"
+#include "src/compiler/common-operator.h"
 #include "src/compiler/node-matchers.h"
+#include "src/compiler/simplified-operator.h"
 #include "src/objects-inl.h"
 
 namespace v8 {
 namespace internal {
 namespace compiler {
 
+namespace {
+
+bool CanInlineFunction(Handle<JSFunction> function) {
+  // Built-in functions are handled by the JSBuiltinReducer.
+  if (function->shared()->HasBuiltinFunctionId()) return false;
+
+  // Don't inline builtins.
+  if (function->shared()->IsBuiltin()) return false;
+
+  // Quick check on source code length to avoid parsing large candidate.
+  if (function->shared()->SourceSize() > FLAG_max_inlined_source_size) {
+    return false;
+  }
+
+  // Quick check on the size of the AST to avoid parsing large candidate.
+  if (function->shared()->ast_node_count() > FLAG_max_inlined_nodes) {
+    return false;
+  }
+
+  // Avoid inlining across the boundary of asm.js code.
+  if (function->shared()->asm_function()) return false;
+  return true;
+}
+
+}  // namespace
+
 Reduction JSInliningHeuristic::Reduce(Node* node) {
   if (!IrOpcode::IsInlineeOpcode(node->opcode())) return NoChange();
 
@@ -21,49 +49,41 @@ Reduction JSInliningHeuristic::Reduce(Node* node) {
 
   Node* callee = node->InputAt(0);
   HeapObjectMatcher match(callee);
-  if (!match.HasValue() || !match.Value()->IsJSFunction()) return NoChange();
-  Handle<JSFunction> function = Handle<JSFunction>::cast(match.Value());
-
-  // Functions marked with %SetForceInlineFlag are immediately inlined.
-  if (function->shared()->force_inline()) {
-    return inliner_.ReduceJSCall(node, function);
-  }
+  if (match.HasValue() && match.Value()->IsJSFunction()) {
+    Handle<JSFunction> function = Handle<JSFunction>::cast(match.Value());
 
-  // Handling of special inlining modes right away:
-  //  - For restricted inlining: stop all handling at this point.
-  //  - For stressing inlining: immediately handle all functions.
-  switch (mode_) {
-    case kRestrictedInlining:
-      return NoChange();
-    case kStressInlining:
+    // Functions marked with %SetForceInlineFlag are immediately inlined.
+    if (function->shared()->force_inline()) {
       return inliner_.ReduceJSCall(node, function);
-    case kGeneralInlining:
-      break;
+    }
+
+    // Handling of special inlining modes right away:
+    //  - For restricted inlining: stop all handling at this point.
+    //  - For stressing inlining: immediately handle all functions.
+    switch (mode_) {
+      case kRestrictedInlining:
+        return NoChange();
+      case kStressInlining:
+        return inliner_.ReduceJSCall(node, function);
+      case kGeneralInlining:
+        break;
+    }
+  } else if (mode_ != kGeneralInlining || !FLAG_polymorphic_inlining ||
+             callee->opcode() != IrOpcode::kPhi) {
+    return NoChange();
   }
 
   // ---------------------------------------------------------------------------
   // Everything below this line is part of the inlining heuristic.
   // ---------------------------------------------------------------------------
 
-  // Built-in functions are handled by the JSBuiltinReducer.
-  if (function->shared()->HasBuiltinFunctionId()) return NoChange();
-
-  // Don't inline builtins.
-  if (function->shared()->IsBuiltin()) return NoChange();
-
-  // Quick check on source code length to avoid parsing large candidate.
-  if (function->shared()->SourceSize() > FLAG_max_inlined_source_size) {
-    return NoChange();
-  }
+  Candidate candidate;
+  candidate.node = node;
+  CollectFunctions(callee, &candidate);
+  if (candidate.num_functions == 0) return NoChange();
 
-  // Quick check on the size of the AST to avoid parsing large candidate.
-  if (function->shared()->ast_node_count() > FLAG_max_inlined_nodes) {
-    return NoChange();
-  }
-
-  // Avoid inlining within or across the boundary of asm.js code.
+  // Avoid inlining within the boundary of asm.js code.
   if (info_->shared_info()->asm_function()) return NoChange();
-  if (function->shared()->asm_function()) return NoChange();
 
   // Stop inlinining once the maximum allowed level is reached.
   int level = 0;
@@ -88,19 +108,21 @@ Reduction JSInliningHeuristic::Reduce(Node* node) {
       int const extra_index =
           p.feedback().vector()->GetIndex(p.feedback().slot()) + 1;
       Handle<Object> feedback_extra(p.feedback().vector()->get(extra_index),
-                                    function->GetIsolate());
+                                    info_->isolate());
       if (feedback_extra->IsSmi()) {
         calls = Handle<Smi>::cast(feedback_extra)->value();
       }
     }
   }
+  candidate.calls = calls;
+  max_calls_ = std::max(max_calls_, calls);
 
   // ---------------------------------------------------------------------------
   // Everything above this line is part of the inlining heuristic.
   // ---------------------------------------------------------------------------
 
   // In the general case we remember the candidate for later.
-  candidates_.insert({function, node, calls});
+  candidates_.insert(candidate);
   return NoChange();
 }
 
@@ -118,22 +140,191 @@ void JSInliningHeuristic::Finalize() {
     auto i = candidates_.begin();
     Candidate candidate = *i;
     candidates_.erase(i);
-    // Make sure we don't try to inline dead candidate nodes.
-    if (!candidate.node->IsDead()) {
-      Reduction r = inliner_.ReduceJSCall(candidate.node, candidate.function);
-      if (r.Changed()) {
-        cumulative_count_ += candidate.function->shared()->ast_node_count();
-        return;
-      }
+    // Make sure we don't try to inline dead or cold candidate nodes.
+    if (candidate.node->IsDead() || !IsHotEnough(candidate)) continue;
+    // Make sure the candidate fits into the budget. Polymorphic candidates
+    // inline all of their known targets, so {size} covers all of them.
+    if (cumulative_count_ + candidate.size >
+        FLAG_max_inlined_nodes_cumulative) {
+      continue;
+    }
+    Reduction r = InlineCandidate(candidate);
+    if (r.Changed()) return;
+  }
+}
+
+
+void JSInliningHeuristic::CollectFunctions(Node* callee,
+                                           Candidate* candidate) {
+  candidate->num_functions = 0;
+  candidate->needs_fallback = false;
+  candidate->size = 0;
+  int const input_count = callee->opcode() == IrOpcode::kPhi
+                              ? callee->op()->ValueInputCount()
+                              : 1;
+  for (int i = 0; i < input_count; ++i) {
+    Node* input = callee->opcode() == IrOpcode::kPhi ? callee->InputAt(i)
+                                                     : callee;
+    HeapObjectMatcher match(input);
+    if (!match.HasValue() || !match.Value()->IsJSFunction()) {
+      candidate->needs_fallback = true;
+      continue;
+    }
+    Handle<JSFunction> function = Handle<JSFunction>::cast(match.Value());
+    bool seen = false;
+    for (int j = 0; j < candidate->num_functions; ++j) {
+      if (candidate->functions[j].is_identical_to(function)) seen = true;
     }
+    if (seen) continue;
+    if (candidate->num_functions == kMaxCallPolymorphism ||
+        !CanInlineFunction(function)) {
+      candidate->needs_fallback = true;
+      continue;
+    }
+    candidate->functions[candidate->num_functions++] = function;
+    candidate->size += function->shared()->ast_node_count();
   }
 }
 
 
+bool JSInliningHeuristic::IsHotEnough(const Candidate& candidate) const {
+  // Without an invocation count for the function being optimized, the call
+  // frequency is measured against the hottest call site in the graph. Sites
+  // that are hit a lot less often are not worth the inlining budget.
+  if (max_calls_ <= 0) return true;
+  return candidate.calls >= FLAG_min_inlining_frequency * max_calls_;
+}
+
+
+Reduction JSInliningHeuristic::InlineCandidate(const Candidate& candidate) {
+  Node* const node = candidate.node;
+  if (candidate.num_functions == 1 && !candidate.needs_fallback) {
+    Handle<JSFunction> function = candidate.functions[0];
+    Reduction const reduction = inliner_.ReduceJSCall(node, function);
+    if (reduction.Changed()) {
+      cumulative_count_ += function->shared()->ast_node_count();
+    }
+    return reduction;
+  }
+
+  // Expand the call {node} into a dispatch on the call target first, which
+  // compares the {callee} against each of the known targets, and calls the
+  // original {callee} in the fallback case.
+  int const num_calls =
+      candidate.num_functions + (candidate.needs_fallback ? 1 : 0);
+  Node* calls[kMaxCallPolymorphism + 2];
+  Node* if_successes[kMaxCallPolymorphism + 1];
+  Node* const callee = NodeProperties::GetValueInput(node, 0);
+  Node* fallthrough_control = NodeProperties::GetControlInput(node);
+
+  // Setup the inputs for the cloned call nodes.
+  int const input_count = node->InputCount();
+  Node** inputs = graph()->zone()->NewArray<Node*>(input_count);
+  for (int i = 0; i < input_count; ++i) {
+    inputs[i] = node->InputAt(i);
+  }
+
+  // For {JSCallConstruct} nodes of the form new {callee}(args...) the clones
+  // must pass their known target as new.target as well.
+  int new_target_index = -1;
+  if (node->opcode() == IrOpcode::kJSCallConstruct) {
+    CallConstructParameters const& p = CallConstructParametersOf(node->op());
+    int const index = static_cast<int>(p.arity()) - 1;
+    if (NodeProperties::GetValueInput(node, index) == callee) {
+      new_target_index = index;
+    }
+  }
+
+  for (int i = 0; i < num_calls; ++i) {
+    Node* target = callee;
+    if (i < candidate.num_functions) {
+      target = jsgraph()->HeapConstant(candidate.functions[i]);
+    }
+    if (i < num_calls - 1) {
+      Node* check =
+          graph()->NewNode(simplified()->ReferenceEqual(), callee, target);
+      Node* branch =
+          graph()->NewNode(common()->Branch(), check, fallthrough_control);
+      fallthrough_control = graph()->NewNode(common()->IfFalse(), branch);
+      if_successes[i] = graph()->NewNode(common()->IfTrue(), branch);
+    } else {
+      if_successes[i] = fallthrough_control;
+    }
+
+    // The cloned call sites call the known target directly, so that they
+    // are inlined like monomorphic call sites below.
+    inputs[0] = target;
+    if (new_target_index >= 0) inputs[new_target_index] = target;
+    inputs[input_count - 1] = if_successes[i];
+    calls[i] = if_successes[i] =
+        graph()->NewNode(node->op(), input_count, inputs);
+
+    // The clones are inlined right below if possible, and the fallback call
+    // already failed all checks against the known targets. Don't consider any
+    // of them as candidates again, otherwise the fallback call would be
+    // expanded into another dispatch over the same targets.
+    seen_.insert(calls[i]->id());
+  }
+
+  // Join the exceptional control flow of the cloned call sites.
+  if (NodeProperties::IsExceptionalCall(node)) {
+    Node* if_exception = nullptr;
+    for (Node* use : node->uses()) {
+      if (use->opcode() == IrOpcode::kIfException) if_exception = use;
+    }
+    Node* if_exceptions[kMaxCallPolymorphism + 2];
+    for (int i = 0; i < num_calls; ++i) {
+      if_successes[i] = graph()->NewNode(common()->IfSuccess(), calls[i]);
+      if_exceptions[i] =
+          graph()->NewNode(common()->IfException(), calls[i], calls[i]);
+    }
+    Node* exception_control =
+        graph()->NewNode(common()->Merge(num_calls), num_calls, if_exceptions);
+    if_exceptions[num_calls] = exception_control;
+    Node* exception_effect = graph()->NewNode(common()->EffectPhi(num_calls),
+                                              num_calls + 1, if_exceptions);
+    Node* exception_value = graph()->NewNode(
+        common()->Phi(MachineRepresentation::kTagged, num_calls), num_calls + 1,
+        if_exceptions);
+    ReplaceWithValue(if_exception, exception_value, exception_effect,
+                     exception_control);
+  }
+
+  // Join the regular control flow of the cloned call sites.
+  Node* control =
+      graph()->NewNode(common()->Merge(num_calls), num_calls, if_successes);
+  calls[num_calls] = control;
+  Node* effect =
+      graph()->NewNode(common()->EffectPhi(num_calls), num_calls + 1, calls);
+  Node* value =
+      graph()->NewNode(common()->Phi(MachineRepresentation::kTagged, num_calls),
+                       num_calls + 1, calls);
+  ReplaceWithValue(node, value, effect, control);
+  node->Kill();
+
+  // Inline the cloned call sites with known targets.
+  for (int i = 0; i < candidate.num_functions; ++i) {
+    Handle<JSFunction> function = candidate.functions[i];
+    Reduction const reduction = inliner_.ReduceJSCall(calls[i], function);
+    if (reduction.Changed()) {
+      cumulative_count_ += function->shared()->ast_node_count();
+    }
+  }
+
+  return Replace(value);
+}
+
+
 bool JSInliningHeuristic::CandidateCompare::operator()(
     const Candidate& left, const Candidate& right) const {
-  if (left.calls != right.calls) {
-    return left.calls > right.calls;
+  // Prefer the candidates that save the most calls per AST node inlined,
+  // i.e. compare left.calls / left.size against right.calls / right.size.
+  int64_t const left_score =
+      static_cast<int64_t>(left.calls) * std::max(right.size, 1);
+  int64_t const right_score =
+      static_cast<int64_t>(right.calls) * std::max(left.size, 1);
+  if (left_score != right_score) {
+    return left_score > right_score;
   }
   return left.node < right.node;
 }
@@ -142,14 +333,27 @@ bool JSInliningHeuristic::CandidateCompare::operator()(
 void JSInliningHeuristic::PrintCandidates() {
   PrintF("Candidates for inlining (size=%zu):\n", candidates_.size());
   for (const Candidate& candidate : candidates_) {
-    PrintF("  id:%d, calls:%d, size[source]:%d, size[ast]:%d / %s\n",
-           candidate.node->id(), candidate.calls,
-           candidate.function->shared()->SourceSize(),
-           candidate.function->shared()->ast_node_count(),
-           candidate.function->shared()->DebugName()->ToCString().get());
+    PrintF("  id:%d, calls:%d, size[ast]:%d%s\n", candidate.node->id(),
+           candidate.calls, candidate.size,
+           candidate.needs_fallback ? ", with fallback" : "");
+    for (int i = 0; i < candidate.num_functions; ++i) {
+      SharedFunctionInfo* shared = candidate.functions[i]->shared();
+      PrintF("  - size[source]:%d, size[ast]:%d / %s\n", shared->SourceSize(),
+             shared->ast_node_count(), shared->DebugName()->ToCString().get());
+    }
   }
 }
 
+Graph* JSInliningHeuristic::graph() const { return jsgraph()->graph(); }
+
+CommonOperatorBuilder* JSInliningHeuristic::common() const {
+  return jsgraph()->common();
+}
+
+SimplifiedOperatorBuilder* JSInliningHeuristic::simplified() const {
+  return jsgraph()->simplified();
+}
+
 }  // namespace compiler
 }  // namespace internal
 }  // namespace v8
@@ -21,7 +21,8 @@ class JSInliningHeuristic final : public AdvancedReducer {
         inliner_(editor, local_zone, info, jsgraph),
         candidates_(local_zone),
         seen_(local_zone),
-        info_(info) {}
+        info_(info),
+        jsgraph_(jsgraph) {}
 
   Reduction Reduce(Node* node) final;
 
@@ -30,10 +31,17 @@ class JSInliningHeuristic final : public AdvancedReducer {
   void Finalize() final;
 
  private:
+  // This limit currently matches what Crankshaft does. We may want to
+  // re-evaluate and come up with a proper limit for TurboFan.
+  static const int kMaxCallPolymorphism = 4;
+
   struct Candidate {
-    Handle<JSFunction> function;  // The call target being inlined.
-    Node* node;                   // The call site at which to inline.
-    int calls;                    // Number of times the call site was hit.
+    Handle<JSFunction> functions[kMaxCallPolymorphism];  // The call targets.
+    int num_functions;    // Number of call targets being inlined.
+    bool needs_fallback;  // Whether other targets need a generic call.
+    Node* node;           // The call site at which to inline.
+    int calls;            // Number of times the call site was hit.
+    int size;             // Total AST node count of the call targets.
   };
 
   // Comparator for candidates.
@@ -44,15 +52,33 @@ class JSInliningHeuristic final : public AdvancedReducer {
   // Candidates are kept in a sorted set of unique candidates.
   typedef ZoneSet<Candidate, CandidateCompare> Candidates;
 
+  // Collects the call targets of {candidate} from the {callee} node, which
+  // is either a constant function or a phi of constant functions.
+  void CollectFunctions(Node* callee, Candidate* candidate);
+
+  // Checks whether the call site is hit often enough to be worth inlining.
+  bool IsHotEnough(const Candidate& candidate) const;
+
+  // Inlines {candidate}, dispatching on the call target first if there is
+  // more than one.
+  Reduction InlineCandidate(const Candidate& candidate);
+
   // Dumps candidates to console.
   void PrintCandidates();
 
+  CommonOperatorBuilder* common() const;
+  Graph* graph() const;
+  JSGraph* jsgraph() const { return jsgraph_; }
+  SimplifiedOperatorBuilder* simplified() const;
+
   Mode const mode_;
   JSInliner inliner_;
   Candidates candidates_;
   ZoneSet<NodeId> seen_;
   CompilationInfo* info_;
+  JSGraph* const jsgraph_;
   int cumulative_count_ = 0;
+  int max_calls_ = 0;
 };
 
 }  // namespace compiler
@@ -250,6 +250,14 @@ void LoopVariableOptimizer::VisitIf(Node* node, bool polarity) {
     case IrOpcode::kJSGreaterThanOrEqual:
       AddCmpToLimits(limits, cond, InductionVariable::kStrict, !polarity);
       break;
+    case IrOpcode::kNumberLessThan:
+    case IrOpcode::kSpeculativeNumberLessThan:
+      AddCmpToLimits(limits, cond, InductionVariable::kStrict, polarity);
+      break;
+    case IrOpcode::kNumberLessThanOrEqual:
+    case IrOpcode::kSpeculativeNumberLessThanOrEqual:
+      AddCmpToLimits(limits, cond, InductionVariable::kNonStrict, polarity);
+      break;
     default:
       break;
   }
@@ -308,7 +316,9 @@ InductionVariable* LoopVariableOptimizer::TryGetInductionVariable(Node* phi) {
   Node* initial = phi->InputAt(0);
   Node* arith = phi->InputAt(1);
   // TODO(jarin) Support subtraction.
-  if (arith->opcode() != IrOpcode::kJSAdd) {
+  if (arith->opcode() != IrOpcode::kJSAdd &&
+      arith->opcode() != IrOpcode::kNumberAdd &&
+      arith->opcode() != IrOpcode::kSpeculativeNumberAdd) {
     return nullptr;
   }
   // TODO(jarin) Support both sides.
@@ -339,6 +349,39 @@ void LoopVariableOptimizer::DetectInductionVariables(Node* loop) {
   TRACE("\n");
 }
 
+bool LoopVariableOptimizer::IsKnownLessThan(Node* control, Node* left,
+                                            Node* right) {
+  auto limits = limits_.find(control->id());
+  if (limits == limits_.end()) return false;
+  for (const Constraint* constraint = limits->second->head();
+       constraint != nullptr; constraint = constraint->next()) {
+    if (constraint->left() != left) continue;
+    Node* bound = constraint->right();
+    if (bound == right) {
+      if (constraint->kind() == InductionVariable::kStrict) return true;
+      continue;
+    }
+    // Otherwise {left} is below {right} if the ranges of {bound} and {right}
+    // don't overlap.
+    if (!NodeProperties::IsTyped(bound) || !NodeProperties::IsTyped(right)) {
+      continue;
+    }
+    Type* bound_type = NodeProperties::GetType(bound);
+    Type* right_type = NodeProperties::GetType(right);
+    if (!bound_type->IsInhabited() || !right_type->IsInhabited() ||
+        !bound_type->Is(Type::OrderedNumber()) ||
+        !right_type->Is(Type::OrderedNumber())) {
+      continue;
+    }
+    if (constraint->kind() == InductionVariable::kStrict
+            ? bound_type->Max() <= right_type->Min()
+            : bound_type->Max() < right_type->Min()) {
+      return true;
+    }
+  }
+  return false;
+}
+
 void LoopVariableOptimizer::ChangeToInductionVariablePhis() {
   for (auto entry : induction_vars_) {
     // It only make sense to analyze the induction variables if
@@ -67,6 +67,10 @@ class LoopVariableOptimizer {
     return induction_vars_;
   }
 
+  // Returns true if the branch conditions that dominate {control} guarantee
+  // that {left} is less than {right}.
+  bool IsKnownLessThan(Node* control, Node* left, Node* right);
+
   void ChangeToInductionVariablePhis();
   void ChangeToPhisAndInsertGuards();
 
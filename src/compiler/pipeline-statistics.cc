@@ -54,9 +54,12 @@ PipelineStatistics::PipelineStatistics(CompilationInfo* info,
       phase_name_(nullptr) {
   if (info->has_shared_info()) {
     source_size_ = static_cast<size_t>(info->shared_info()->SourceSize());
-    std::unique_ptr<char[]> name =
-        info->shared_info()->DebugName()->ToCString();
-    function_name_ = name.get();
+    // The function name is only needed to print the statistics.
+    if (FLAG_turbo_stats || FLAG_turbo_stats_nvp) {
+      std::unique_ptr<char[]> name =
+          info->shared_info()->DebugName()->ToCString();
+      function_name_ = name.get();
+    }
   }
   total_stats_.Begin(this);
 }
@@ -13,6 +13,7 @@
 #include "src/compiler/ast-graph-builder.h"
 #include "src/compiler/ast-loop-assignment-analyzer.h"
 #include "src/compiler/basic-block-instrumentor.h"
+#include "src/compiler/bounds-check-elimination.h"
 #include "src/compiler/branch-elimination.h"
 #include "src/compiler/bytecode-graph-builder.h"
 #include "src/compiler/checkpoint-elimination.h"
@@ -24,6 +25,7 @@
 #include "src/compiler/escape-analysis-reducer.h"
 #include "src/compiler/escape-analysis.h"
 #include "src/compiler/frame-elider.h"
+#include "src/compiler/global-value-numbering.h"
 #include "src/compiler/graph-replay.h"
 #include "src/compiler/graph-trimmer.h"
 #include "src/compiler/graph-visualizer.h"
@@ -376,7 +378,9 @@ class PipelineImpl final {
   template <typename Phase, typename Arg0, typename Arg1>
   void Run(Arg0 arg_0, Arg1 arg_1);
 
-  // Run the graph creation and initial optimization passes.
+  // Run the graph creation and initial optimization passes. These run on the
+  // main thread, also for concurrent recompilation, since graph building,
+  // typing and the typed lowerings read the heap.
   bool CreateGraph();
 
   // Run the concurrent optimization passes.
@@ -526,7 +530,9 @@ PipelineStatistics* CreatePipelineStatistics(CompilationInfo* info,
                                              ZonePool* zone_pool) {
   PipelineStatistics* pipeline_statistics = nullptr;
 
-  if (FLAG_turbo_stats || FLAG_turbo_stats_nvp) {
+  // The statistics exposed through the API only cover JavaScript functions.
+  if (FLAG_turbo_stats || FLAG_turbo_stats_nvp ||
+      (info->isolate()->compile_statistics_enabled() && !info->IsStub())) {
     pipeline_statistics = new PipelineStatistics(info, zone_pool);
     pipeline_statistics->BeginPhaseKind("initializing");
   }
@@ -1063,6 +1069,23 @@ struct EffectControlLinearizationPhase {
   }
 };
 
+struct GlobalValueNumberingPhase {
+  static const char* phase_name() { return "global value numbering"; }
+
+  void Run(PipelineData* data, Zone* temp_zone) {
+    // The scheduler requires the graphs to be trimmed.
+    GraphTrimmer trimmer(temp_zone, data->graph());
+    NodeVector roots(temp_zone);
+    data->jsgraph()->GetCachedNodes(&roots);
+    trimmer.TrimGraph(roots.begin(), roots.end());
+
+    Schedule* schedule = Scheduler::ComputeSchedule(temp_zone, data->graph(),
+                                                    Scheduler::kNoFlags);
+    GlobalValueNumbering gvn(data->graph(), schedule, temp_zone);
+    gvn.Run();
+  }
+};
+
 // The store-store elimination greatly benefits from doing a common operator
 // reducer just before it, to eliminate conditional deopts with a constant
 // condition.
@@ -1121,6 +1144,21 @@ struct LoadEliminationPhase {
   }
 };
 
+struct BoundsCheckEliminationPhase {
+  static const char* phase_name() { return "bounds check elimination"; }
+
+  void Run(PipelineData* data, Zone* temp_zone) {
+    LoopVariableOptimizer induction_vars(data->jsgraph()->graph(),
+                                         data->common(), temp_zone);
+    induction_vars.Run();
+    JSGraphReducer graph_reducer(data->jsgraph(), temp_zone);
+    BoundsCheckElimination bounds_check_elimination(&graph_reducer,
+                                                    &induction_vars);
+    AddReducer(data, &graph_reducer, &bounds_check_elimination);
+    graph_reducer.ReduceGraph();
+  }
+};
+
 struct MemoryOptimizationPhase {
   static const char* phase_name() { return "memory optimization"; }
 
@@ -1500,7 +1538,9 @@ bool PipelineImpl::CreateGraph() {
     GraphReplayPrinter::PrintReplay(data->graph());
   }
 
-  // Run the type-sensitive lowerings and optimizations on the graph.
+  // Run the type-sensitive lowerings and optimizations on the graph. Types
+  // of constants refer to heap objects, so everything up to generic lowering
+  // has to stay on the main thread.
   {
     // Type the graph and keep the Typer running on newly created nodes within
     // this scope; the Typer is automatically unlinked from the Graph once we
@@ -1537,6 +1577,11 @@ bool PipelineImpl::CreateGraph() {
       Run<LoadEliminationPhase>();
       RunPrintAndVerify("Load eliminated");
     }
+
+    if (FLAG_turbo_bounds_check_elimination) {
+      Run<BoundsCheckEliminationPhase>();
+      RunPrintAndVerify("Bounds checks eliminated");
+    }
   }
 
   // Select representations. This has to run w/o the Typer decorator, because
@@ -1586,6 +1631,11 @@ bool PipelineImpl::OptimizeGraph(Linkage* linkage) {
   Run<DeadCodeEliminationPhase>();
   RunPrintAndVerify("Common operator reducer", true);
 
+  if (FLAG_turbo_gvn) {
+    Run<GlobalValueNumberingPhase>();
+    RunPrintAndVerify("Global value numbering", true);
+  }
+
   if (FLAG_turbo_store_elimination) {
     Run<StoreStoreEliminationPhase>();
     RunPrintAndVerify("Store-store elimination", true);
@@ -145,8 +145,182 @@ int InstructionScheduler::GetTargetInstructionFlags(
 
 
 int InstructionScheduler::GetInstructionLatency(const Instruction* instr) {
-  // TODO(all): Add instruction cost modeling.
-  return 1;
+  // Latency modeling for POWER8 instructions, taken from the POWER8 processor
+  // user's manual. The scheduler has no notion of dispatch groups, so long
+  // latency operations that break a group (divides, moves between register
+  // files) are accounted for by a slightly higher latency.
+  // Instruction scheduling stays opt-in on PPC, as on the other ports: these
+  // latencies are only used with --turbo-instruction-scheduling.
+  switch (instr->arch_opcode()) {
+    case kPPC_And:
+    case kPPC_AndComplement:
+    case kPPC_Or:
+    case kPPC_OrComplement:
+    case kPPC_Xor:
+    case kPPC_Not:
+    case kPPC_Add:
+    case kPPC_Sub:
+    case kPPC_Neg:
+    case kPPC_ExtendSignWord8:
+    case kPPC_ExtendSignWord16:
+    case kPPC_ExtendSignWord32:
+    case kPPC_Uint32ToUint64:
+    case kPPC_Int64ToInt32:
+      return 2;
+
+    case kPPC_ShiftLeft32:
+    case kPPC_ShiftLeft64:
+    case kPPC_ShiftRight32:
+    case kPPC_ShiftRight64:
+    case kPPC_ShiftRightAlg32:
+    case kPPC_ShiftRightAlg64:
+    case kPPC_RotRight32:
+    case kPPC_RotRight64:
+    case kPPC_RotLeftAndMask32:
+    case kPPC_RotLeftAndClear64:
+    case kPPC_RotLeftAndClearLeft64:
+    case kPPC_RotLeftAndClearRight64:
+    case kPPC_Cntlz32:
+    case kPPC_Cntlz64:
+      return 2;
+
+    case kPPC_Popcnt32:
+    case kPPC_Popcnt64:
+      return 3;
+
+    case kPPC_AddWithOverflow32:
+    case kPPC_SubWithOverflow32:
+    case kPPC_Cmp32:
+    case kPPC_Cmp64:
+    case kPPC_Tst32:
+    case kPPC_Tst64:
+      return 3;
+
+    case kPPC_ShiftLeftPair:
+    case kPPC_ShiftRightPair:
+    case kPPC_ShiftRightAlgPair:
+    case kPPC_AddPair:
+    case kPPC_SubPair:
+      return 4;
+
+    case kPPC_Mul32:
+    case kPPC_Mul64:
+    case kPPC_MulHigh32:
+    case kPPC_MulHighU32:
+      return 5;
+
+    case kPPC_Mul32WithHigh32:
+    case kPPC_MulPair:
+      return 7;
+
+    case kPPC_Div32:
+    case kPPC_DivU32:
+      return 23;
+
+    case kPPC_Div64:
+    case kPPC_DivU64:
+      return 37;
+
+    case kPPC_Mod32:
+    case kPPC_ModU32:
+      return 28;
+
+    case kPPC_Mod64:
+    case kPPC_ModU64:
+      return 42;
+
+    case kPPC_AddDouble:
+    case kPPC_SubDouble:
+    case kPPC_MulDouble:
+    case kPPC_FloorDouble:
+    case kPPC_CeilDouble:
+    case kPPC_TruncateDouble:
+    case kPPC_RoundDouble:
+    case kPPC_Float64SilenceNaN:
+      return 6;
+
+    case kPPC_NegDouble:
+    case kPPC_AbsDouble:
+      return 2;
+
+    case kPPC_MaxDouble:
+    case kPPC_MinDouble:
+    case kPPC_CmpDouble:
+      return 8;
+
+    case kPPC_DivDouble:
+      return 33;
+
+    case kPPC_SqrtDouble:
+      return 44;
+
+    case kPPC_ModDouble:
+      // Calls out to a C function.
+      return 100;
+
+    case kPPC_Int64ToFloat32:
+    case kPPC_Int64ToDouble:
+    case kPPC_Uint64ToFloat32:
+    case kPPC_Uint64ToDouble:
+    case kPPC_Int32ToFloat32:
+    case kPPC_Int32ToDouble:
+    case kPPC_Uint32ToFloat32:
+    case kPPC_Uint32ToDouble:
+      // Move to the floating point unit followed by a conversion.
+      return 12;
+
+    case kPPC_DoubleToInt32:
+    case kPPC_DoubleToUint32:
+    case kPPC_DoubleToInt64:
+    case kPPC_DoubleToUint64:
+      // Conversion followed by a move to the fixed point unit.
+      return 12;
+
+    case kPPC_Float32ToDouble:
+    case kPPC_DoubleToFloat32:
+      return 6;
+
+    case kPPC_DoubleExtractLowWord32:
+    case kPPC_DoubleExtractHighWord32:
+    case kPPC_BitcastFloat32ToInt32:
+    case kPPC_BitcastDoubleToInt64:
+    case kPPC_BitcastInt32ToFloat32:
+    case kPPC_BitcastInt64ToDouble:
+      return 6;
+
+    case kPPC_DoubleInsertLowWord32:
+    case kPPC_DoubleInsertHighWord32:
+    case kPPC_DoubleConstruct:
+      return 12;
+
+    case kPPC_LoadWordS8:
+    case kPPC_LoadWordU8:
+    case kPPC_LoadWordS16:
+    case kPPC_LoadWordU16:
+    case kPPC_LoadWordS32:
+    case kPPC_LoadWordU32:
+    case kPPC_LoadWord64:
+      return 3;
+
+    case kPPC_LoadFloat32:
+    case kPPC_LoadDouble:
+      return 5;
+
+    case kCheckedLoadInt8:
+    case kCheckedLoadUint8:
+    case kCheckedLoadInt16:
+    case kCheckedLoadUint16:
+    case kCheckedLoadWord32:
+    case kCheckedLoadWord64:
+      return 6;
+
+    case kCheckedLoadFloat32:
+    case kCheckedLoadFloat64:
+      return 8;
+
+    default:
+      return 1;
+  }
 }
 
 }  // namespace compiler
@@ -858,7 +858,7 @@ void Debug::FloodWithOneShot(Handle<JSFunction> function,
     // Builtin functions are not subject to stepping, but need to be
     // deoptimized, because optimized code does not check for debug
     // step in at call sites.
-    Deoptimizer::DeoptimizeFunction(*function);
+    Deoptimizer::DeoptimizeFunction(*function, DeoptimizeReason::kDebugger);
     return;
   }
   // Make sure the function is compiled and has set up the debug info.
@@ -1022,7 +1022,8 @@ void Debug::PrepareStep(StepAction step_action) {
              !frames_it.frame()->function()->shared()->IsSubjectToDebugging()) {
         // Builtin functions are not subject to stepping, but need to be
         // deoptimized to include checks for step-in at call sites.
-        Deoptimizer::DeoptimizeFunction(frames_it.frame()->function());
+        Deoptimizer::DeoptimizeFunction(frames_it.frame()->function(),
+                                        DeoptimizeReason::kDebugger);
         frames_it.Advance();
       }
       if (!frames_it.done()) {
@@ -1299,7 +1300,8 @@ bool Debug::PrepareFunctionForBreakPoints(Handle<SharedFunctionInfo> shared) {
         JSFunction* function = JSFunction::cast(obj);
         if (!function->Inlines(*shared)) continue;
         if (function->code()->kind() == Code::OPTIMIZED_FUNCTION) {
-          Deoptimizer::DeoptimizeFunction(function);
+          Deoptimizer::DeoptimizeFunction(function,
+                                          DeoptimizeReason::kDebugger);
         }
         if (baseline_exists && function->shared() == *shared) {
           functions.Add(handle(function));
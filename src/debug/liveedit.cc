@@ -692,7 +692,10 @@ MaybeHandle<JSArray> LiveEdit::GatherCompileInfo(Handle<Script> script,
   MaybeHandle<JSArray> infos;
   Handle<Object> original_source =
       Handle<Object>(script->source(), isolate);
+  Handle<Object> original_skippable_functions(script->skippable_functions(),
+                                              isolate);
   script->set_source(*source);
+  script->set_skippable_functions(isolate->heap()->undefined_value());
 
   {
     // Creating verbose TryCatch from public API is currently the only way to
@@ -740,6 +743,7 @@ MaybeHandle<JSArray> LiveEdit::GatherCompileInfo(Handle<Script> script,
 
   // A logical 'finally' section.
   script->set_source(*original_source);
+  script->set_skippable_functions(*original_skippable_functions);
 
   if (rethrow_exception.is_null()) {
     return infos.ToHandleChecked();
@@ -959,7 +963,8 @@ static void DeoptimizeDependentFunctions(SharedFunctionInfo* function_info) {
 
   if (marker.found_) {
     // Only go through with the deoptimization if something was found.
-    Deoptimizer::DeoptimizeMarkedCode(function_info->GetIsolate());
+    Deoptimizer::DeoptimizeMarkedCode(function_info->GetIsolate(),
+                                      DeoptimizeReason::kDebugger);
   }
 }
 
@@ -1195,6 +1200,8 @@ Handle<Object> LiveEdit::ChangeScriptSource(Handle<Script> original_script,
   }
 
   original_script->set_source(*new_source);
+  // Scope data of inner functions refers to positions in the old source.
+  original_script->set_skippable_functions(isolate->heap()->undefined_value());
 
   // Drop line ends so that they will be recalculated.
   original_script->set_line_ends(isolate->heap()->undefined_value());
@@ -15,6 +15,8 @@ namespace internal {
   V(NoReason, "no reason")                                                    \
   V(ConstantGlobalVariableAssignment, "Constant global variable assignment")  \
   V(ConversionOverflow, "conversion overflow")                                \
+  V(Debugger, "debugger")                                                     \
+  V(DependencyChange, "dependency change")                                    \
   V(DivisionByZero, "division by zero")                                       \
   V(ElementsKindUnhandledInKeyedLoadGenericStub,                              \
     "ElementsKind unhandled in KeyedLoadGenericStub")                         \
@@ -58,6 +60,7 @@ namespace internal {
   V(Proxy, "proxy")                                                           \
   V(ReceiverWasAGlobalObject, "receiver was a global object")                 \
   V(Smi, "Smi")                                                               \
+  V(Testing, "testing")                                                       \
   V(TooManyArguments, "too many arguments")                                   \
   V(TracingElementsTransitions, "Tracing elements transitions")               \
   V(TypeMismatchBetweenFeedbackAndConstant,                                   \
@@ -86,6 +89,12 @@ enum class DeoptimizeReason : uint8_t {
 #undef DEOPTIMIZE_REASON
 };
 
+static const int kDeoptimizeReasonCount =
+#define DEOPTIMIZE_REASON(Name, message) 1 +
+    DEOPTIMIZE_REASON_LIST(DEOPTIMIZE_REASON)
+#undef DEOPTIMIZE_REASON
+    0;
+
 std::ostream& operator<<(std::ostream&, DeoptimizeReason);
 
 size_t hash_value(DeoptimizeReason reason);
@@ -9,6 +9,7 @@
 #include "src/accessors.h"
 #include "src/ast/prettyprinter.h"
 #include "src/codegen.h"
+#include "src/compilation-statistics.h"
 #include "src/disasm.h"
 #include "src/frames-inl.h"
 #include "src/full-codegen/full-codegen.h"
@@ -225,7 +226,8 @@ void Deoptimizer::VisitAllOptimizedFunctions(
 // Unlink functions referring to code marked for deoptimization, then move
 // marked code from the optimized code list to the deoptimized code list,
 // and patch code for lazy deopt.
-void Deoptimizer::DeoptimizeMarkedCodeForContext(Context* context) {
+void Deoptimizer::DeoptimizeMarkedCodeForContext(Context* context,
+                                                 DeoptimizeReason reason) {
   DisallowHeapAllocation no_allocation;
 
   // A "closure" that unlinks optimized code that is going to be
@@ -358,11 +360,18 @@ void Deoptimizer::DeoptimizeMarkedCodeForContext(Context* context) {
     // Tell collector to treat this code object in a special way and
     // ignore all slots that might have been recorded on it.
     isolate->heap()->mark_compact_collector()->InvalidateCode(codes[i]);
+
+    // Count the invalidation once for all activations that will lazily
+    // deoptimize.
+    if (reason != DeoptimizeReason::kNoReason &&
+        isolate->collect_compile_statistics()) {
+      isolate->GetTurboStatistics()->RecordDeoptimization(reason);
+    }
   }
 }
 
 
-void Deoptimizer::DeoptimizeAll(Isolate* isolate) {
+void Deoptimizer::DeoptimizeAll(Isolate* isolate, DeoptimizeReason reason) {
   RuntimeCallTimerScope runtimeTimer(isolate,
                                      &RuntimeCallStats::DeoptimizeCode);
   TimerEventScope<TimerEventDeoptimizeCode> timer(isolate);
@@ -378,13 +387,14 @@ void Deoptimizer::DeoptimizeAll(Isolate* isolate) {
   while (!context->IsUndefined(isolate)) {
     Context* native_context = Context::cast(context);
     MarkAllCodeForContext(native_context);
-    DeoptimizeMarkedCodeForContext(native_context);
+    DeoptimizeMarkedCodeForContext(native_context, reason);
     context = native_context->next_context_link();
   }
 }
 
 
-void Deoptimizer::DeoptimizeMarkedCode(Isolate* isolate) {
+void Deoptimizer::DeoptimizeMarkedCode(Isolate* isolate,
+                                       DeoptimizeReason reason) {
   RuntimeCallTimerScope runtimeTimer(isolate,
                                      &RuntimeCallStats::DeoptimizeCode);
   TimerEventScope<TimerEventDeoptimizeCode> timer(isolate);
@@ -399,7 +409,7 @@ void Deoptimizer::DeoptimizeMarkedCode(Isolate* isolate) {
   Object* context = isolate->heap()->native_contexts_list();
   while (!context->IsUndefined(isolate)) {
     Context* native_context = Context::cast(context);
-    DeoptimizeMarkedCodeForContext(native_context);
+    DeoptimizeMarkedCodeForContext(native_context, reason);
     context = native_context->next_context_link();
   }
 }
@@ -417,7 +427,8 @@ void Deoptimizer::MarkAllCodeForContext(Context* context) {
 }
 
 
-void Deoptimizer::DeoptimizeFunction(JSFunction* function) {
+void Deoptimizer::DeoptimizeFunction(JSFunction* function,
+                                     DeoptimizeReason reason) {
   Isolate* isolate = function->GetIsolate();
   RuntimeCallTimerScope runtimeTimer(isolate,
                                      &RuntimeCallStats::DeoptimizeCode);
@@ -430,7 +441,8 @@ void Deoptimizer::DeoptimizeFunction(JSFunction* function) {
     // refer to that code. The code cannot be shared across native contexts,
     // so we only need to search one.
     code->set_marked_for_deoptimization(true);
-    DeoptimizeMarkedCodeForContext(function->context()->native_context());
+    DeoptimizeMarkedCodeForContext(function->context()->native_context(),
+                                   reason);
   }
 }
 
@@ -529,6 +541,13 @@ Deoptimizer::Deoptimizer(Isolate* isolate, JSFunction* function,
 #endif  // DEBUG
   if (compiled_code_->kind() == Code::OPTIMIZED_FUNCTION) {
     PROFILE(isolate_, CodeDeoptEvent(compiled_code_, from_, fp_to_sp_delta_));
+    // Lazy deopts are counted when their code is invalidated, with the reason
+    // passed to DeoptimizeMarkedCodeForContext.
+    if ((type == EAGER || type == SOFT) &&
+        isolate_->collect_compile_statistics()) {
+      isolate_->GetTurboStatistics()->RecordDeoptimization(
+          GetDeoptInfo(compiled_code_, from_).deopt_reason);
+    }
   }
   unsigned size = ComputeInputFrameSize();
   int parameter_count =
@@ -3977,7 +3996,9 @@ void TranslatedState::StoreMaterializedValuesAndDeopt() {
           frames_[0].kind() == TranslatedFrame::kInterpretedFunction ||
           frames_[0].kind() == TranslatedFrame::kTailCallerFunction);
     Object* const function = frames_[0].front().GetRawValue();
-    Deoptimizer::DeoptimizeFunction(JSFunction::cast(function));
+    // The deoptimization that materialized the objects was counted already.
+    Deoptimizer::DeoptimizeFunction(JSFunction::cast(function),
+                                    DeoptimizeReason::kNoReason);
   }
 }
 
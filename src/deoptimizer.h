@@ -419,16 +419,18 @@ class Deoptimizer : public Malloced {
 
   // Deoptimize the function now. Its current optimized code will never be run
   // again and any activations of the optimized code will get deoptimized when
-  // execution returns.
-  static void DeoptimizeFunction(JSFunction* function);
+  // execution returns. The {reason} is counted in the compile statistics,
+  // unless it is kNoReason.
+  static void DeoptimizeFunction(JSFunction* function,
+                                 DeoptimizeReason reason);
 
   // Deoptimize all code in the given isolate.
-  static void DeoptimizeAll(Isolate* isolate);
+  static void DeoptimizeAll(Isolate* isolate, DeoptimizeReason reason);
 
   // Deoptimizes all optimized code that has been previously marked
   // (via code->set_marked_for_deoptimization) and unlinks all functions that
   // refer to that code.
-  static void DeoptimizeMarkedCode(Isolate* isolate);
+  static void DeoptimizeMarkedCode(Isolate* isolate, DeoptimizeReason reason);
 
   // Visit all the known optimized functions in a given isolate.
   static void VisitAllOptimizedFunctions(
@@ -573,7 +575,8 @@ class Deoptimizer : public Malloced {
       Context* context, OptimizedFunctionVisitor* visitor);
 
   // Deoptimizes all code marked in the given context.
-  static void DeoptimizeMarkedCodeForContext(Context* native_context);
+  static void DeoptimizeMarkedCodeForContext(Context* native_context,
+                                             DeoptimizeReason reason);
 
   // Patch the given code so that it will deoptimize itself.
   static void PatchCodeForDeoptimization(Isolate* isolate, Code* code);
@@ -912,6 +912,8 @@ Handle<Script> Factory::NewScript(Handle<String> source) {
   script->set_eval_from_position(0);
   script->set_shared_function_infos(Smi::FromInt(0));
   script->set_flags(0);
+  script->set_optimization_hints(heap->undefined_value());
+  script->set_skippable_functions(heap->undefined_value());
 
   heap->set_script_list(*WeakFixedArray::Add(script_list(), script));
   return script;
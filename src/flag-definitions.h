@@ -418,11 +418,20 @@ DEFINE_BOOL(trace_concurrent_recompilation, false,
             "track concurrent recompilation")
 DEFINE_INT(concurrent_recompilation_queue_length, 8,
            "the length of the concurrent compilation queue")
+DEFINE_INT(concurrent_recompilation_tasks, 0,
+           "number of background tasks that optimize queued functions in "
+           "parallel (0 = half of the available background threads)")
 DEFINE_INT(concurrent_recompilation_delay, 0,
            "artificial compilation delay in ms")
 DEFINE_BOOL(block_concurrent_recompilation, false,
             "block queued jobs until released")
 
+DEFINE_BOOL(compiler_dispatcher, false,
+            "parse and compile lazy functions to bytecode on background "
+            "threads and in idle time (requires --ignition)")
+DEFINE_BOOL(trace_compiler_dispatcher, false,
+            "trace compiler dispatcher activity")
+
 DEFINE_BOOL(omit_map_checks_for_leaf_maps, true,
             "do not emit check maps for constant values that have a leaf map, "
             "deoptimize the optimized code if the layout of the maps changes.")
@@ -469,6 +478,10 @@ DEFINE_BOOL(native_context_specialization, true,
             "enable native context specialization in TurboFan")
 DEFINE_BOOL(turbo_inlining, true, "enable inlining in TurboFan")
 DEFINE_BOOL(trace_turbo_inlining, false, "trace TurboFan inlining")
+DEFINE_BOOL(polymorphic_inlining, true, "polymorphic inlining in TurboFan")
+DEFINE_FLOAT(min_inlining_frequency, 0.01,
+             "minimum call frequency, relative to the hottest call site, "
+             "for inlining in TurboFan")
 DEFINE_BOOL(turbo_load_elimination, true, "enable load elimination in TurboFan")
 DEFINE_BOOL(trace_turbo_load_elimination, false,
             "trace TurboFan load elimination")
@@ -482,6 +495,10 @@ DEFINE_BOOL(turbo_stress_loop_peeling, false,
             "stress loop peeling optimization")
 DEFINE_BOOL(turbo_loop_peeling, false, "Turbofan loop peeling")
 DEFINE_BOOL(turbo_loop_variable, true, "Turbofan loop variable optimization")
+DEFINE_BOOL(turbo_bounds_check_elimination, true,
+            "Turbofan bounds check elimination for counted loops")
+DEFINE_BOOL(turbo_gvn, false,
+            "Turbofan global value numbering after effect linearization")
 DEFINE_BOOL(turbo_cf_optimization, true, "optimize control flow in TurboFan")
 DEFINE_BOOL(turbo_frame_elision, true, "elide frames in TurboFan")
 DEFINE_BOOL(turbo_cache_shared_code, true, "cache context-independent code")
@@ -638,6 +655,9 @@ DEFINE_BOOL(trace_stub_failures, false,
 
 DEFINE_BOOL(serialize_toplevel, true, "enable caching of toplevel scripts")
 DEFINE_BOOL(serialize_eager, false, "compile eagerly when caching scripts")
+DEFINE_BOOL(serialize_optimization_hints, false,
+            "record optimized functions in the code cache and optimize them "
+            "early after deserialization")
 DEFINE_BOOL(serialize_age_code, false, "pre age code in the code cache")
 DEFINE_BOOL(trace_serializer, false, "print code serializer trace")
 
@@ -735,6 +755,9 @@ DEFINE_BOOL(weak_embedded_maps_in_optimized_code, true,
 DEFINE_BOOL(weak_embedded_objects_in_optimized_code, true,
             "make objects embedded in optimized code weak")
 DEFINE_BOOL(flush_code, true, "flush code that we expect not to use again")
+DEFINE_BOOL(flush_bytecode, true,
+            "flush bytecode that we expect not to use again (requires "
+            "flush_code and age_code)")
 DEFINE_BOOL(trace_code_flushing, false, "trace code flushing progress")
 DEFINE_BOOL(age_code, true,
             "track un-executed functions to age code and flush only "
@@ -749,9 +772,35 @@ DEFINE_INT(max_incremental_marking_finalization_rounds, 3,
            "at most try this many times to finalize incremental marking")
 DEFINE_BOOL(black_allocation, false, "use black allocation")
 DEFINE_BOOL(concurrent_sweeping, true, "use concurrent sweeping")
+DEFINE_BOOL(concurrent_store_buffer, true,
+            "move store buffer entries to the remembered set on a background "
+            "thread")
+DEFINE_BOOL(concurrent_array_buffer_freeing, true,
+            "free backing stores of dead array buffers on a background thread")
 DEFINE_BOOL(parallel_compaction, true, "use parallel compaction")
 DEFINE_BOOL(parallel_pointer_update, true,
             "use parallel pointer update during compaction")
+DEFINE_BOOL(parallel_marking, false,
+            "use parallel marking in the atomic pause of full GCs")
+DEFINE_INT(parallel_marking_tasks, 0,
+           "number of parallel marking tasks including the main thread "
+           "(0 means one per available core)")
+DEFINE_BOOL(trace_parallel_marking, false, "trace parallel marking")
+DEFINE_BOOL(concurrent_marking, false,
+            "use concurrent marking on background threads during incremental "
+            "marking")
+DEFINE_INT(concurrent_marking_tasks, 0,
+           "number of concurrent marking tasks "
+           "(0 means half of the available cores)")
+DEFINE_BOOL(trace_concurrent_marking, false, "trace concurrent marking")
+DEFINE_BOOL(parallel_scavenge, false, "use parallel scavenging")
+DEFINE_INT(parallel_scavenge_tasks, 0,
+           "number of parallel scavenging tasks including the main thread "
+           "(0 means one per available core)")
+DEFINE_BOOL(trace_parallel_scavenge, false, "trace parallel scavenging")
+DEFINE_BOOL(minor_mc, false,
+            "perform young generation GCs with a mark-compact collector "
+            "instead of the scavenger")
 DEFINE_BOOL(trace_incremental_marking, false,
             "trace progress of the incremental marking")
 DEFINE_BOOL(track_gc_object_stats, false,
@@ -770,6 +819,15 @@ DEFINE_BOOL(verify_heap, false, "verify heap pointers before and after GC")
 #endif
 DEFINE_BOOL(move_object_start, true, "enable moving of object starts")
 DEFINE_BOOL(memory_reducer, true, "use memory reducer")
+DEFINE_INT(zone_segment_pool_size, 8192,
+           "maximum size of unused zone memory kept for reuse (in kBytes)")
+DEFINE_BOOL(medium_object_pages, true,
+            "allocate arrays and strings of 128KB and more in old space, and "
+            "objects that fit on a regular page on old space pages instead "
+            "of giving each of them a large object page")
+DEFINE_BOOL(transparent_huge_pages, false,
+            "group regular pages into huge page aligned regions and advise "
+            "the OS to back them with transparent huge pages (Linux only)")
 DEFINE_BOOL(scavenge_reclaim_unmodified_objects, true,
             "remove unmodified and unreferenced objects")
 DEFINE_INT(heap_growing_percent, 0,
@@ -839,6 +897,9 @@ DEFINE_BOOL(trace_maps, false, "trace map creation")
 // parser.cc
 DEFINE_BOOL(allow_natives_syntax, false, "allow natives syntax")
 DEFINE_BOOL(trace_parse, false, "trace parsing and preparsing")
+DEFINE_BOOL(lazy_inner_functions, false,
+            "record the scope data of inner functions on the script, and skip "
+            "such functions when lazily parsing their enclosing function")
 
 // simulator-arm.cc, simulator-arm64.cc and simulator-mips.cc
 DEFINE_BOOL(trace_sim, false, "Trace simulator execution")
@@ -912,8 +973,14 @@ DEFINE_BOOL(profile_hydrogen_code_stub_compilation, false,
 
 DEFINE_BOOL(predictable, false, "enable predictable mode")
 DEFINE_NEG_IMPLICATION(predictable, concurrent_recompilation)
+DEFINE_NEG_IMPLICATION(predictable, compiler_dispatcher)
 DEFINE_NEG_IMPLICATION(predictable, concurrent_sweeping)
+DEFINE_NEG_IMPLICATION(predictable, concurrent_store_buffer)
+DEFINE_NEG_IMPLICATION(predictable, concurrent_array_buffer_freeing)
 DEFINE_NEG_IMPLICATION(predictable, parallel_compaction)
+DEFINE_NEG_IMPLICATION(predictable, parallel_marking)
+DEFINE_NEG_IMPLICATION(predictable, concurrent_marking)
+DEFINE_NEG_IMPLICATION(predictable, parallel_scavenge)
 DEFINE_NEG_IMPLICATION(predictable, memory_reducer)
 
 // mark-compact.cc
@@ -0,0 +1,131 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/heap/array-buffer-collector.h"
+
+#include "src/cancelable-task.h"
+#include "src/heap/heap.h"
+#include "src/isolate.h"
+#include "src/v8.h"
+
+namespace v8 {
+namespace internal {
+
+class ArrayBufferCollector::FreeingTask : public CancelableTask {
+ public:
+  FreeingTask(Isolate* isolate, ArrayBufferCollector* collector,
+              base::Semaphore* on_finish)
+      : CancelableTask(isolate), collector_(collector), on_finish_(on_finish) {}
+
+  virtual ~FreeingTask() {}
+
+ private:
+  // v8::internal::CancelableTask overrides.
+  void RunInternal() override {
+    collector_->FreeAllocations();
+    on_finish_->Signal();
+  }
+
+  ArrayBufferCollector* collector_;
+  base::Semaphore* on_finish_;
+
+  DISALLOW_COPY_AND_ASSIGN(FreeingTask);
+};
+
+ArrayBufferCollector::ArrayBufferCollector(Heap* heap)
+    : heap_(heap),
+      pending_bytes_(0),
+      task_running_(false),
+      task_pending_(false),
+      task_id_(0),
+      pending_task_semaphore_(0) {}
+
+void ArrayBufferCollector::AddGarbageAllocations(
+    std::vector<Allocation>* allocations) {
+  if (allocations->empty()) return;
+  base::LockGuard<base::Mutex> guard(&allocations_mutex_);
+  for (const Allocation& allocation : *allocations) {
+    allocations_.push_back(allocation);
+    pending_bytes_ += allocation.length;
+  }
+  allocations->clear();
+}
+
+void ArrayBufferCollector::FreeAllocationsOnBackgroundThread() {
+  if (!FLAG_concurrent_array_buffer_freeing) {
+    FreeAllocations();
+    return;
+  }
+  base::LockGuard<base::Mutex> guard(&allocations_mutex_);
+  // A running task frees everything that is added before it finishes.
+  if (allocations_.empty() || task_running_) return;
+  if (task_pending_) {
+    // The previous task is done and has signaled or is about to signal.
+    pending_task_semaphore_.Wait();
+  }
+  task_running_ = true;
+  task_pending_ = true;
+  FreeingTask* task =
+      new FreeingTask(heap_->isolate(), this, &pending_task_semaphore_);
+  task_id_ = task->id();
+  V8::GetCurrentPlatform()->CallOnBackgroundThread(
+      task, v8::Platform::kShortRunningTask);
+}
+
+void ArrayBufferCollector::FreeAllocationsOnSweeperTask() {
+  if (!FLAG_concurrent_array_buffer_freeing) return;
+  {
+    base::LockGuard<base::Mutex> guard(&allocations_mutex_);
+    // A running task frees everything that is added before it finishes.
+    if (allocations_.empty() || task_running_) return;
+    task_running_ = true;
+  }
+  FreeAllocations();
+}
+
+void ArrayBufferCollector::TearDown() {
+  // The heap is torn down before the cancelable tasks of the isolate are
+  // cancelled, so the task has to be stopped here.
+  if (task_pending_) {
+    if (!heap_->isolate()->cancelable_task_manager()->TryAbort(task_id_)) {
+      pending_task_semaphore_.Wait();
+    }
+    task_pending_ = false;
+  }
+  FreeAllocations();
+}
+
+size_t ArrayBufferCollector::pending_bytes() {
+  base::LockGuard<base::Mutex> guard(&allocations_mutex_);
+  return pending_bytes_;
+}
+
+void ArrayBufferCollector::FreeAllocations() {
+  v8::ArrayBuffer::Allocator* allocator =
+      heap_->isolate()->array_buffer_allocator();
+  std::vector<Allocation> allocations;
+  size_t freed_memory = 0;
+  while (true) {
+    {
+      base::LockGuard<base::Mutex> guard(&allocations_mutex_);
+      pending_bytes_ -= freed_memory;
+      if (allocations_.empty()) {
+        task_running_ = false;
+        return;
+      }
+      allocations.swap(allocations_);
+    }
+    freed_memory = 0;
+    for (const Allocation& allocation : allocations) {
+      allocator->Free(allocation.data, allocation.length);
+      freed_memory += allocation.length;
+    }
+    allocations.clear();
+    heap_->update_external_memory_concurrently_freed(
+        static_cast<intptr_t>(freed_memory));
+  }
+}
+
+}  // namespace internal
+}  // namespace v8
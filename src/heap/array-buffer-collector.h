@@ -0,0 +1,85 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_HEAP_ARRAY_BUFFER_COLLECTOR_H_
+#define V8_HEAP_ARRAY_BUFFER_COLLECTOR_H_
+
+#include <vector>
+
+#include "src/allocation.h"
+#include "src/base/platform/mutex.h"
+#include "src/base/platform/semaphore.h"
+
+namespace v8 {
+namespace internal {
+
+class Heap;
+
+// Releases the backing stores of dead JSArrayBuffers on a background thread,
+// similar to MemoryAllocator::Unmapper.
+//
+// Array buffer trackers hand dead backing stores to the collector during GC
+// and sweeping. The main thread schedules a cancelable task that passes them
+// to the embedder's ArrayBuffer::Allocator::Free, and concurrent sweeper tasks
+// free the ones they released before they finish. Freed bytes are reported via
+// Heap::update_external_memory_concurrently_freed only after they were
+// actually freed, so pending backing stores still count as external memory.
+class ArrayBufferCollector {
+ public:
+  struct Allocation {
+    Allocation(void* data, size_t length) : data(data), length(length) {}
+    void* data;
+    size_t length;
+  };
+
+  explicit ArrayBufferCollector(Heap* heap);
+
+  // Takes over the allocations in |allocations| and clears the vector. Can be
+  // called from any thread.
+  void AddGarbageAllocations(std::vector<Allocation>* allocations);
+
+  // Frees all pending allocations on a background task, or on the calling
+  // thread if --concurrent_array_buffer_freeing is off. Main thread only.
+  void FreeAllocationsOnBackgroundThread();
+
+  // Frees all pending allocations on the calling thread unless they are being
+  // freed already. Called by sweeper tasks when they finish, so that backing
+  // stores released by concurrent sweeping don't wait for the main thread.
+  void FreeAllocationsOnSweeperTask();
+
+  // Stops the task and frees all pending allocations on the calling thread.
+  void TearDown();
+
+  size_t pending_bytes();
+
+ private:
+  class FreeingTask;
+
+  // Frees allocations until no more are pending.
+  void FreeAllocations();
+
+  Heap* heap_;
+
+  base::Mutex allocations_mutex_;
+  std::vector<Allocation> allocations_;
+  size_t pending_bytes_;
+  // Set while the task or a sweeper task frees allocations. Cleared by that
+  // thread, under |allocations_mutex_|, once it observed that no allocations
+  // are pending.
+  bool task_running_;
+
+  // Main thread only.
+  bool task_pending_;
+  uint32_t task_id_;
+
+  // Semaphore that outlives the task. See PageParallelJob.
+  base::Semaphore pending_task_semaphore_;
+
+  DISALLOW_COPY_AND_ASSIGN(ArrayBufferCollector);
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_HEAP_ARRAY_BUFFER_COLLECTOR_H_
@@ -3,6 +3,7 @@
 // found in the LICENSE file.
 
 #include "src/heap/array-buffer-tracker.h"
+#include "src/heap/array-buffer-collector.h"
 #include "src/heap/array-buffer-tracker-inl.h"
 #include "src/heap/heap.h"
 
@@ -15,31 +16,26 @@ LocalArrayBufferTracker::~LocalArrayBufferTracker() {
 
 template <LocalArrayBufferTracker::FreeMode free_mode>
 void LocalArrayBufferTracker::Free() {
-  size_t freed_memory = 0;
+  std::vector<ArrayBufferCollector::Allocation> garbage;
   for (TrackingData::iterator it = array_buffers_.begin();
        it != array_buffers_.end();) {
     JSArrayBuffer* buffer = reinterpret_cast<JSArrayBuffer*>(it->first);
     if ((free_mode == kFreeAll) ||
         Marking::IsWhite(ObjectMarking::MarkBitFrom(buffer))) {
-      const size_t len = it->second;
-      heap_->isolate()->array_buffer_allocator()->Free(buffer->backing_store(),
-                                                       len);
-      freed_memory += len;
+      garbage.push_back(ArrayBufferCollector::Allocation(
+          buffer->backing_store(), it->second));
       it = array_buffers_.erase(it);
     } else {
       ++it;
     }
   }
-  if (freed_memory > 0) {
-    heap_->update_external_memory_concurrently_freed(
-        static_cast<intptr_t>(freed_memory));
-  }
+  heap_->array_buffer_collector()->AddGarbageAllocations(&garbage);
 }
 
 template <typename Callback>
 void LocalArrayBufferTracker::Process(Callback callback) {
   JSArrayBuffer* new_buffer = nullptr;
-  size_t freed_memory = 0;
+  std::vector<ArrayBufferCollector::Allocation> garbage;
   for (TrackingData::iterator it = array_buffers_.begin();
        it != array_buffers_.end();) {
     const CallbackResult result = callback(it->first, &new_buffer);
@@ -61,19 +57,14 @@ void LocalArrayBufferTracker::Process(Callback callback) {
       if (target_page->InNewSpace()) target_page->mutex()->Unlock();
       it = array_buffers_.erase(it);
     } else if (result == kRemoveEntry) {
-      const size_t len = it->second;
-      heap_->isolate()->array_buffer_allocator()->Free(
-          it->first->backing_store(), len);
-      freed_memory += len;
+      garbage.push_back(ArrayBufferCollector::Allocation(
+          it->first->backing_store(), it->second));
       it = array_buffers_.erase(it);
     } else {
       UNREACHABLE();
     }
   }
-  if (freed_memory > 0) {
-    heap_->update_external_memory_concurrently_freed(
-        static_cast<intptr_t>(freed_memory));
-  }
+  heap_->array_buffer_collector()->AddGarbageAllocations(&garbage);
 }
 
 void ArrayBufferTracker::FreeDeadInNewSpace(Heap* heap) {
@@ -0,0 +1,390 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/heap/concurrent-marking.h"
+
+#include "src/base/atomicops.h"
+#include "src/cancelable-task.h"
+#include "src/heap/gc-tracer.h"
+#include "src/heap/heap-inl.h"
+#include "src/heap/heap.h"
+#include "src/heap/mark-compact-inl.h"
+#include "src/heap/mark-compact.h"
+#include "src/heap/objects-visiting.h"
+#include "src/heap/remembered-set.h"
+#include "src/heap/spaces-inl.h"
+#include "src/isolate.h"
+#include "src/v8.h"
+
+namespace v8 {
+namespace internal {
+
+// Marks the fields of objects that ConcurrentMarking::CanVisit accepts. Fields
+// are read without synchronization with the main thread; the snapshot
+// protocol guarantees that every store that matters is visible.
+class ConcurrentMarking::Visitor : public ObjectVisitor {
+ public:
+  Visitor(MarkingWorklist* shared, MarkingWorklist* bailout, int task_id,
+          TaskState* state)
+      : shared_(shared, task_id),
+        bailout_(bailout, task_id),
+        state_(state),
+        host_(nullptr) {}
+
+  void VisitPointers(Object** start, Object** end) override {
+    for (Object** p = start; p < end; p++) {
+      Object* object = reinterpret_cast<Object*>(
+          base::NoBarrier_Load(reinterpret_cast<base::AtomicWord*>(p)));
+      if (!object->IsHeapObject()) continue;
+      HeapObject* target = HeapObject::cast(object);
+      RecordSlot(p, target);
+      MarkObject(target);
+    }
+  }
+
+  void VisitObject(HeapObject* object, Map* map, int size) {
+    MarkObject(map);
+    host_ = object;
+    object->IterateBody(map->instance_type(), size, this);
+    host_ = nullptr;
+    state_->visited_objects++;
+  }
+
+  bool Pop(HeapObject** object) { return shared_.Pop(object); }
+
+  void Bailout(HeapObject* object) { bailout_.Push(object); }
+
+  void Flush() {
+    shared_.FlushToGlobal();
+    bailout_.FlushToGlobal();
+  }
+
+ private:
+  // Turns the object grey. The task that wins the transition owns the object
+  // and decides whether it is scanned here or on the main thread.
+  void MarkObject(HeapObject* object) {
+    MarkBit mark_bit = ObjectMarking::MarkBitFrom(object);
+    if (!Marking::TryWhiteToGrey<MarkBit::ATOMIC>(mark_bit)) return;
+    if (CanVisit(object, object->map())) {
+      shared_.Push(object);
+    } else {
+      bailout_.Push(object);
+    }
+  }
+
+  void RecordSlot(Object** slot, HeapObject* target) {
+    DCHECK_NOT_NULL(host_);
+    Page* target_page = Page::FromAddress(target->address());
+    if (target_page->IsEvacuationCandidate() &&
+        !MarkCompactCollector::ShouldSkipEvacuationSlotRecording(host_)) {
+      state_->recorded_slots.push_back(
+          std::make_pair(host_, reinterpret_cast<Address>(slot)));
+    }
+  }
+
+  MarkingWorklist::View shared_;
+  MarkingWorklist::View bailout_;
+  TaskState* state_;
+  HeapObject* host_;
+};
+
+class ConcurrentMarking::Task : public CancelableTask {
+ public:
+  Task(Isolate* isolate, ConcurrentMarking* marking, int task_id,
+       base::Semaphore* on_finish)
+      : CancelableTask(isolate),
+        marking_(marking),
+        task_id_(task_id),
+        on_finish_(on_finish) {}
+
+  virtual ~Task() {}
+
+ private:
+  // v8::internal::CancelableTask overrides.
+  void RunInternal() override {
+    marking_->Run(task_id_, &marking_->task_state_[task_id_]);
+    marking_->task_running_[task_id_].SetValue(false);
+    on_finish_->Signal();
+  }
+
+  ConcurrentMarking* marking_;
+  int task_id_;
+  base::Semaphore* on_finish_;
+
+  DISALLOW_COPY_AND_ASSIGN(Task);
+};
+
+ConcurrentMarking::ConcurrentMarking(Heap* heap)
+    : heap_(heap),
+      pause_requested_(false),
+      epoch_(0),
+      pending_task_semaphore_(0) {
+  for (int i = 0; i < kMaxTasks; i++) {
+    task_pending_[i] = false;
+    task_id_[i] = 0;
+    task_running_[i].SetValue(false);
+  }
+}
+
+bool ConcurrentMarking::IsSupported() {
+#if V8_HOST_ARCH_X64 || V8_HOST_ARCH_IA32
+  return true;
+#else
+  return false;
+#endif
+}
+
+bool ConcurrentMarking::CanVisit(HeapObject* object, Map* map) {
+  switch (static_cast<StaticVisitorBase::VisitorId>(map->visitor_id())) {
+    case StaticVisitorBase::kVisitFixedArray:
+    case StaticVisitorBase::kVisitFixedDoubleArray:
+    case StaticVisitorBase::kVisitByteArray:
+    case StaticVisitorBase::kVisitFixedTypedArray:
+    case StaticVisitorBase::kVisitFixedFloat64Array:
+    case StaticVisitorBase::kVisitDataObject2:
+    case StaticVisitorBase::kVisitDataObject3:
+    case StaticVisitorBase::kVisitDataObject4:
+    case StaticVisitorBase::kVisitDataObject5:
+    case StaticVisitorBase::kVisitDataObject6:
+    case StaticVisitorBase::kVisitDataObject7:
+    case StaticVisitorBase::kVisitDataObject8:
+    case StaticVisitorBase::kVisitDataObject9:
+    case StaticVisitorBase::kVisitDataObjectGeneric:
+    case StaticVisitorBase::kVisitStruct2:
+    case StaticVisitorBase::kVisitStruct3:
+    case StaticVisitorBase::kVisitStruct4:
+    case StaticVisitorBase::kVisitStruct5:
+    case StaticVisitorBase::kVisitStruct6:
+    case StaticVisitorBase::kVisitStruct7:
+    case StaticVisitorBase::kVisitStruct8:
+    case StaticVisitorBase::kVisitStruct9:
+    case StaticVisitorBase::kVisitStructGeneric:
+    case StaticVisitorBase::kVisitCell:
+    case StaticVisitorBase::kVisitOddball:
+    case StaticVisitorBase::kVisitSymbol:
+      break;
+    default:
+      return false;
+  }
+  // Large arrays are scanned incrementally using the progress bar, which is
+  // main thread state.
+  MemoryChunk* chunk = MemoryChunk::FromAddress(object->address());
+  return !chunk->IsFlagSet(MemoryChunk::HAS_PROGRESS_BAR) &&
+         !(chunk->owner() != nullptr &&
+           chunk->owner()->identity() == LO_SPACE);
+}
+
+void ConcurrentMarking::NotifyMainThreadStep() {
+  base::LockGuard<base::Mutex> guard(&epoch_mutex_);
+  epoch_++;
+}
+
+intptr_t ConcurrentMarking::CurrentEpoch() {
+  base::LockGuard<base::Mutex> guard(&epoch_mutex_);
+  return epoch_;
+}
+
+int ConcurrentMarking::NumberOfTasks() {
+  // Task 0 is the main thread, which only donates work.
+  const int available_cores = static_cast<int>(
+      V8::GetCurrentPlatform()->NumberOfAvailableBackgroundThreads());
+  if (available_cores == 0) return 0;
+  const int wanted = FLAG_concurrent_marking_tasks > 0
+                         ? FLAG_concurrent_marking_tasks
+                         : Max(1, available_cores / 2);
+  return Min(wanted, kMaxTasks - 1);
+}
+
+void ConcurrentMarking::TransferWork(MarkingDeque* marking_deque) {
+  MarkingWorklist::View shared(&shared_, kMainThreadTask);
+  MarkingWorklist::View bailout(&bailout_, kMainThreadTask);
+
+  if (NumberOfTasks() > 0) {
+    // Compact the deque in place, keeping everything that has to be visited
+    // on the main thread.
+    int current = marking_deque->bottom();
+    int mask = marking_deque->mask();
+    int limit = marking_deque->top();
+    HeapObject** array = marking_deque->array();
+    int new_top = current;
+    while (current != limit) {
+      HeapObject* obj = array[current];
+      current = ((current + 1) & mask);
+      MarkBit mark_bit = ObjectMarking::MarkBitFrom(obj);
+      if (!obj->IsFiller() && Marking::IsGrey<MarkBit::ATOMIC>(mark_bit) &&
+          CanVisit(obj, obj->map())) {
+        shared.Push(obj);
+      } else {
+        array[new_top] = obj;
+        new_top = ((new_top + 1) & mask);
+      }
+    }
+    marking_deque->set_top(new_top);
+    shared.FlushToGlobal();
+  }
+
+  HeapObject* object = nullptr;
+  while (bailout.Pop(&object)) {
+    marking_deque->Push(object);
+  }
+}
+
+void ConcurrentMarking::ScheduleTasks() {
+  const int num_tasks = NumberOfTasks();
+  for (int i = 1; i <= num_tasks; i++) {
+    if (task_pending_[i]) {
+      if (task_running_[i].Value()) continue;
+      // The task is done and has signaled or is about to signal.
+      pending_task_semaphore_.Wait();
+      task_pending_[i] = false;
+    }
+    if (task_state_[i].batch.empty() && shared_.IsGlobalPoolEmpty()) continue;
+    task_running_[i].SetValue(true);
+    task_pending_[i] = true;
+    Task* task = new Task(heap_->isolate(), this, i, &pending_task_semaphore_);
+    task_id_[i] = task->id();
+    V8::GetCurrentPlatform()->CallOnBackgroundThread(
+        task, v8::Platform::kShortRunningTask);
+  }
+}
+
+void ConcurrentMarking::Run(int task_id, TaskState* state) {
+  double start = heap_->MonotonicallyIncreasingTimeInMs();
+  Visitor visitor(&shared_, &bailout_, task_id, state);
+  while (!pause_requested_.Value()) {
+    if (state->batch.empty()) {
+      // Turn a batch of objects black. Right trimming cannot change the size
+      // of an object between reading it and accounting it as live.
+      base::LockGuard<base::Mutex> guard(&layout_mutex_);
+      HeapObject* object = nullptr;
+      while (static_cast<int>(state->batch.size()) < kBatchSize &&
+             visitor.Pop(&object)) {
+        if (object->IsFiller()) continue;
+        Map* map = object->map();
+        if (!CanVisit(object, map)) {
+          visitor.Bailout(object);
+          continue;
+        }
+        MarkBit mark_bit = ObjectMarking::MarkBitFrom(object);
+        if (!Marking::TryGreyToBlack<MarkBit::ATOMIC>(mark_bit)) continue;
+        intptr_t size = object->SizeFromMap(map);
+        state->live_bytes[MemoryChunk::FromAddress(object->address())] += size;
+        state->marked_bytes += size;
+        state->batch.push_back(object);
+      }
+      if (state->batch.empty()) break;
+      state->batch_epoch = CurrentEpoch();
+    }
+
+    // Fields may only be read once the main thread has passed a step. Stores
+    // into the now black objects after that point are covered by the write
+    // barrier. Until then the task gives up its thread, and the next step
+    // posts it again.
+    if (CurrentEpoch() == state->batch_epoch) break;
+
+    for (HeapObject* object : state->batch) {
+      base::LockGuard<base::Mutex> guard(&layout_mutex_);
+      Map* map = object->map();
+      visitor.VisitObject(object, map, object->SizeFromMap(map));
+    }
+    state->batch.clear();
+  }
+  visitor.Flush();
+  state->duration_ms += heap_->MonotonicallyIncreasingTimeInMs() - start;
+}
+
+void ConcurrentMarking::FinalizeTaskState(TaskState* state) {
+  for (auto& pair : state->live_bytes) {
+    pair.first->IncrementLiveBytes(static_cast<int>(pair.second));
+  }
+  for (auto& pair : state->recorded_slots) {
+    HeapObject* host = pair.first;
+    Address slot = pair.second;
+    // The slot may have been trimmed off the host after it was recorded.
+    if (slot >= host->address() + host->Size()) continue;
+    RememberedSet<OLD_TO_OLD>::Insert(Page::FromAddress(host->address()),
+                                      slot);
+  }
+  state->live_bytes.clear();
+  state->recorded_slots.clear();
+  state->marked_bytes = 0;
+  state->visited_objects = 0;
+  state->duration_ms = 0;
+}
+
+void ConcurrentMarking::Stop(MarkingDeque* marking_deque) {
+  pause_requested_.SetValue(true);
+  for (int i = 1; i < kMaxTasks; i++) {
+    if (!task_pending_[i]) continue;
+    if (heap_->isolate()->cancelable_task_manager()->TryAbort(task_id_[i])) {
+      task_running_[i].SetValue(false);
+    } else {
+      pending_task_semaphore_.Wait();
+    }
+    task_pending_[i] = false;
+  }
+  pause_requested_.SetValue(false);
+
+  // The main thread sees its own stores, so the batches that tasks left
+  // behind can be scanned right away.
+  {
+    Visitor visitor(&shared_, &bailout_, kMainThreadTask,
+                    &task_state_[kMainThreadTask]);
+    for (int i = 1; i < kMaxTasks; i++) {
+      for (HeapObject* object : task_state_[i].batch) {
+        Map* map = object->map();
+        visitor.VisitObject(object, map, object->SizeFromMap(map));
+      }
+      task_state_[i].batch.clear();
+    }
+    visitor.Flush();
+  }
+
+  intptr_t marked_bytes = 0;
+  double duration = 0;
+  for (int i = 1; i < kMaxTasks; i++) {
+    marked_bytes += task_state_[i].marked_bytes;
+    duration += task_state_[i].duration_ms;
+  }
+  if (marked_bytes > 0 || duration > 0) {
+    heap_->tracer()->AddConcurrentMarkingStep(duration, marked_bytes);
+    if (FLAG_trace_concurrent_marking) {
+      PrintIsolate(heap_->isolate(), "concurrent-marking:");
+      for (int i = 1; i < kMaxTasks; i++) {
+        if (task_state_[i].visited_objects == 0) continue;
+        PrintF(" task%d=(objects=%d bytes=%" V8PRIdPTR " time=%.1fms)", i,
+               task_state_[i].visited_objects, task_state_[i].marked_bytes,
+               task_state_[i].duration_ms);
+      }
+      PrintF("\n");
+    }
+  }
+  for (int i = 0; i < kMaxTasks; i++) {
+    FinalizeTaskState(&task_state_[i]);
+  }
+
+  HeapObject* object = nullptr;
+  while (shared_.Pop(kMainThreadTask, &object)) {
+    marking_deque->Push(object);
+  }
+  while (bailout_.Pop(kMainThreadTask, &object)) {
+    marking_deque->Push(object);
+  }
+  DCHECK(shared_.IsGlobalEmpty());
+  DCHECK(bailout_.IsGlobalEmpty());
+}
+
+bool ConcurrentMarking::IsIdle() {
+  for (int i = 1; i < kMaxTasks; i++) {
+    if (task_running_[i].Value() || !task_state_[i].batch.empty()) {
+      return false;
+    }
+  }
+  return shared_.IsGlobalPoolEmpty() && bailout_.IsGlobalPoolEmpty() &&
+         shared_.IsLocalEmpty(kMainThreadTask) &&
+         bailout_.IsLocalEmpty(kMainThreadTask);
+}
+
+}  // namespace internal
+}  // namespace v8
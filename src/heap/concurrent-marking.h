@@ -0,0 +1,167 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_HEAP_CONCURRENT_MARKING_H_
+#define V8_HEAP_CONCURRENT_MARKING_H_
+
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "src/allocation.h"
+#include "src/base/atomic-utils.h"
+#include "src/base/platform/mutex.h"
+#include "src/base/platform/semaphore.h"
+#include "src/heap/worklist.h"
+#include "src/utils.h"
+
+namespace v8 {
+namespace internal {
+
+class Heap;
+class HeapObject;
+class Map;
+class MarkingDeque;
+class MemoryChunk;
+
+// Marks objects on background threads while incremental marking is active
+// and JavaScript keeps running on the main thread.
+//
+// The main thread donates grey objects from the marking deque to a shared
+// work-stealing worklist. Background tasks only visit objects whose layout
+// cannot change under them in a way that matters to the marker: fixed arrays,
+// structs, cells, oddballs, symbols and objects without pointer fields. Every
+// other object that a task discovers is turned grey and handed back to the
+// main thread through the bailout worklist.
+//
+// Snapshot protocol: a task first turns a batch of grey objects black and only
+// reads their fields after the main thread has passed a step (see
+// NotifyMainThreadStep). Instead of blocking until then, the task keeps the
+// batch and exits, and the next incremental step posts it again. The regular
+// incremental write barrier greys values written into black objects. Any store
+// that the barrier missed because it observed the object before it turned black
+// was issued before the step that the task needs and is therefore visible to
+// the task.
+//
+// Right trimming is serialized with the part of the protocol that reads the
+// size of an object (see LayoutChangeScope). Left trimming is disabled while
+// concurrent marking is active.
+class ConcurrentMarking {
+ public:
+  typedef Worklist<HeapObject*, 64> MarkingWorklist;
+
+  static const int kMainThreadTask = 0;
+  static const int kMaxTasks = MarkingWorklist::kMaxNumTasks;
+
+  // Serializes object layout changes on the main thread with background
+  // tasks that read object sizes. Tolerates a null |concurrent_marking|.
+  class LayoutChangeScope {
+   public:
+    explicit LayoutChangeScope(ConcurrentMarking* concurrent_marking)
+        : concurrent_marking_(concurrent_marking) {
+      if (concurrent_marking_ != nullptr) {
+        concurrent_marking_->layout_mutex_.Lock();
+      }
+    }
+    ~LayoutChangeScope() {
+      if (concurrent_marking_ != nullptr) {
+        concurrent_marking_->layout_mutex_.Unlock();
+      }
+    }
+
+   private:
+    ConcurrentMarking* concurrent_marking_;
+    DISALLOW_COPY_AND_ASSIGN(LayoutChangeScope);
+  };
+
+  explicit ConcurrentMarking(Heap* heap);
+
+  // Background tasks read fields of objects that the main thread publishes
+  // with plain stores. This is only sound on hosts with total store order.
+  static bool IsSupported();
+
+  // Returns true if background tasks may visit |object|.
+  static bool CanVisit(HeapObject* object, Map* map);
+
+  // Must be called regularly by the main thread while marking is active.
+  // Background tasks only scan a batch of objects after the main thread has
+  // passed a step that started after the objects were turned black.
+  void NotifyMainThreadStep();
+
+  // Moves grey objects that can be visited concurrently from the marking
+  // deque to the shared worklist and objects from the bailout worklist to the
+  // marking deque.
+  void TransferWork(MarkingDeque* marking_deque);
+
+  // Starts background tasks if there is work for them, including tasks that
+  // exited with a batch of objects waiting for a step.
+  void ScheduleTasks();
+
+  // Waits for all background tasks, scans the batches they left, accounts
+  // their work and moves all remaining objects back to the marking deque.
+  void Stop(MarkingDeque* marking_deque);
+
+  // Returns true if no task is running and all worklists are empty.
+  bool IsIdle();
+
+ private:
+  class Task;
+  class Visitor;
+
+  typedef std::unordered_map<MemoryChunk*, intptr_t> LiveBytesMap;
+  typedef std::vector<std::pair<HeapObject*, Address>> SlotList;
+
+  // State that a task accumulates without synchronization and that is merged
+  // on the main thread in Stop().
+  struct TaskState {
+    TaskState()
+        : batch_epoch(0), marked_bytes(0), visited_objects(0), duration_ms(0) {}
+    // Objects that were turned black in |batch_epoch| and are not scanned
+    // yet. Kept across runs of the task.
+    std::vector<HeapObject*> batch;
+    intptr_t batch_epoch;
+    LiveBytesMap live_bytes;
+    SlotList recorded_slots;
+    intptr_t marked_bytes;
+    int visited_objects;
+    double duration_ms;
+  };
+
+  // Number of objects that are turned black and scanned together.
+  static const int kBatchSize = 256;
+
+  int NumberOfTasks();
+  void Run(int task_id, TaskState* state);
+  intptr_t CurrentEpoch();
+  void FinalizeTaskState(TaskState* state);
+
+  Heap* heap_;
+  MarkingWorklist shared_;
+  MarkingWorklist bailout_;
+  TaskState task_state_[kMaxTasks];
+
+  // Main thread only.
+  bool task_pending_[kMaxTasks];
+  uint32_t task_id_[kMaxTasks];
+
+  // Cleared by a task right before it signals |pending_task_semaphore_|.
+  base::AtomicValue<bool> task_running_[kMaxTasks];
+  base::AtomicValue<bool> pause_requested_;
+
+  base::Mutex layout_mutex_;
+
+  base::Mutex epoch_mutex_;
+  intptr_t epoch_;
+
+  // Semaphore that outlives the tasks. See PageParallelJob for why it cannot
+  // be created on demand.
+  base::Semaphore pending_task_semaphore_;
+
+  DISALLOW_COPY_AND_ASSIGN(ConcurrentMarking);
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_HEAP_CONCURRENT_MARKING_H_
@@ -4,6 +4,9 @@
 
 #include "src/heap/gc-tracer.h"
 
+#include <cmath>
+
+#include "src/base/bits.h"
 #include "src/counters.h"
 #include "src/heap/heap-inl.h"
 #include "src/isolate.h"
@@ -77,7 +80,11 @@ GCTracer::Event::Event(Type type, const char* gc_reason,
       incremental_marking_duration(0.0),
       cumulative_pure_incremental_marking_duration(0.0),
       pure_incremental_marking_duration(0.0),
-      longest_incremental_marking_step(0.0) {
+      longest_incremental_marking_step(0.0),
+      cumulative_concurrent_marking_duration(0.0),
+      concurrent_marking_duration(0.0),
+      cumulative_concurrent_marking_bytes(0),
+      concurrent_marking_bytes(0) {
   for (int i = 0; i < Scope::NUMBER_OF_SCOPES; i++) {
     scopes[i] = 0;
   }
@@ -110,6 +117,59 @@ const char* GCTracer::Event::TypeName(bool short_name) const {
 }
 
 
+int PauseHistogram::BucketIndex(uint32_t microseconds) {
+  if (microseconds < kLinearBuckets) return static_cast<int>(microseconds);
+  int msb =
+      31 - static_cast<int>(base::bits::CountLeadingZeros32(microseconds));
+  int shift = msb - kSubBucketBits;
+  int sub_bucket = (microseconds >> shift) & (kSubBuckets - 1);
+  return kLinearBuckets + (msb - (kSubBucketBits + 1)) * kSubBuckets +
+         sub_bucket;
+}
+
+uint64_t PauseHistogram::BucketLimit(int index) {
+  DCHECK(index >= 0 && index < kNumBuckets);
+  if (index < kLinearBuckets) return static_cast<uint64_t>(index) + 1;
+  int offset = index - kLinearBuckets;
+  int msb = offset / kSubBuckets + kSubBucketBits + 1;
+  int sub_bucket = offset % kSubBuckets;
+  return static_cast<uint64_t>(kSubBuckets + sub_bucket + 1)
+         << (msb - kSubBucketBits);
+}
+
+void PauseHistogram::AddSample(double duration_ms) {
+  double microseconds = Max(duration_ms, 0.0) * 1000;
+  uint32_t bucket_value =
+      microseconds >= kMaxUInt32 ? kMaxUInt32
+                                 : static_cast<uint32_t>(microseconds);
+  buckets_[BucketIndex(bucket_value)]++;
+  count_++;
+  total_ms_ += duration_ms;
+  max_ms_ = Max(max_ms_, duration_ms);
+}
+
+double PauseHistogram::Percentile(double percentile) const {
+  if (count_ == 0) return 0;
+  int rank = static_cast<int>(std::ceil(percentile / 100 * count_));
+  rank = Min(Max(rank, 1), count_);
+  int seen = 0;
+  for (int i = 0; i < kNumBuckets; i++) {
+    seen += buckets_[i];
+    if (seen >= rank) {
+      return Min(static_cast<double>(BucketLimit(i)) / 1000, max_ms_);
+    }
+  }
+  UNREACHABLE();
+  return max_ms_;
+}
+
+void PauseHistogram::Reset() {
+  for (int i = 0; i < kNumBuckets; i++) buckets_[i] = 0;
+  count_ = 0;
+  total_ms_ = 0;
+  max_ms_ = 0;
+}
+
 GCTracer::GCTracer(Heap* heap)
     : heap_(heap),
       cumulative_incremental_marking_steps_(0),
@@ -122,6 +182,8 @@ GCTracer::GCTracer(Heap* heap)
       longest_incremental_marking_finalization_step_(0.0),
       cumulative_marking_duration_(0.0),
       cumulative_sweeping_duration_(0.0),
+      cumulative_concurrent_marking_duration_(0.0),
+      cumulative_concurrent_marking_bytes_(0),
       allocation_time_ms_(0.0),
       new_space_allocation_counter_bytes_(0),
       old_generation_allocation_counter_bytes_(0),
@@ -146,6 +208,8 @@ void GCTracer::ResetForTesting() {
   longest_incremental_marking_finalization_step_ = 0.0;
   cumulative_marking_duration_ = 0.0;
   cumulative_sweeping_duration_ = 0.0;
+  cumulative_concurrent_marking_duration_ = 0.0;
+  cumulative_concurrent_marking_bytes_ = 0;
   allocation_time_ms_ = 0.0;
   new_space_allocation_counter_bytes_ = 0.0;
   old_generation_allocation_counter_bytes_ = 0.0;
@@ -154,6 +218,9 @@ void GCTracer::ResetForTesting() {
   old_generation_allocation_in_bytes_since_gc_ = 0.0;
   combined_mark_compact_speed_cache_ = 0.0;
   start_counter_ = 0;
+  scavenge_pauses_.Reset();
+  incremental_marking_pauses_.Reset();
+  mark_compact_pauses_.Reset();
 }
 
 void GCTracer::Start(GarbageCollector collector, const char* gc_reason,
@@ -242,8 +309,19 @@ void GCTracer::Stop(GarbageCollector collector) {
   heap_->isolate()->counters()->aggregated_memory_heap_used()->AddSample(
       current_.end_time, used_memory);
 
+  current_.cumulative_concurrent_marking_duration =
+      cumulative_concurrent_marking_duration_;
+  current_.cumulative_concurrent_marking_bytes =
+      cumulative_concurrent_marking_bytes_;
+
   double duration = current_.end_time - current_.start_time;
   if (current_.type == Event::SCAVENGER) {
+    current_.concurrent_marking_duration =
+        current_.cumulative_concurrent_marking_duration -
+        previous_.cumulative_concurrent_marking_duration;
+    current_.concurrent_marking_bytes =
+        current_.cumulative_concurrent_marking_bytes -
+        previous_.cumulative_concurrent_marking_bytes;
     current_.incremental_marking_steps =
         current_.cumulative_incremental_marking_steps -
         previous_.cumulative_incremental_marking_steps;
@@ -260,7 +338,16 @@ void GCTracer::Stop(GarbageCollector collector) {
         MakeBytesAndDuration(current_.new_space_object_size, duration));
     recorded_scavenges_survived_.Push(MakeBytesAndDuration(
         current_.survived_new_space_object_size, duration));
+    scavenge_pauses_.AddSample(duration);
   } else if (current_.type == Event::INCREMENTAL_MARK_COMPACTOR) {
+    current_.concurrent_marking_duration =
+        current_.cumulative_concurrent_marking_duration -
+        previous_incremental_mark_compactor_event_
+            .cumulative_concurrent_marking_duration;
+    current_.concurrent_marking_bytes =
+        current_.cumulative_concurrent_marking_bytes -
+        previous_incremental_mark_compactor_event_
+            .cumulative_concurrent_marking_bytes;
     current_.incremental_marking_steps =
         current_.cumulative_incremental_marking_steps -
         previous_incremental_mark_compactor_event_
@@ -284,6 +371,7 @@ void GCTracer::Stop(GarbageCollector collector) {
     recorded_incremental_mark_compacts_.Push(
         MakeBytesAndDuration(current_.start_object_size, duration));
     combined_mark_compact_speed_cache_ = 0.0;
+    mark_compact_pauses_.AddSample(duration);
   } else {
     DCHECK(current_.incremental_marking_bytes == 0);
     DCHECK(current_.incremental_marking_duration == 0);
@@ -292,6 +380,7 @@ void GCTracer::Stop(GarbageCollector collector) {
     recorded_mark_compacts_.Push(
         MakeBytesAndDuration(current_.start_object_size, duration));
     combined_mark_compact_speed_cache_ = 0.0;
+    mark_compact_pauses_.AddSample(duration);
   }
 
   // TODO(ernstm): move the code below out of GCTracer.
@@ -390,17 +479,25 @@ void GCTracer::AddIncrementalMarkingStep(double duration, intptr_t bytes) {
   longest_incremental_marking_step_ =
       Max(longest_incremental_marking_step_, duration);
   cumulative_marking_duration_ += duration;
+  incremental_marking_pauses_.AddSample(duration);
   if (bytes > 0) {
     cumulative_pure_incremental_marking_duration_ += duration;
   }
 }
 
 
+void GCTracer::AddConcurrentMarkingStep(double duration, intptr_t bytes) {
+  cumulative_concurrent_marking_duration_ += duration;
+  cumulative_concurrent_marking_bytes_ += bytes;
+}
+
+
 void GCTracer::AddIncrementalMarkingFinalizationStep(double duration) {
   cumulative_incremental_marking_finalization_steps_++;
   cumulative_incremental_marking_finalization_duration_ += duration;
   longest_incremental_marking_finalization_step_ =
       Max(longest_incremental_marking_finalization_step_, duration);
+  incremental_marking_pauses_.AddSample(duration);
 }
 
 
@@ -455,6 +552,9 @@ void GCTracer::Print() const {
           current_.longest_incremental_marking_step);
     }
   }
+  if (current_.concurrent_marking_duration > 0) {
+    Output(" (+ %.1f ms concurrently)", current_.concurrent_marking_duration);
+  }
 
   if (current_.gc_reason != NULL) {
     Output(" [%s]", current_.gc_reason);
@@ -600,6 +700,9 @@ void GCTracer::PrintNVP() const {
           "finalization_steps_took=%.1f "
           "finalization_longest_step=%.1f "
           "incremental_marking_throughput=%.f "
+          "concurrent_marking=%.1f "
+          "concurrent_marking_bytes=%" V8PRIdPTR
+          " "
           "total_size_before=%" V8PRIdPTR
           " "
           "total_size_after=%" V8PRIdPTR
@@ -671,7 +774,9 @@ void GCTracer::PrintNVP() const {
           cumulative_incremental_marking_finalization_duration_,
           longest_incremental_marking_finalization_step_,
           IncrementalMarkingSpeedInBytesPerMillisecond(),
-          current_.start_object_size, current_.end_object_size,
+          current_.concurrent_marking_duration,
+          current_.concurrent_marking_bytes, current_.start_object_size,
+          current_.end_object_size,
           current_.start_holes_size, current_.end_holes_size,
           allocated_since_last_gc, heap_->promoted_objects_size(),
           heap_->semi_space_copied_object_size(),
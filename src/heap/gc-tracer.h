@@ -51,6 +51,47 @@ class RingBuffer {
   DISALLOW_COPY_AND_ASSIGN(RingBuffer);
 };
 
+// Histogram of pause durations with bounded relative error. Durations are
+// bucketed in microseconds: the first kLinearBuckets buckets hold one
+// microsecond each and every following power of two is split into
+// kSubBuckets buckets, so a reported percentile is at most 12.5% above the
+// recorded value. Recording a pause is constant time and does not allocate.
+class PauseHistogram {
+ public:
+  static const int kLinearBuckets = 16;
+  static const int kSubBucketBits = 3;
+  static const int kSubBuckets = 1 << kSubBucketBits;
+  static const int kNumBuckets =
+      kLinearBuckets + (32 - (kSubBucketBits + 1)) * kSubBuckets;
+
+  PauseHistogram() { Reset(); }
+
+  void AddSample(double duration_ms);
+
+  // Returns the smallest bucket bound in milliseconds below which at least
+  // |percentile| percent of the samples fall, capped at max_ms().
+  // Returns 0 if no samples have been recorded.
+  double Percentile(double percentile) const;
+
+  int count() const { return count_; }
+  double total_ms() const { return total_ms_; }
+  double max_ms() const { return max_ms_; }
+
+  void Reset();
+
+  // Maps a duration to its bucket and a bucket to its exclusive upper bound
+  // in microseconds. Exposed for testing.
+  static int BucketIndex(uint32_t microseconds);
+  static uint64_t BucketLimit(int index);
+
+ private:
+  uint32_t buckets_[kNumBuckets];
+  int count_;
+  double total_ms_;
+  double max_ms_;
+  DISALLOW_COPY_AND_ASSIGN(PauseHistogram);
+};
+
 typedef std::pair<uint64_t, double> BytesAndDuration;
 
 inline BytesAndDuration MakeBytesAndDuration(uint64_t bytes, double duration) {
@@ -99,6 +140,14 @@ enum ScavengeSpeedMode { kForAllObjects, kForSurvivedObjects };
   F(MC_SWEEP_CODE)                                 \
   F(MC_SWEEP_MAP)                                  \
   F(MC_SWEEP_OLD)                                  \
+  F(MINOR_MC)                                      \
+  F(MINOR_MC_CLEAN_UP)                             \
+  F(MINOR_MC_EVACUATE)                             \
+  F(MINOR_MC_MARK)                                 \
+  F(MINOR_MC_MARK_OLD_TO_NEW_POINTERS)             \
+  F(MINOR_MC_MARK_ROOTS)                           \
+  F(MINOR_MC_MARK_WEAK)                            \
+  F(MINOR_MC_UPDATE_POINTERS)                      \
   F(SCAVENGER_CODE_FLUSH_CANDIDATES)               \
   F(SCAVENGER_EXTERNAL_EPILOGUE)                   \
   F(SCAVENGER_EXTERNAL_PROLOGUE)                   \
@@ -243,6 +292,24 @@ class GCTracer {
     // (value at start of event)
     double longest_incremental_marking_step;
 
+    // Cumulative duration of concurrent marking tasks since creation of
+    // tracer. (value at end of event, tasks are stopped at the start of a GC)
+    double cumulative_concurrent_marking_duration;
+
+    // Duration of concurrent marking tasks since
+    // - last event for SCAVENGER events
+    // - last INCREMENTAL_MARK_COMPACTOR event for INCREMENTAL_MARK_COMPACTOR
+    // events
+    double concurrent_marking_duration;
+
+    // Bytes marked by concurrent marking tasks since creation of tracer.
+    // (value at end of event)
+    intptr_t cumulative_concurrent_marking_bytes;
+
+    // Bytes marked by concurrent marking tasks since the last event, see
+    // concurrent_marking_duration.
+    intptr_t concurrent_marking_bytes;
+
     // Amounts of time spent in different scopes during GC.
     double scopes[Scope::NUMBER_OF_SCOPES];
   };
@@ -276,6 +343,25 @@ class GCTracer {
 
   void AddIncrementalMarkingFinalizationStep(double duration);
 
+  // Log the work that background tasks did since concurrent marking was last
+  // stopped. |duration| is the sum of the task durations.
+  void AddConcurrentMarkingStep(double duration, intptr_t bytes);
+
+  // Time spent in marking on background threads.
+  double cumulative_concurrent_marking_duration() const {
+    return cumulative_concurrent_marking_duration_;
+  }
+
+  // Distributions of main thread pauses since creation of the tracer.
+  // Incremental marking finalization steps count as incremental steps.
+  const PauseHistogram& scavenge_pauses() const { return scavenge_pauses_; }
+  const PauseHistogram& incremental_marking_pauses() const {
+    return incremental_marking_pauses_;
+  }
+  const PauseHistogram& mark_compact_pauses() const {
+    return mark_compact_pauses_;
+  }
+
   // Log time spent in marking.
   void AddMarkingTime(double duration) {
     cumulative_marking_duration_ += duration;
@@ -398,6 +484,8 @@ class GCTracer {
     longest_incremental_marking_finalization_step_ = 0;
     cumulative_marking_duration_ = 0;
     cumulative_sweeping_duration_ = 0;
+    cumulative_concurrent_marking_duration_ = 0;
+    cumulative_concurrent_marking_bytes_ = 0;
   }
 
   double TotalExternalTime() const {
@@ -464,6 +552,12 @@ class GCTracer {
   // all sweeping operations performed on the main thread.
   double cumulative_sweeping_duration_;
 
+  // Cumulative duration and size of the work of concurrent marking tasks.
+  // Not included in cumulative_marking_duration_, which only accounts for
+  // time on the main thread.
+  double cumulative_concurrent_marking_duration_;
+  intptr_t cumulative_concurrent_marking_bytes_;
+
   // Timestamp and allocation counter at the last sampled allocation event.
   double allocation_time_ms_;
   size_t new_space_allocation_counter_bytes_;
@@ -493,6 +587,10 @@ class GCTracer {
   RingBuffer<double> recorded_context_disposal_times_;
   RingBuffer<double> recorded_survival_ratios_;
 
+  PauseHistogram scavenge_pauses_;
+  PauseHistogram incremental_marking_pauses_;
+  PauseHistogram mark_compact_pauses_;
+
   DISALLOW_COPY_AND_ASSIGN(GCTracer);
 };
 }  // namespace internal
@@ -7,18 +7,22 @@
 #include "src/accessors.h"
 #include "src/api.h"
 #include "src/ast/context-slot-cache.h"
+#include "src/base/accounting-allocator.h"
 #include "src/base/bits.h"
 #include "src/base/once.h"
 #include "src/base/utils/random-number-generator.h"
 #include "src/bootstrapper.h"
 #include "src/codegen.h"
 #include "src/compilation-cache.h"
+#include "src/compiler-dispatcher/compiler-dispatcher.h"
 #include "src/conversions.h"
 #include "src/debug/debug.h"
 #include "src/deoptimizer.h"
 #include "src/global-handles.h"
+#include "src/heap/array-buffer-collector.h"
 #include "src/heap/array-buffer-tracker-inl.h"
 #include "src/heap/code-stats.h"
+#include "src/heap/concurrent-marking.h"
 #include "src/heap/gc-idle-time-handler.h"
 #include "src/heap/gc-tracer.h"
 #include "src/heap/incremental-marking.h"
@@ -26,6 +30,7 @@
 #include "src/heap/mark-compact.h"
 #include "src/heap/memory-reducer.h"
 #include "src/heap/object-stats.h"
+#include "src/heap/parallel-scavenger.h"
 #include "src/heap/objects-visiting-inl.h"
 #include "src/heap/objects-visiting.h"
 #include "src/heap/remembered-set.h"
@@ -134,10 +139,13 @@ Heap::Heap()
       last_idle_notification_time_(0.0),
       last_gc_time_(0.0),
       scavenge_collector_(nullptr),
+      parallel_scavenger_(nullptr),
       mark_compact_collector_(nullptr),
       memory_allocator_(nullptr),
       store_buffer_(nullptr),
+      array_buffer_collector_(nullptr),
       incremental_marking_(nullptr),
+      concurrent_marking_(nullptr),
       gc_idle_time_handler_(nullptr),
       memory_reducer_(nullptr),
       live_object_stats_(nullptr),
@@ -424,6 +432,12 @@ void Heap::IncrementDeferredCount(v8::Isolate::UseCounterFeature feature) {
 
 
 void Heap::GarbageCollectionPrologue() {
+  // Background marking tasks never run during a GC, so none of the GCs has to
+  // update their worklists.
+  if (concurrent_marking_ != nullptr) {
+    concurrent_marking_->Stop(mark_compact_collector()->marking_deque());
+  }
+
   {
     AllowHeapAllocation for_the_first_part_of_prologue;
     gc_count_++;
@@ -460,7 +474,7 @@ void Heap::GarbageCollectionPrologue() {
   }
   CheckNewSpaceExpansionCriteria();
   UpdateNewSpaceAllocationCounter();
-  store_buffer()->MoveEntriesToRememberedSet();
+  store_buffer()->MoveAllEntriesToRememberedSet();
 }
 
 
@@ -631,7 +645,8 @@ void Heap::DeoptMarkedAllocationSites() {
     }
     list_element = site->weak_next();
   }
-  Deoptimizer::DeoptimizeMarkedCode(isolate_);
+  Deoptimizer::DeoptimizeMarkedCode(isolate_,
+                                    DeoptimizeReason::kDependencyChange);
 }
 
 
@@ -647,6 +662,8 @@ void Heap::GarbageCollectionEpilogue() {
   }
 #endif
 
+  array_buffer_collector()->FreeAllocationsOnBackgroundThread();
+
   AllowHeapAllocation for_the_rest_of_the_epilogue;
 
 #ifdef DEBUG
@@ -661,7 +678,7 @@ void Heap::GarbageCollectionEpilogue() {
     // the topmost optimized frame can be deoptimized safely, because it
     // might not have a lazy bailout point right after its current PC.
     if (++gcs_since_last_deopt_ == FLAG_deopt_every_n_garbage_collections) {
-      Deoptimizer::DeoptimizeAll(isolate());
+      Deoptimizer::DeoptimizeAll(isolate(), DeoptimizeReason::kTesting);
       gcs_since_last_deopt_ = 0;
     }
   }
@@ -883,6 +900,7 @@ void Heap::CollectAllAvailableGarbage(const char* gc_reason) {
     DisallowHeapAllocation no_recursive_gc;
     isolate()->optimizing_compile_dispatcher()->Flush();
   }
+  base::AccountingAllocator::ReleasePool();
   isolate()->ClearSerializerData();
   set_current_gc_flags(kMakeHeapIterableMask | kReduceMemoryFootprintMask);
   isolate_->compilation_cache()->Clear();
@@ -1322,6 +1340,10 @@ bool Heap::PerformGarbageCollection(
       old_generation_allocation_counter_ +=
           static_cast<size_t>(promoted_objects_size_);
       old_generation_size_at_last_gc_ = PromotedSpaceSizeOfObjects();
+    } else if (FLAG_minor_mc && incremental_marking()->IsStopped()) {
+      // The minor mark-compactor shares the mark bits and the marking deque
+      // with incremental marking.
+      MinorMarkCompact();
     } else {
       Scavenge();
     }
@@ -1640,7 +1662,14 @@ void Heap::Scavenge() {
   promotion_queue_.Initialize();
 
   PromotionMode promotion_mode = CurrentPromotionMode();
-  ScavengeVisitor scavenge_visitor(this);
+  ScavengeVisitor sequential_visitor(this);
+  ObjectVisitor* scavenge_visitor = &sequential_visitor;
+  const bool parallel = parallel_scavenger_ != nullptr &&
+                        parallel_scavenger_->CanScavengeInParallel();
+  if (parallel) {
+    parallel_scavenger_->Start();
+    scavenge_visitor = parallel_scavenger_->main_thread_visitor();
+  }
 
   if (FLAG_scavenge_reclaim_unmodified_objects) {
     isolate()->global_handles()->IdentifyWeakUnmodifiedObjects(
@@ -1650,35 +1679,39 @@ void Heap::Scavenge() {
   {
     // Copy roots.
     TRACE_GC(tracer(), GCTracer::Scope::SCAVENGER_ROOTS);
-    IterateRoots(&scavenge_visitor, VISIT_ALL_IN_SCAVENGE);
+    IterateRoots(scavenge_visitor, VISIT_ALL_IN_SCAVENGE);
   }
 
   {
     // Copy objects reachable from the old generation.
     TRACE_GC(tracer(), GCTracer::Scope::SCAVENGER_OLD_TO_NEW_POINTERS);
-    RememberedSet<OLD_TO_NEW>::Iterate(this, [this](Address addr) {
-      return Scavenger::CheckAndScavengeObject(this, addr);
-    });
-
-    RememberedSet<OLD_TO_NEW>::IterateTyped(
-        this, [this](SlotType type, Address host_addr, Address addr) {
-          return UpdateTypedSlotHelper::UpdateTypedSlot(
-              isolate(), type, addr, [this](Object** addr) {
-                // We expect that objects referenced by code are long living.
-                // If we do not force promotion, then we need to clear
-                // old_to_new slots in dead code objects after mark-compact.
-                return Scavenger::CheckAndScavengeObject(
-                    this, reinterpret_cast<Address>(addr));
-              });
-        });
+    if (parallel) {
+      parallel_scavenger_->ScavengeOldToNewPointers();
+    } else {
+      RememberedSet<OLD_TO_NEW>::Iterate(this, [this](Address addr) {
+        return Scavenger::CheckAndScavengeObject(this, addr);
+      });
+
+      RememberedSet<OLD_TO_NEW>::IterateTyped(
+          this, [this](SlotType type, Address host_addr, Address addr) {
+            return UpdateTypedSlotHelper::UpdateTypedSlot(
+                isolate(), type, addr, [this](Object** addr) {
+                  // We expect that objects referenced by code are long living.
+                  // If we do not force promotion, then we need to clear
+                  // old_to_new slots in dead code objects after mark-compact.
+                  return Scavenger::CheckAndScavengeObject(
+                      this, reinterpret_cast<Address>(addr));
+                });
+          });
+    }
   }
 
   {
     TRACE_GC(tracer(), GCTracer::Scope::SCAVENGER_WEAK);
     // Copy objects reachable from the encountered weak collections list.
-    scavenge_visitor.VisitPointer(&encountered_weak_collections_);
+    scavenge_visitor->VisitPointer(&encountered_weak_collections_);
     // Copy objects reachable from the encountered weak cells.
-    scavenge_visitor.VisitPointer(&encountered_weak_cells_);
+    scavenge_visitor->VisitPointer(&encountered_weak_cells_);
   }
 
   {
@@ -1686,14 +1719,14 @@ void Heap::Scavenge() {
     TRACE_GC(tracer(), GCTracer::Scope::SCAVENGER_CODE_FLUSH_CANDIDATES);
     MarkCompactCollector* collector = mark_compact_collector();
     if (collector->is_code_flushing_enabled()) {
-      collector->code_flusher()->IteratePointersToFromSpace(&scavenge_visitor);
+      collector->code_flusher()->IteratePointersToFromSpace(scavenge_visitor);
     }
   }
 
   {
     TRACE_GC(tracer(), GCTracer::Scope::SCAVENGER_SEMISPACE);
     new_space_front =
-        DoScavenge(&scavenge_visitor, new_space_front, promotion_mode);
+        DoScavenge(scavenge_visitor, new_space_front, promotion_mode);
   }
 
   if (FLAG_scavenge_reclaim_unmodified_objects) {
@@ -1701,15 +1734,15 @@ void Heap::Scavenge() {
         &IsUnscavengedHeapObject);
 
     isolate()->global_handles()->IterateNewSpaceWeakUnmodifiedRoots(
-        &scavenge_visitor);
+        scavenge_visitor);
     new_space_front =
-        DoScavenge(&scavenge_visitor, new_space_front, promotion_mode);
+        DoScavenge(scavenge_visitor, new_space_front, promotion_mode);
   } else {
     TRACE_GC(tracer(), GCTracer::Scope::SCAVENGER_OBJECT_GROUPS);
     while (isolate()->global_handles()->IterateObjectGroups(
-        &scavenge_visitor, &IsUnscavengedHeapObject)) {
+        scavenge_visitor, &IsUnscavengedHeapObject)) {
       new_space_front =
-          DoScavenge(&scavenge_visitor, new_space_front, promotion_mode);
+          DoScavenge(scavenge_visitor, new_space_front, promotion_mode);
     }
     isolate()->global_handles()->RemoveObjectGroups();
     isolate()->global_handles()->RemoveImplicitRefGroups();
@@ -1718,9 +1751,13 @@ void Heap::Scavenge() {
         &IsUnscavengedHeapObject);
 
     isolate()->global_handles()->IterateNewSpaceWeakIndependentRoots(
-        &scavenge_visitor);
+        scavenge_visitor);
     new_space_front =
-        DoScavenge(&scavenge_visitor, new_space_front, promotion_mode);
+        DoScavenge(scavenge_visitor, new_space_front, promotion_mode);
+  }
+
+  if (parallel) {
+    parallel_scavenger_->Finish();
   }
 
   UpdateNewSpaceReferencesInExternalStringTable(
@@ -1750,6 +1787,32 @@ void Heap::Scavenge() {
 }
 
 
+void Heap::MinorMarkCompact() {
+  TRACE_GC(tracer(), GCTracer::Scope::MINOR_MC);
+  RelocationLock relocation_lock(this);
+  // Evacuation allocates in old space and must not fail or trigger another
+  // GC. See Scavenge().
+  AlwaysAllocateScope scope(isolate());
+  PauseAllocationObserversScope pause_observers(this);
+
+  mark_compact_collector()->sweeper().EnsureNewSpaceCompleted();
+
+  gc_state_ = MINOR_MARK_COMPACT;
+  LOG(isolate_, ResourceEvent("minor-markcompact", "begin"));
+
+  if (FLAG_scavenge_reclaim_unmodified_objects) {
+    isolate()->global_handles()->IdentifyWeakUnmodifiedObjects(
+        &IsUnmodifiedHeapObject);
+  }
+
+  mark_compact_collector()->CollectYoungGeneration();
+
+  LOG(isolate_, ResourceEvent("minor-markcompact", "end"));
+
+  gc_state_ = NOT_IN_GC;
+}
+
+
 String* Heap::UpdateNewSpaceReferenceInExternalStringTableEntry(Heap* heap,
                                                                 Object** p) {
   MapWord first_word = HeapObject::cast(*p)->map_word();
@@ -1905,6 +1968,12 @@ void Heap::VisitExternalResources(v8::ExternalResourceVisitor* visitor) {
 Address Heap::DoScavenge(ObjectVisitor* scavenge_visitor,
                          Address new_space_front,
                          PromotionMode promotion_mode) {
+  if (parallel_scavenger_ != nullptr && parallel_scavenger_->in_progress()) {
+    // Copied objects are not laid out linearly in to-space but distributed
+    // over the allocation buffers of the tasks.
+    parallel_scavenger_->ProcessCopiedObjects();
+    return new_space_.top();
+  }
   do {
     SemiSpace::AssertValidRange(new_space_front, new_space_.top());
     // The addresses new_space_front and new_space_.top() define a
@@ -3019,7 +3088,7 @@ AllocationResult Heap::AllocateByteArray(int length, PretenureFlag pretenure) {
     v8::internal::Heap::FatalProcessOutOfMemory("invalid array length", true);
   }
   int size = ByteArray::SizeFor(length);
-  AllocationSpace space = SelectSpace(pretenure);
+  AllocationSpace space = SelectSpace(size, pretenure);
   HeapObject* result = nullptr;
   {
     AllocationResult allocation = AllocateRaw(size, space);
@@ -3057,6 +3126,7 @@ AllocationResult Heap::AllocateBytecodeArray(int length,
   instance->set_parameter_count(parameter_count);
   instance->set_interrupt_budget(interpreter::Interpreter::InterruptBudget());
   instance->set_osr_loop_nesting_level(0);
+  instance->set_bytecode_age(BytecodeArray::kNoAgeBytecodeAge);
   instance->set_constant_pool(constant_pool);
   instance->set_handler_table(empty_fixed_array());
   instance->set_source_position_table(empty_byte_array());
@@ -3111,6 +3181,11 @@ bool Heap::CanMoveObjectStart(HeapObject* object) {
 
   if (lo_space()->Contains(object)) return false;
 
+  // Background marking tasks may hold on to the old object start.
+  if (concurrent_marking_ != nullptr && incremental_marking()->IsMarking()) {
+    return false;
+  }
+
   // We can move the object start if the page was already swept.
   return Page::FromAddress(address)->SweepingDone();
 }
@@ -3207,6 +3282,8 @@ template void Heap::RightTrimFixedArray<Heap::CONCURRENT_TO_SWEEPER>(
 
 template<Heap::InvocationMode mode>
 void Heap::RightTrimFixedArray(FixedArrayBase* object, int elements_to_trim) {
+  ConcurrentMarking::LayoutChangeScope layout_change_scope(
+      concurrent_marking_);
   const int len = object->length();
   DCHECK_LE(elements_to_trim, len);
   DCHECK_GE(elements_to_trim, 0);
@@ -3419,6 +3496,7 @@ AllocationResult Heap::CopyBytecodeArray(BytecodeArray* bytecode_array) {
   copy->set_source_position_table(bytecode_array->source_position_table());
   copy->set_interrupt_budget(bytecode_array->interrupt_budget());
   copy->set_osr_loop_nesting_level(bytecode_array->osr_loop_nesting_level());
+  copy->set_bytecode_age(bytecode_array->bytecode_age());
   bytecode_array->CopyBytecodesTo(copy);
   return copy;
 }
@@ -3716,7 +3794,7 @@ AllocationResult Heap::AllocateRawOneByteString(int length,
   DCHECK_GE(String::kMaxLength, length);
   int size = SeqOneByteString::SizeFor(length);
   DCHECK(size <= SeqOneByteString::kMaxSize);
-  AllocationSpace space = SelectSpace(pretenure);
+  AllocationSpace space = SelectSpace(size, pretenure);
 
   HeapObject* result = nullptr;
   {
@@ -3740,7 +3818,7 @@ AllocationResult Heap::AllocateRawTwoByteString(int length,
   DCHECK_GE(String::kMaxLength, length);
   int size = SeqTwoByteString::SizeFor(length);
   DCHECK(size <= SeqTwoByteString::kMaxSize);
-  AllocationSpace space = SelectSpace(pretenure);
+  AllocationSpace space = SelectSpace(size, pretenure);
 
   HeapObject* result = nullptr;
   {
@@ -3900,7 +3978,7 @@ AllocationResult Heap::AllocateRawFixedArray(int length,
     v8::internal::Heap::FatalProcessOutOfMemory("invalid array length", true);
   }
   int size = FixedArray::SizeFor(length);
-  AllocationSpace space = SelectSpace(pretenure);
+  AllocationSpace space = SelectSpace(size, pretenure);
 
   return AllocateRaw(size, space);
 }
@@ -3968,7 +4046,7 @@ AllocationResult Heap::AllocateRawFixedDoubleArray(int length,
     v8::internal::Heap::FatalProcessOutOfMemory("invalid array length", true);
   }
   int size = FixedDoubleArray::SizeFor(length);
-  AllocationSpace space = SelectSpace(pretenure);
+  AllocationSpace space = SelectSpace(size, pretenure);
 
   HeapObject* object = nullptr;
   {
@@ -4222,7 +4300,7 @@ void Heap::RegisterReservationsForBlackAllocation(Reservation* reservations) {
         Address addr = chunk.start;
         while (addr < chunk.end) {
           HeapObject* obj = HeapObject::FromAddress(addr);
-          Marking::MarkBlack(ObjectMarking::MarkBitFrom(obj));
+          Marking::MarkBlack<MarkBit::ATOMIC>(ObjectMarking::MarkBitFrom(obj));
           addr += obj->Size();
         }
       }
@@ -4408,6 +4486,11 @@ void Heap::CheckMemoryPressure() {
       DisallowHeapAllocation no_recursive_gc;
       isolate()->optimizing_compile_dispatcher()->Flush();
     }
+    if (isolate()->compiler_dispatcher() != nullptr) {
+      // Functions still compile lazily when they are called, so the pending
+      // jobs and their zones can go.
+      isolate()->compiler_dispatcher()->AbortAll();
+    }
   }
   if (memory_pressure_level_.Value() == MemoryPressureLevel::kCritical) {
     CollectGarbageOnMemoryPressure("memory pressure");
@@ -4457,6 +4540,10 @@ void Heap::CollectGarbageOnMemoryPressure(const char* source) {
 
 void Heap::MemoryPressureNotification(MemoryPressureLevel level,
                                       bool is_isolate_locked) {
+  // Unused zone memory can be returned right away from any thread.
+  if (level != MemoryPressureLevel::kNone) {
+    base::AccountingAllocator::ReleasePool();
+  }
   MemoryPressureLevel previous = memory_pressure_level_.Value();
   memory_pressure_level_.SetValue(level);
   if ((previous != MemoryPressureLevel::kCritical &&
@@ -5307,6 +5394,8 @@ bool Heap::SetUp() {
   // Initialize store buffer.
   store_buffer_ = new StoreBuffer(this);
 
+  array_buffer_collector_ = new ArrayBufferCollector(this);
+
   // Initialize incremental marking.
   incremental_marking_ = new IncrementalMarking(this);
 
@@ -5359,8 +5448,16 @@ bool Heap::SetUp() {
 
   scavenge_collector_ = new Scavenger(this);
 
+  if (FLAG_parallel_scavenge) {
+    parallel_scavenger_ = new ParallelScavenger(this);
+  }
+
   mark_compact_collector_ = new MarkCompactCollector(this);
 
+  if (FLAG_concurrent_marking && ConcurrentMarking::IsSupported()) {
+    concurrent_marking_ = new ConcurrentMarking(this);
+  }
+
   gc_idle_time_handler_ = new GCIdleTimeHandler();
 
   memory_reducer_ = new MemoryReducer(this);
@@ -5516,6 +5613,15 @@ void Heap::TearDown() {
   delete scavenge_collector_;
   scavenge_collector_ = nullptr;
 
+  delete parallel_scavenger_;
+  parallel_scavenger_ = nullptr;
+
+  if (concurrent_marking_ != nullptr) {
+    concurrent_marking_->Stop(mark_compact_collector()->marking_deque());
+    delete concurrent_marking_;
+    concurrent_marking_ = nullptr;
+  }
+
   if (mark_compact_collector_ != nullptr) {
     mark_compact_collector_->TearDown();
     delete mark_compact_collector_;
@@ -5554,6 +5660,10 @@ void Heap::TearDown() {
   delete tracer_;
   tracer_ = nullptr;
 
+  // Stops the store buffer task before the pages it inserts slots into are
+  // released.
+  store_buffer()->TearDown();
+
   new_space_.TearDown();
 
   if (old_space_ != NULL) {
@@ -5577,7 +5687,8 @@ void Heap::TearDown() {
     lo_space_ = NULL;
   }
 
-  store_buffer()->TearDown();
+  // Frees the backing stores that the spaces released above.
+  array_buffer_collector()->TearDown();
 
   memory_allocator()->TearDown();
 
@@ -5591,6 +5702,9 @@ void Heap::TearDown() {
   delete store_buffer_;
   store_buffer_ = nullptr;
 
+  delete array_buffer_collector_;
+  array_buffer_collector_ = nullptr;
+
   delete memory_allocator_;
   memory_allocator_ = nullptr;
 }
@@ -5785,7 +5899,7 @@ void Heap::CheckHandleCount() {
 
 void Heap::ClearRecordedSlot(HeapObject* object, Object** slot) {
   if (!InNewSpace(object)) {
-    store_buffer()->MoveEntriesToRememberedSet();
+    store_buffer()->MoveAllEntriesToRememberedSet();
     Address slot_addr = reinterpret_cast<Address>(slot);
     Page* page = Page::FromAddress(slot_addr);
     DCHECK_EQ(page->owner()->identity(), OLD_SPACE);
@@ -5797,7 +5911,7 @@ void Heap::ClearRecordedSlot(HeapObject* object, Object** slot) {
 void Heap::ClearRecordedSlotRange(Address start, Address end) {
   Page* page = Page::FromAddress(start);
   if (!page->InNewSpace()) {
-    store_buffer()->MoveEntriesToRememberedSet();
+    store_buffer()->MoveAllEntriesToRememberedSet();
     DCHECK_EQ(page->owner()->identity(), OLD_SPACE);
     RememberedSet<OLD_TO_NEW>::RemoveRange(page, start, end);
     RememberedSet<OLD_TO_OLD>::RemoveRange(page, start, end);
@@ -313,7 +313,9 @@ using v8::MemoryPressureLevel;
 
 // Forward declarations.
 class AllocationObserver;
+class ArrayBufferCollector;
 class ArrayBufferTracker;
+class ConcurrentMarking;
 class GCIdleTimeAction;
 class GCIdleTimeHandler;
 class GCIdleTimeHeapState;
@@ -324,6 +326,7 @@ class HistogramTimer;
 class Isolate;
 class MemoryReducer;
 class ObjectStats;
+class ParallelScavenger;
 class Scavenger;
 class ScavengeJob;
 class StoreBuffer;
@@ -487,7 +490,7 @@ class Heap {
 
   enum FindMementoMode { kForRuntime, kForGC };
 
-  enum HeapState { NOT_IN_GC, SCAVENGE, MARK_COMPACT };
+  enum HeapState { NOT_IN_GC, SCAVENGE, MINOR_MARK_COMPACT, MARK_COMPACT };
 
   // Indicates whether live bytes adjustment is triggered
   // - from within the GC code before sweeping started (SEQUENTIAL_TO_SWEEPER),
@@ -754,6 +757,12 @@ class Heap {
   template <FindMementoMode mode>
   inline AllocationMemento* FindAllocationMemento(HeapObject* object);
 
+  // Same as above but uses the given {map} instead of reading it from the
+  // object, which may already contain a forwarding address.
+  template <FindMementoMode mode>
+  inline AllocationMemento* FindAllocationMemento(Map* map,
+                                                  HeapObject* object);
+
   // Returns false if not able to reserve.
   bool ReserveSpace(Reservation* reservations, List<Address>* maps);
 
@@ -849,8 +858,11 @@ class Heap {
   }
 
   void account_external_memory_concurrently_freed() {
-    external_memory_ -= external_memory_concurrently_freed_.Value();
-    external_memory_concurrently_freed_.SetValue(0);
+    // Backing stores may be freed concurrently, so only the bytes that were
+    // read are subtracted from the counter.
+    intptr_t freed = external_memory_concurrently_freed_.Value();
+    external_memory_ -= freed;
+    external_memory_concurrently_freed_.Increment(-freed);
   }
 
   void DeoptMarkedAllocationSites();
@@ -1167,6 +1179,13 @@ class Heap {
 
   IncrementalMarking* incremental_marking() { return incremental_marking_; }
 
+  // Null unless --concurrent_marking is enabled and supported on this host.
+  ConcurrentMarking* concurrent_marking() { return concurrent_marking_; }
+
+  ArrayBufferCollector* array_buffer_collector() {
+    return array_buffer_collector_;
+  }
+
   // ===========================================================================
   // External string table API. ================================================
   // ===========================================================================
@@ -1414,9 +1433,11 @@ class Heap {
   // storage is passed as {pretenuring_feedback} the memento found count on
   // the corresponding allocation site is immediately updated and an entry
   // in the hash map is created. Otherwise the entry (including a the count
-  // value) is cached on the local pretenuring feedback.
+  // value) is cached on the local pretenuring feedback. The {map} of the
+  // object is passed explicitly as the map word of the object may have been
+  // replaced by a forwarding address already.
   template <UpdateAllocationSiteMode mode>
-  inline void UpdateAllocationSite(HeapObject* object,
+  inline void UpdateAllocationSite(Map* map, HeapObject* object,
                                    base::HashMap* pretenuring_feedback);
 
   // Removes an entry from the global pretenuring storage.
@@ -1557,6 +1578,17 @@ class Heap {
     return (pretenure == TENURED) ? OLD_SPACE : NEW_SPACE;
   }
 
+  // Same as above for arrays and strings of |size| bytes, which skip new
+  // space if they are medium objects, see Page::kMinMediumHeapObjectSize.
+  // Must not be used for objects that callers initialize without write
+  // barriers.
+  static AllocationSpace SelectSpace(int size, PretenureFlag pretenure) {
+    if (FLAG_medium_object_pages && size >= Page::kMinMediumHeapObjectSize) {
+      return OLD_SPACE;
+    }
+    return SelectSpace(pretenure);
+  }
+
 #define ROOT_ACCESSOR(type, name, camel_name) \
   inline void set_##name(type* value);
   ROOT_LIST(ROOT_ACCESSOR)
@@ -1743,6 +1775,10 @@ class Heap {
   // Performs a minor collection in new generation.
   void Scavenge();
 
+  // Performs a minor collection in new generation by marking and evacuating
+  // live objects instead of copying them with the scavenger.
+  void MinorMarkCompact();
+
   Address DoScavenge(ObjectVisitor* scavenge_visitor, Address new_space_front,
                      PromotionMode promotion_mode);
 
@@ -2205,14 +2241,20 @@ class Heap {
 
   Scavenger* scavenge_collector_;
 
+  ParallelScavenger* parallel_scavenger_;
+
   MarkCompactCollector* mark_compact_collector_;
 
   MemoryAllocator* memory_allocator_;
 
   StoreBuffer* store_buffer_;
 
+  ArrayBufferCollector* array_buffer_collector_;
+
   IncrementalMarking* incremental_marking_;
 
+  ConcurrentMarking* concurrent_marking_;
+
   GCIdleTimeHandler* gc_idle_time_handler_;
 
   MemoryReducer* memory_reducer_;
@@ -2303,9 +2345,12 @@ class Heap {
   friend class NewSpace;
   friend class ObjectStatsCollector;
   friend class Page;
+  friend class ParallelScavenger;
   friend class Scavenger;
   friend class StoreBuffer;
   friend class TestMemoryAllocatorScope;
+  template <typename StaticVisitor>
+  friend class StaticMarkingVisitor;
 
   // The allocator interface.
   friend class Factory;
@@ -7,6 +7,7 @@
 #include "src/code-stubs.h"
 #include "src/compilation-cache.h"
 #include "src/conversions.h"
+#include "src/heap/concurrent-marking.h"
 #include "src/heap/gc-idle-time-handler.h"
 #include "src/heap/gc-tracer.h"
 #include "src/heap/mark-compact-inl.h"
@@ -142,7 +143,12 @@ void IncrementalMarking::RecordWriteIntoCodeSlow(Code* host, RelocInfo* rinfo,
 
 
 void IncrementalMarking::WhiteToGreyAndPush(HeapObject* obj, MarkBit mark_bit) {
-  Marking::WhiteToGrey(mark_bit);
+  if (FLAG_concurrent_marking) {
+    // A background marker may have won the race for the object.
+    if (!Marking::TryWhiteToGrey<MarkBit::ATOMIC>(mark_bit)) return;
+  } else {
+    Marking::WhiteToGrey(mark_bit);
+  }
   heap_->mark_compact_collector()->marking_deque()->Push(obj);
 }
 
@@ -151,6 +157,12 @@ static void MarkObjectGreyDoNotEnqueue(Object* obj) {
   if (obj->IsHeapObject()) {
     HeapObject* heap_obj = HeapObject::cast(obj);
     MarkBit mark_bit = ObjectMarking::MarkBitFrom(HeapObject::cast(obj));
+    if (FLAG_concurrent_marking) {
+      if (Marking::AnyToGrey<MarkBit::ATOMIC>(mark_bit)) {
+        MemoryChunk::IncrementLiveBytesFromGC(heap_obj, -heap_obj->Size());
+      }
+      return;
+    }
     if (Marking::IsBlack(mark_bit)) {
       MemoryChunk::IncrementLiveBytesFromGC(heap_obj, -heap_obj->Size());
     }
@@ -294,6 +306,12 @@ class IncrementalMarkingMarkingVisitor
   INLINE(static bool MarkObjectWithoutPush(Heap* heap, Object* obj)) {
     HeapObject* heap_object = HeapObject::cast(obj);
     MarkBit mark_bit = ObjectMarking::MarkBitFrom(heap_object);
+    if (FLAG_concurrent_marking) {
+      if (!Marking::TryWhiteToGrey<MarkBit::ATOMIC>(mark_bit)) return false;
+      Marking::TryGreyToBlack<MarkBit::ATOMIC>(mark_bit);
+      MemoryChunk::IncrementLiveBytesFromGC(heap_object, heap_object->Size());
+      return true;
+    }
     if (Marking::IsWhite(mark_bit)) {
       Marking::MarkBlack(mark_bit);
       MemoryChunk::IncrementLiveBytesFromGC(heap_object, heap_object->Size());
@@ -881,8 +899,12 @@ void IncrementalMarking::MarkGrey(Heap* heap, HeapObject* object) {
 
 void IncrementalMarking::MarkBlack(HeapObject* obj, int size) {
   MarkBit mark_bit = ObjectMarking::MarkBitFrom(obj);
-  if (Marking::IsBlack(mark_bit)) return;
-  Marking::GreyToBlack(mark_bit);
+  if (FLAG_concurrent_marking) {
+    if (!Marking::TryGreyToBlack<MarkBit::ATOMIC>(mark_bit)) return;
+  } else {
+    if (Marking::IsBlack(mark_bit)) return;
+    Marking::GreyToBlack(mark_bit);
+  }
   MemoryChunk::IncrementLiveBytesFromGC(obj, size);
 }
 
@@ -950,7 +972,12 @@ void IncrementalMarking::Hurry() {
         Context::cast(context)->get(Context::NORMALIZED_MAP_CACHE_INDEX));
     if (!cache->IsUndefined(heap_->isolate())) {
       MarkBit mark_bit = ObjectMarking::MarkBitFrom(cache);
-      if (Marking::IsGrey(mark_bit)) {
+      if (FLAG_concurrent_marking) {
+        if (Marking::IsGrey<MarkBit::ATOMIC>(mark_bit) &&
+            Marking::TryGreyToBlack<MarkBit::ATOMIC>(mark_bit)) {
+          MemoryChunk::IncrementLiveBytesFromGC(cache, cache->Size());
+        }
+      } else if (Marking::IsGrey(mark_bit)) {
         Marking::GreyToBlack(mark_bit);
         MemoryChunk::IncrementLiveBytesFromGC(cache, cache->Size());
       }
@@ -966,6 +993,11 @@ void IncrementalMarking::Stop() {
     PrintF("[IncrementalMarking] Stopping.\n");
   }
 
+  if (heap_->concurrent_marking() != nullptr) {
+    heap_->concurrent_marking()->Stop(
+        heap_->mark_compact_collector()->marking_deque());
+  }
+
   heap_->new_space()->RemoveAllocationObserver(&observer_);
   IncrementalMarking::set_should_hurry(false);
   ResetStepCounters();
@@ -1157,6 +1189,11 @@ intptr_t IncrementalMarking::Step(intptr_t allocated_bytes,
     return 0;
   }
 
+  ConcurrentMarking* concurrent_marking = heap_->concurrent_marking();
+  if (concurrent_marking != nullptr && state_ == MARKING) {
+    concurrent_marking->NotifyMainThreadStep();
+  }
+
   allocated_ += allocated_bytes;
 
   if (marking == DO_NOT_FORCE_MARKING && allocated_ < kAllocatedThreshold &&
@@ -1200,6 +1237,14 @@ intptr_t IncrementalMarking::Step(intptr_t allocated_bytes,
     }
 
     if (state_ == MARKING) {
+      MarkingDeque* marking_deque =
+          heap_->mark_compact_collector()->marking_deque();
+      if (concurrent_marking != nullptr) {
+        // Background tasks take over the objects they can visit. The main
+        // thread only processes what they leave behind.
+        concurrent_marking->TransferWork(marking_deque);
+        concurrent_marking->ScheduleTasks();
+      }
       bytes_processed = ProcessMarkingDeque(bytes_to_process);
       if (FLAG_incremental_marking_wrappers &&
           heap_->UsingEmbedderHeapTracer()) {
@@ -1214,7 +1259,8 @@ intptr_t IncrementalMarking::Step(intptr_t allocated_bytes,
             EmbedderHeapTracer::AdvanceTracingActions(
                 EmbedderHeapTracer::ForceCompletionAction::FORCE_COMPLETION));
       }
-      if (heap_->mark_compact_collector()->marking_deque()->IsEmpty()) {
+      if (marking_deque->IsEmpty() &&
+          (concurrent_marking == nullptr || concurrent_marking->IsIdle())) {
         if (completion == FORCE_COMPLETION ||
             IsIdleMarkingDelayCounterLimitReached()) {
           if (!finalize_marking_completed_) {
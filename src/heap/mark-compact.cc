@@ -14,6 +14,7 @@
 #include "src/frames-inl.h"
 #include "src/gdb-jit.h"
 #include "src/global-handles.h"
+#include "src/heap/array-buffer-collector.h"
 #include "src/heap/array-buffer-tracker.h"
 #include "src/heap/gc-tracer.h"
 #include "src/heap/incremental-marking.h"
@@ -22,6 +23,7 @@
 #include "src/heap/objects-visiting-inl.h"
 #include "src/heap/objects-visiting.h"
 #include "src/heap/page-parallel-job.h"
+#include "src/heap/parallel-marking.h"
 #include "src/heap/spaces-inl.h"
 #include "src/ic/ic.h"
 #include "src/ic/stub-cache.h"
@@ -60,6 +62,7 @@ MarkCompactCollector::MarkCompactCollector(Heap* heap)
       have_code_to_deoptimize_(false),
       marking_deque_memory_(NULL),
       marking_deque_memory_committed_(0),
+      parallel_marking_(nullptr),
       code_flusher_(nullptr),
       embedder_heap_tracer_(nullptr),
       sweeper_(heap) {
@@ -245,6 +248,10 @@ void MarkCompactCollector::SetUp() {
   EnsureMarkingDequeIsReserved();
   EnsureMarkingDequeIsCommitted(kMinMarkingDequeSize);
 
+  if (FLAG_parallel_marking) {
+    parallel_marking_ = new ParallelMarking(heap());
+  }
+
   if (FLAG_flush_code) {
     code_flusher_ = new CodeFlusher(isolate());
     if (FLAG_trace_code_flushing) {
@@ -257,6 +264,7 @@ void MarkCompactCollector::SetUp() {
 void MarkCompactCollector::TearDown() {
   AbortCompaction();
   delete marking_deque_memory_;
+  delete parallel_marking_;
   delete code_flusher_;
 }
 
@@ -348,6 +356,15 @@ void MarkCompactCollector::CollectGarbage() {
 }
 
 
+void MarkCompactCollector::CollectYoungGeneration() {
+  DCHECK(heap_->incremental_marking()->IsStopped());
+
+  MarkLiveObjectsInYoungGeneration();
+
+  EvacuateYoungGeneration();
+}
+
+
 #ifdef VERIFY_HEAP
 void MarkCompactCollector::VerifyMarkbitsAreClean(PagedSpace* space) {
   for (Page* p : *space) {
@@ -454,6 +471,10 @@ class MarkCompactCollector::Sweeper::SweeperTask : public v8::Task {
       DCHECK_LE(space_id, LAST_PAGED_SPACE);
       sweeper_->ParallelSweepSpace(static_cast<AllocationSpace>(space_id), 0);
     }
+    // Free the backing stores of dead array buffers found while sweeping.
+    // This happens before signaling, so that the collector is idle once
+    // sweeping is completed.
+    sweeper_->heap_->array_buffer_collector()->FreeAllocationsOnSweeperTask();
     pending_sweeper_tasks_->Signal();
   }
 
@@ -558,6 +579,8 @@ void MarkCompactCollector::EnsureSweepingCompleted() {
   heap()->old_space()->RefillFreeList();
   heap()->code_space()->RefillFreeList();
   heap()->map_space()->RefillFreeList();
+  // Sweeping released the backing stores of dead array buffers.
+  heap()->array_buffer_collector()->FreeAllocationsOnBackgroundThread();
 
 #ifdef VERIFY_HEAP
   if (FLAG_verify_heap && !evacuation()) {
@@ -874,7 +897,8 @@ void MarkCompactCollector::Finish() {
 
   if (have_code_to_deoptimize_) {
     // Some code objects were marked for deoptimization during the GC.
-    Deoptimizer::DeoptimizeMarkedCode(isolate());
+    Deoptimizer::DeoptimizeMarkedCode(isolate(),
+                                      DeoptimizeReason::kDependencyChange);
     have_code_to_deoptimize_ = false;
   }
 
@@ -1003,6 +1027,49 @@ void CodeFlusher::ProcessSharedFunctionInfoCandidates() {
 }
 
 
+void CodeFlusher::ProcessBytecodeCandidates() {
+  Code* lazy_compile = isolate_->builtins()->builtin(Builtins::kCompileLazy);
+  MarkCompactCollector* collector = isolate_->heap()->mark_compact_collector();
+
+  for (int i = 0; i < bytecode_candidates_.length(); i++) {
+    SharedFunctionInfo* candidate = bytecode_candidates_[i];
+
+    // The candidate might have been flushed already if it was added twice, or
+    // might have moved on to baseline code with the bytecode kept around.
+    if (candidate->HasBytecodeArray()) {
+      BytecodeArray* bytecode = candidate->bytecode_array();
+      MarkBit bytecode_mark = ObjectMarking::MarkBitFrom(bytecode);
+      if (Marking::IsWhite(bytecode_mark)) {
+        if (FLAG_trace_code_flushing) {
+          PrintF("[code-flushing clears bytecode: ");
+          candidate->ShortPrint();
+          PrintF(" - age: %d]\n", bytecode->bytecode_age());
+        }
+        if (candidate->code()->is_interpreter_trampoline_builtin()) {
+          // Always flush the optimized code map if there is one.
+          if (!candidate->OptimizedCodeMapIsCleared()) {
+            candidate->ClearOptimizedCodeMap();
+          }
+          candidate->set_code(lazy_compile);
+        }
+        candidate->ClearBytecodeArray();
+      }
+    }
+
+    // We are in the middle of a GC cycle so the write barrier in the setters
+    // did not record the slot updates and we have to do that manually.
+    Object** data_slot =
+        HeapObject::RawField(candidate, SharedFunctionInfo::kFunctionDataOffset);
+    collector->RecordSlot(candidate, data_slot, *data_slot);
+    Object** code_slot =
+        HeapObject::RawField(candidate, SharedFunctionInfo::kCodeOffset);
+    collector->RecordSlot(candidate, code_slot, *code_slot);
+  }
+
+  bytecode_candidates_.Clear();
+}
+
+
 void CodeFlusher::EvictCandidate(SharedFunctionInfo* shared_info) {
   // Make sure previous flushing decisions are revisited.
   isolate_->heap()->incremental_marking()->IterateBlackObject(shared_info);
@@ -1293,6 +1360,11 @@ class SharedFunctionInfoMarkingVisitor : public ObjectVisitor {
       MarkBit shared_mark = ObjectMarking::MarkBitFrom(shared);
       MarkBit code_mark = ObjectMarking::MarkBitFrom(shared->code());
       collector_->MarkObject(shared->code(), code_mark);
+      if (shared->HasBytecodeArray()) {
+        BytecodeArray* bytecode = shared->bytecode_array();
+        MarkBit bytecode_mark = ObjectMarking::MarkBitFrom(bytecode);
+        collector_->MarkObject(bytecode, bytecode_mark);
+      }
       collector_->MarkObject(shared, shared_mark);
     }
   }
@@ -1380,8 +1452,13 @@ class RootMarkingVisitor : public ObjectVisitor {
     MarkCompactMarkingVisitor::IterateBody(map, object);
 
     // Mark all the objects reachable from the map and body.  May leave
-    // overflowed objects in the heap.
-    collector_->EmptyMarkingDeque();
+    // overflowed objects in the heap. Parallel marking is only worth starting
+    // once the deque has accumulated the objects of many roots, but has to
+    // start before the deque overflows and the heap has to be rescanned.
+    if (collector_->parallel_marking_ == nullptr ||
+        collector_->marking_deque_.IsNearlyFull()) {
+      collector_->EmptyMarkingDeque();
+    }
   }
 
   MarkCompactCollector* collector_;
@@ -1641,7 +1718,7 @@ class MarkCompactCollector::EvacuateVisitorBase
     DCHECK(heap_->AllowedToBeMigrated(src, dest));
     DCHECK(dest != LO_SPACE);
     if (dest == OLD_SPACE) {
-      DCHECK_OBJECT_SIZE(size);
+      DCHECK_OLD_SPACE_OBJECT_SIZE(size);
       DCHECK(IsAligned(size, kPointerSize));
       heap_->CopyBlock(dst_addr, src_addr, size);
       if ((mode == kProfiled) && FLAG_ignition && dst->IsBytecodeArray()) {
@@ -1713,7 +1790,7 @@ class MarkCompactCollector::EvacuateNewSpaceVisitor final
         local_pretenuring_feedback_(local_pretenuring_feedback) {}
 
   inline bool Visit(HeapObject* object) override {
-    heap_->UpdateAllocationSite<Heap::kCached>(object,
+    heap_->UpdateAllocationSite<Heap::kCached>(object->map(), object,
                                                local_pretenuring_feedback_);
     int size = object->Size();
     HeapObject* target_object = nullptr;
@@ -2015,6 +2092,10 @@ void MarkCompactCollector::MarkImplicitRefGroups(
 // After: the marking stack is empty, and all objects reachable from the
 // marking stack have been marked, or are overflowed in the heap.
 void MarkCompactCollector::EmptyMarkingDeque() {
+  if (parallel_marking_ != nullptr) {
+    EmptyMarkingDequeInParallel();
+    return;
+  }
   while (!marking_deque_.IsEmpty()) {
     HeapObject* object = marking_deque_.Pop();
 
@@ -2032,6 +2113,25 @@ void MarkCompactCollector::EmptyMarkingDeque() {
 }
 
 
+// Parallel version of EmptyMarkingDeque. Background tasks only visit objects
+// with plain strong fields; everything else is visited here afterwards, which
+// may push new objects and start another parallel round.
+void MarkCompactCollector::EmptyMarkingDequeInParallel() {
+  DCHECK_NOT_NULL(parallel_marking_);
+  while (!marking_deque_.IsEmpty()) {
+    parallel_marking_->MarkTransitiveClosure(&marking_deque_);
+    HeapObject* object = nullptr;
+    while (parallel_marking_->PopBailoutObject(&object)) {
+      DCHECK(Marking::IsBlack(ObjectMarking::MarkBitFrom(object)));
+      Map* map = object->map();
+      MarkBit map_mark = ObjectMarking::MarkBitFrom(map);
+      MarkObject(map, map_mark);
+      MarkCompactMarkingVisitor::IterateBody(map, object);
+    }
+  }
+}
+
+
 // Sweep the heap for overflowed objects, clear their overflow bits, and
 // push them on the marking stack.  Stop early if the marking stack fills
 // before sweeping completes.  If sweeping completes, there are no remaining
@@ -2377,6 +2477,134 @@ void MarkCompactCollector::MarkLiveObjects() {
 }
 
 
+// Marks the new space objects that are referenced from the visited slots and
+// pushes them on the marking deque. Objects outside of new space are treated
+// as live and are neither marked nor visited.
+class MarkCompactCollector::YoungGenerationMarkingVisitor final
+    : public ObjectVisitor {
+ public:
+  explicit YoungGenerationMarkingVisitor(MarkCompactCollector* collector)
+      : heap_(collector->heap()), collector_(collector) {}
+
+  void VisitPointer(Object** p) override { MarkObjectByPointer(p); }
+
+  void VisitPointers(Object** start, Object** end) override {
+    for (Object** p = start; p < end; p++) MarkObjectByPointer(p);
+  }
+
+  // Returns whether the slot still points into new space and has to be kept
+  // in the OLD_TO_NEW remembered set.
+  SlotCallbackResult VisitOldToNewSlot(Object** slot) {
+    if (!heap_->InNewSpace(*slot)) return REMOVE_SLOT;
+    MarkObjectByPointer(slot);
+    return KEEP_SLOT;
+  }
+
+ private:
+  inline void MarkObjectByPointer(Object** p) {
+    Object* object = *p;
+    if (!heap_->InNewSpace(object)) return;
+    HeapObject* heap_object = HeapObject::cast(object);
+    collector_->MarkObject(heap_object,
+                           ObjectMarking::MarkBitFrom(heap_object));
+  }
+
+  Heap* heap_;
+  MarkCompactCollector* collector_;
+};
+
+bool MarkCompactCollector::IsUnmarkedObjectInYoungGeneration(Heap* heap,
+                                                              Object** p) {
+  return heap->InNewSpace(*p) &&
+         Marking::IsWhite(ObjectMarking::MarkBitFrom(HeapObject::cast(*p)));
+}
+
+void MarkCompactCollector::ProcessMarkingDequeInYoungGeneration(
+    YoungGenerationMarkingVisitor* visitor) {
+  while (true) {
+    while (!marking_deque_.IsEmpty()) {
+      HeapObject* object = marking_deque_.Pop();
+      DCHECK(heap()->InNewSpace(object));
+      DCHECK(Marking::IsBlack(ObjectMarking::MarkBitFrom(object)));
+      object->IterateBody(visitor);
+    }
+    if (!marking_deque_.overflowed()) return;
+    // Overflowed objects can only be grey objects in new space.
+    DiscoverGreyObjectsInNewSpace();
+    if (!marking_deque_.IsFull()) marking_deque_.ClearOverflowed();
+  }
+}
+
+void MarkCompactCollector::MarkLiveObjectsInYoungGeneration() {
+  TRACE_GC(heap()->tracer(), GCTracer::Scope::MINOR_MC_MARK);
+  PostponeInterruptsScope postpone(isolate());
+
+  // Mark bits of new space are only used by incremental marking otherwise,
+  // which is stopped.
+  ClearMarkbitsInNewSpace(heap()->new_space());
+  EnsureMarkingDequeIsCommittedAndInitialize(
+      MarkCompactCollector::kMaxMarkingDequeSize);
+
+  if (UsingEmbedderHeapTracer()) {
+    // See Heap::Scavenge.
+    RegisterWrappersWithEmbedderHeapTracer();
+  }
+
+  YoungGenerationMarkingVisitor visitor(this);
+  GlobalHandles* global_handles = isolate()->global_handles();
+
+  {
+    TRACE_GC(heap()->tracer(), GCTracer::Scope::MINOR_MC_MARK_ROOTS);
+    heap()->IterateRoots(&visitor, VISIT_ALL_IN_SCAVENGE);
+    ProcessMarkingDequeInYoungGeneration(&visitor);
+  }
+
+  {
+    TRACE_GC(heap()->tracer(),
+             GCTracer::Scope::MINOR_MC_MARK_OLD_TO_NEW_POINTERS);
+    RememberedSet<OLD_TO_NEW>::Iterate(heap(), [&visitor](Address addr) {
+      return visitor.VisitOldToNewSlot(reinterpret_cast<Object**>(addr));
+    });
+    RememberedSet<OLD_TO_NEW>::IterateTyped(
+        heap(), [this, &visitor](SlotType type, Address host_addr,
+                                 Address addr) {
+          return UpdateTypedSlotHelper::UpdateTypedSlot(
+              isolate(), type, addr, [&visitor](Object** slot) {
+                return visitor.VisitOldToNewSlot(slot);
+              });
+        });
+    ProcessMarkingDequeInYoungGeneration(&visitor);
+  }
+
+  {
+    // Mirrors the treatment of weak global handles in Heap::Scavenge: pending
+    // handles keep their objects alive until the callbacks ran.
+    TRACE_GC(heap()->tracer(), GCTracer::Scope::MINOR_MC_MARK_WEAK);
+    if (FLAG_scavenge_reclaim_unmodified_objects) {
+      global_handles->MarkNewSpaceWeakUnmodifiedObjectsPending(
+          &IsUnmarkedObjectInYoungGeneration);
+      global_handles->IterateNewSpaceWeakUnmodifiedRoots(&visitor);
+      ProcessMarkingDequeInYoungGeneration(&visitor);
+    } else {
+      while (global_handles->IterateObjectGroups(
+          &visitor, &IsUnmarkedObjectInYoungGeneration)) {
+        ProcessMarkingDequeInYoungGeneration(&visitor);
+      }
+      global_handles->RemoveObjectGroups();
+      global_handles->RemoveImplicitRefGroups();
+
+      global_handles->IdentifyNewSpaceWeakIndependentHandles(
+          &IsUnmarkedObjectInYoungGeneration);
+      global_handles->IterateNewSpaceWeakIndependentRoots(&visitor);
+      ProcessMarkingDequeInYoungGeneration(&visitor);
+    }
+  }
+
+  DCHECK(marking_deque_.IsEmpty());
+  marking_deque_.Uninitialize();
+}
+
+
 void MarkCompactCollector::ClearNonLiveReferences() {
   TRACE_GC(heap()->tracer(), GCTracer::Scope::MC_CLEAR);
 
@@ -3800,6 +4028,109 @@ void MarkCompactCollector::UpdatePointersAfterEvacuation() {
 }
 
 
+// Returns true if |object| was in new space when the young generation
+// evacuation started.
+static bool WasInYoungGeneration(HeapObject* object) {
+  MemoryChunk* chunk = MemoryChunk::FromAddress(object->address());
+  return chunk->InFromSpace() ||
+         chunk->IsFlagSet(Page::PAGE_NEW_NEW_PROMOTION) ||
+         chunk->IsFlagSet(Page::PAGE_NEW_OLD_PROMOTION);
+}
+
+// Retains the live objects of the young generation at their new location.
+// Only valid as long as the pages promoted as a whole still carry their mark
+// bits.
+class YoungGenerationWeakObjectRetainer : public WeakObjectRetainer {
+ public:
+  virtual Object* RetainAs(Object* object) {
+    if (!object->IsHeapObject()) return object;
+    HeapObject* heap_object = HeapObject::cast(object);
+    if (!WasInYoungGeneration(heap_object)) return object;
+    MapWord map_word = heap_object->map_word();
+    if (map_word.IsForwardingAddress()) {
+      return map_word.ToForwardingAddress();
+    }
+    if (Marking::IsBlack(ObjectMarking::MarkBitFrom(heap_object))) {
+      return object;
+    }
+    return NULL;
+  }
+};
+
+static String* UpdateYoungReferenceInExternalStringTableEntry(Heap* heap,
+                                                              Object** p) {
+  HeapObject* object = HeapObject::cast(*p);
+  MapWord map_word = object->map_word();
+  if (map_word.IsForwardingAddress()) {
+    return String::cast(map_word.ToForwardingAddress());
+  }
+  // Strings on pages that were promoted as a whole are still marked.
+  if (Marking::IsBlack(ObjectMarking::MarkBitFrom(object))) {
+    return String::cast(object);
+  }
+  heap->FinalizeExternalString(String::cast(object));
+  return NULL;
+}
+
+void MarkCompactCollector::EvacuateYoungGeneration() {
+  TRACE_GC(heap()->tracer(), GCTracer::Scope::MINOR_MC_EVACUATE);
+  DCHECK(evacuation_candidates_.is_empty());
+
+  {
+    EvacuationScope evacuation_scope(this);
+    EvacuateNewSpacePrologue();
+    EvacuatePagesInParallel();
+    heap()->new_space()->set_age_mark(heap()->new_space()->top());
+  }
+
+  {
+    TRACE_GC(heap()->tracer(), GCTracer::Scope::MINOR_MC_UPDATE_POINTERS);
+    PointersUpdatingVisitor updating_visitor;
+    UpdateToSpacePointersInParallel(heap_, &page_parallel_job_semaphore_);
+    heap_->IterateRoots(&updating_visitor, VISIT_ALL_IN_SWEEP_NEWSPACE);
+    UpdatePointersInParallel<OLD_TO_NEW>(heap_, &page_parallel_job_semaphore_);
+
+    // Both of the following rely on the mark bits of promoted pages, so they
+    // have to run before these pages are swept.
+    heap_->UpdateNewSpaceReferencesInExternalStringTable(
+        &UpdateYoungReferenceInExternalStringTableEntry);
+    YoungGenerationWeakObjectRetainer retainer;
+    heap_->ProcessYoungWeakReferences(&retainer);
+  }
+
+  if (!heap()->new_space()->Rebalance()) {
+    FatalProcessOutOfMemory("NewSpace::Rebalance");
+  }
+  heap()->memory_allocator()->unmapper()->FreeQueuedChunks();
+
+  {
+    TRACE_GC(heap()->tracer(), GCTracer::Scope::MINOR_MC_CLEAN_UP);
+    const Sweeper::FreeSpaceTreatmentMode free_space_mode =
+        Heap::ShouldZapGarbage() ? Sweeper::ZAP_FREE_SPACE
+                                 : Sweeper::IGNORE_FREE_SPACE;
+    for (Page* p : newspace_evacuation_candidates_) {
+      if (p->IsFlagSet(Page::PAGE_NEW_NEW_PROMOTION)) {
+        p->ClearFlag(Page::PAGE_NEW_NEW_PROMOTION);
+        // New space pages are not swept concurrently outside of full GCs.
+        p->concurrent_sweeping_state().SetValue(Page::kSweepingInProgress);
+        Sweeper::RawSweep(p, Sweeper::IGNORE_FREE_LIST, free_space_mode);
+      } else if (p->IsFlagSet(Page::PAGE_NEW_OLD_PROMOTION)) {
+        p->ClearFlag(Page::PAGE_NEW_OLD_PROMOTION);
+        if (sweeper().sweeping_in_progress()) {
+          sweeper().AddLatePage(p->owner()->identity(), p);
+        } else {
+          // The dead objects are turned into fillers. Their memory is only
+          // handed to the free list by the next full GC.
+          p->concurrent_sweeping_state().SetValue(Page::kSweepingInProgress);
+          Sweeper::RawSweep(p, Sweeper::IGNORE_FREE_LIST, free_space_mode);
+        }
+      }
+    }
+    newspace_evacuation_candidates_.Rewind(0);
+  }
+}
+
+
 void MarkCompactCollector::ReleaseEvacuationCandidates() {
   for (Page* p : evacuation_candidates_) {
     if (!p->IsEvacuationCandidate()) continue;
@@ -27,6 +27,7 @@ typedef void (*MarkObjectFunction)(Heap* heap, HeapObject* object);
 class CodeFlusher;
 class MarkCompactCollector;
 class MarkingVisitor;
+class ParallelMarking;
 class RootMarkingVisitor;
 
 class ObjectMarking : public AllStatic {
@@ -67,6 +68,11 @@ class MarkingDeque {
 
   inline bool IsEmpty() { return top_ == bottom_; }
 
+  // Returns true if at least three quarters of the deque are in use.
+  inline bool IsNearlyFull() {
+    return 4 * ((top_ - bottom_) & mask_) >= 3 * mask_;
+  }
+
   bool overflowed() const { return overflowed_; }
 
   bool in_use() const { return in_use_; }
@@ -151,10 +157,15 @@ class CodeFlusher {
   inline void AddCandidate(SharedFunctionInfo* shared_info);
   inline void AddCandidate(JSFunction* function);
 
+  // Interpreted functions all share the entry trampoline, so their candidates
+  // cannot be linked through the code object and are kept in a side list.
+  inline void AddBytecodeCandidate(SharedFunctionInfo* shared_info);
+
   void EvictCandidate(SharedFunctionInfo* shared_info);
   void EvictCandidate(JSFunction* function);
 
   void ProcessCandidates() {
+    ProcessBytecodeCandidates();
     ProcessSharedFunctionInfoCandidates();
     ProcessJSFunctionCandidates();
   }
@@ -164,6 +175,7 @@ class CodeFlusher {
  private:
   void ProcessJSFunctionCandidates();
   void ProcessSharedFunctionInfoCandidates();
+  void ProcessBytecodeCandidates();
 
   static inline JSFunction** GetNextCandidateSlot(JSFunction* candidate);
   static inline JSFunction* GetNextCandidate(JSFunction* candidate);
@@ -181,6 +193,7 @@ class CodeFlusher {
   Isolate* isolate_;
   JSFunction* jsfunction_candidates_head_;
   SharedFunctionInfo* shared_function_info_candidates_head_;
+  List<SharedFunctionInfo*> bytecode_candidates_;
 
   DISALLOW_COPY_AND_ASSIGN(CodeFlusher);
 };
@@ -369,6 +382,12 @@ class MarkCompactCollector {
   // Performs a global garbage collection.
   void CollectGarbage();
 
+  // Performs a garbage collection of the young generation only. Live objects
+  // are marked starting from roots and the OLD_TO_NEW remembered set, and are
+  // then evacuated or promoted page by page. Requires that incremental
+  // marking is stopped. Used with --minor_mc.
+  void CollectYoungGeneration();
+
   enum CompactionMode { INCREMENTAL_COMPACTION, NON_INCREMENTAL_COMPACTION };
 
   bool StartCompaction(CompactionMode mode);
@@ -463,6 +482,9 @@ class MarkCompactCollector {
 
   MarkingDeque* marking_deque() { return &marking_deque_; }
 
+  // Null unless --parallel_marking is on.
+  ParallelMarking* parallel_marking() { return parallel_marking_; }
+
   static const size_t kMaxMarkingDequeSize = 4 * MB;
   static const size_t kMinMarkingDequeSize = 256 * KB;
 
@@ -508,6 +530,7 @@ class MarkCompactCollector {
   class EvacuateVisitorBase;
   class HeapObjectVisitor;
   class ObjectStatsVisitor;
+  class YoungGenerationMarkingVisitor;
 
   explicit MarkCompactCollector(Heap* heap);
 
@@ -601,6 +624,10 @@ class MarkCompactCollector {
   // overflow flag will be set.
   void EmptyMarkingDeque();
 
+  // Same as EmptyMarkingDeque but computes the closure using background tasks
+  // in addition to the main thread. Used with --parallel_marking.
+  void EmptyMarkingDequeInParallel();
+
   // Refill the marking stack with overflowed objects from the heap.  This
   // function either leaves the marking stack full or clears the overflow
   // flag on the marking stack.
@@ -618,6 +645,19 @@ class MarkCompactCollector {
   // heap object.
   static bool IsUnmarkedHeapObject(Object** p);
 
+  // Marks the objects in new space that are reachable from roots and from the
+  // OLD_TO_NEW remembered set. Objects outside of new space are not marked.
+  void MarkLiveObjectsInYoungGeneration();
+
+  // Same as ProcessMarkingDeque but only visits and refills objects in new
+  // space.
+  void ProcessMarkingDequeInYoungGeneration(
+      YoungGenerationMarkingVisitor* visitor);
+
+  // Callback function for telling whether the object *p is an unmarked object
+  // in new space.
+  static bool IsUnmarkedObjectInYoungGeneration(Heap* heap, Object** p);
+
   // Clear non-live references in weak cells, transition and descriptor arrays,
   // and deoptimize dependent code of non-live maps.
   void ClearNonLiveReferences();
@@ -681,6 +721,10 @@ class MarkCompactCollector {
 
   void UpdatePointersAfterEvacuation();
 
+  // Evacuates the marked objects of the young generation and updates the
+  // pointers to them. Pages that are promoted as a whole are swept.
+  void EvacuateYoungGeneration();
+
   // Iterates through all live objects on a page using marking information.
   // Returns whether all objects have successfully been visited.
   template <class Visitor>
@@ -741,6 +785,8 @@ class MarkCompactCollector {
   MarkingDeque marking_deque_;
   std::vector<std::pair<void*, void*>> wrappers_to_trace_;
 
+  ParallelMarking* parallel_marking_;
+
   CodeFlusher* code_flusher_;
 
   EmbedderHeapTracer* embedder_heap_tracer_;
@@ -5,6 +5,7 @@
 #ifndef V8_MARKING_H
 #define V8_MARKING_H
 
+#include "src/base/atomicops.h"
 #include "src/utils.h"
 
 namespace v8 {
@@ -14,6 +15,11 @@ class MarkBit {
  public:
   typedef uint32_t CellType;
 
+  // Mark bits that may be updated by several marking threads at the same time
+  // have to be accessed with ATOMIC. The main-thread-only paths keep using the
+  // cheaper NON_ATOMIC variants.
+  enum AccessMode { NON_ATOMIC, ATOMIC };
+
   inline MarkBit(CellType* cell, CellType mask) : cell_(cell), mask_(mask) {}
 
 #ifdef DEBUG
@@ -35,9 +41,17 @@ class MarkBit {
     }
   }
 
-  inline void Set() { *cell_ |= mask_; }
-  inline bool Get() { return (*cell_ & mask_) != 0; }
-  inline void Clear() { *cell_ &= ~mask_; }
+  // Sets the bit and returns true iff the bit was not set before, i.e., the
+  // caller is the one that changed it.
+  template <AccessMode mode = NON_ATOMIC>
+  inline bool Set();
+
+  template <AccessMode mode = NON_ATOMIC>
+  inline bool Get();
+
+  // Clears the bit and returns true iff the bit was set before.
+  template <AccessMode mode = NON_ATOMIC>
+  inline bool Clear();
 
   CellType* cell_;
   CellType mask_;
@@ -46,6 +60,59 @@ class MarkBit {
   friend class Marking;
 };
 
+template <>
+inline bool MarkBit::Set<MarkBit::NON_ATOMIC>() {
+  CellType old_value = *cell_;
+  *cell_ = old_value | mask_;
+  return (old_value & mask_) == 0;
+}
+
+template <>
+inline bool MarkBit::Set<MarkBit::ATOMIC>() {
+  base::Atomic32* cell = reinterpret_cast<base::Atomic32*>(cell_);
+  base::Atomic32 old_value;
+  base::Atomic32 new_value;
+  do {
+    old_value = base::NoBarrier_Load(cell);
+    if (old_value & mask_) return false;
+    new_value = old_value | mask_;
+  } while (base::Release_CompareAndSwap(cell, old_value, new_value) !=
+           old_value);
+  return true;
+}
+
+template <>
+inline bool MarkBit::Clear<MarkBit::NON_ATOMIC>() {
+  CellType old_value = *cell_;
+  *cell_ = old_value & ~mask_;
+  return (old_value & mask_) != 0;
+}
+
+template <>
+inline bool MarkBit::Clear<MarkBit::ATOMIC>() {
+  base::Atomic32* cell = reinterpret_cast<base::Atomic32*>(cell_);
+  base::Atomic32 old_value;
+  base::Atomic32 new_value;
+  do {
+    old_value = base::NoBarrier_Load(cell);
+    if (!(old_value & mask_)) return false;
+    new_value = old_value & ~mask_;
+  } while (base::Release_CompareAndSwap(cell, old_value, new_value) !=
+           old_value);
+  return true;
+}
+
+template <>
+inline bool MarkBit::Get<MarkBit::NON_ATOMIC>() {
+  return (*cell_ & mask_) != 0;
+}
+
+template <>
+inline bool MarkBit::Get<MarkBit::ATOMIC>() {
+  return (base::Acquire_Load(reinterpret_cast<base::Atomic32*>(cell_)) &
+          mask_) != 0;
+}
+
 // Bitmap is a sequence of cells each containing fixed number of bits.
 class Bitmap {
  public:
@@ -106,7 +173,9 @@ class Bitmap {
     for (int i = 0; i < CellsCount(); i++) cells()[i] = 0;
   }
 
-  // Sets all bits in the range [start_index, end_index).
+  // Sets all bits in the range [start_index, end_index). The partially
+  // covered first and last cells may be shared with objects that concurrent
+  // markers update and are therefore changed atomically.
   void SetRange(uint32_t start_index, uint32_t end_index) {
     unsigned int start_cell_index = start_index >> Bitmap::kBitsPerCellLog2;
     MarkBit::CellType start_index_mask = 1u << Bitmap::IndexInCell(start_index);
@@ -117,19 +186,20 @@ class Bitmap {
     if (start_cell_index != end_cell_index) {
       // Firstly, fill all bits from the start address to the end of the first
       // cell with 1s.
-      cells()[start_cell_index] |= ~(start_index_mask - 1);
+      SetBitsInCell(start_cell_index, ~(start_index_mask - 1));
       // Then fill all in between cells with 1s.
       for (unsigned int i = start_cell_index + 1; i < end_cell_index; i++) {
         cells()[i] = ~0u;
       }
       // Finally, fill all bits until the end address in the last cell with 1s.
-      cells()[end_cell_index] |= (end_index_mask - 1);
+      SetBitsInCell(end_cell_index, end_index_mask - 1);
     } else {
-      cells()[start_cell_index] |= end_index_mask - start_index_mask;
+      SetBitsInCell(start_cell_index, end_index_mask - start_index_mask);
     }
   }
 
-  // Clears all bits in the range [start_index, end_index).
+  // Clears all bits in the range [start_index, end_index). See SetRange for
+  // the treatment of the first and last cell.
   void ClearRange(uint32_t start_index, uint32_t end_index) {
     unsigned int start_cell_index = start_index >> Bitmap::kBitsPerCellLog2;
     MarkBit::CellType start_index_mask = 1u << Bitmap::IndexInCell(start_index);
@@ -140,15 +210,15 @@ class Bitmap {
     if (start_cell_index != end_cell_index) {
       // Firstly, fill all bits from the start address to the end of the first
       // cell with 0s.
-      cells()[start_cell_index] &= (start_index_mask - 1);
+      ClearBitsInCell(start_cell_index, ~(start_index_mask - 1));
       // Then fill all in between cells with 0s.
       for (unsigned int i = start_cell_index + 1; i < end_cell_index; i++) {
         cells()[i] = 0;
       }
       // Finally, set all bits until the end address in the last cell with 0s.
-      cells()[end_cell_index] &= ~(end_index_mask - 1);
+      ClearBitsInCell(end_cell_index, end_index_mask - 1);
     } else {
-      cells()[start_cell_index] &= ~(end_index_mask - start_index_mask);
+      ClearBitsInCell(start_cell_index, end_index_mask - start_index_mask);
     }
   }
 
@@ -265,6 +335,27 @@ class Bitmap {
     }
     return true;
   }
+
+ private:
+  void SetBitsInCell(uint32_t cell_index, MarkBit::CellType mask) {
+    base::Atomic32* cell = reinterpret_cast<base::Atomic32*>(cells()) +
+                           cell_index;
+    base::Atomic32 old_value;
+    do {
+      old_value = base::NoBarrier_Load(cell);
+    } while (base::Release_CompareAndSwap(cell, old_value, old_value | mask) !=
+             old_value);
+  }
+
+  void ClearBitsInCell(uint32_t cell_index, MarkBit::CellType mask) {
+    base::Atomic32* cell = reinterpret_cast<base::Atomic32*>(cells()) +
+                           cell_index;
+    base::Atomic32 old_value;
+    do {
+      old_value = base::NoBarrier_Load(cell);
+    } while (base::Release_CompareAndSwap(cell, old_value, old_value & ~mask) !=
+             old_value);
+  }
 };
 
 class Marking : public AllStatic {
@@ -298,6 +389,48 @@ class Marking : public AllStatic {
   // objects.
   INLINE(static bool IsBlackOrGrey(MarkBit mark_bit)) { return mark_bit.Get(); }
 
+  // Variants of the color predicates and transitions that are safe to use
+  // while other threads mark objects on the same page. The first mark bit is
+  // the one that decides ownership: only the thread that flips it from white
+  // to grey may push the object and account its live bytes.
+  template <MarkBit::AccessMode mode>
+  INLINE(static bool IsWhite(MarkBit mark_bit)) {
+    return !mark_bit.Get<mode>();
+  }
+
+  template <MarkBit::AccessMode mode>
+  INLINE(static bool IsBlack(MarkBit mark_bit)) {
+    return mark_bit.Get<mode>() && mark_bit.Next().Get<mode>();
+  }
+
+  template <MarkBit::AccessMode mode>
+  INLINE(static bool IsGrey(MarkBit mark_bit)) {
+    return mark_bit.Get<mode>() && !mark_bit.Next().Get<mode>();
+  }
+
+  template <MarkBit::AccessMode mode>
+  INLINE(static bool TryWhiteToGrey(MarkBit markbit)) {
+    return markbit.Set<mode>();
+  }
+
+  template <MarkBit::AccessMode mode>
+  INLINE(static bool TryGreyToBlack(MarkBit markbit)) {
+    return markbit.Next().Set<mode>();
+  }
+
+  template <MarkBit::AccessMode mode>
+  INLINE(static void MarkBlack(MarkBit mark_bit)) {
+    mark_bit.Set<mode>();
+    mark_bit.Next().Set<mode>();
+  }
+
+  // Returns true iff the object was black before.
+  template <MarkBit::AccessMode mode>
+  INLINE(static bool AnyToGrey(MarkBit markbit)) {
+    markbit.Set<mode>();
+    return markbit.Next().Clear<mode>();
+  }
+
   INLINE(static void MarkBlack(MarkBit mark_bit)) {
     mark_bit.Set();
     mark_bit.Next().Set();
@@ -438,6 +438,10 @@ void StaticMarkingVisitor<StaticVisitor>::VisitCode(Map* map,
   if (FLAG_age_code && !heap->isolate()->serializer_enabled()) {
     code->MakeOlder(heap->mark_compact_collector()->marking_parity());
   }
+  if (code->kind() == Code::OPTIMIZED_FUNCTION &&
+      heap->mark_compact_collector()->is_code_flushing_enabled()) {
+    MarkDeoptimizationBytecode(heap, code);
+  }
   CodeBodyVisitor::Visit(map, object);
 }
 
@@ -458,6 +462,16 @@ void StaticMarkingVisitor<StaticVisitor>::VisitSharedFunctionInfo(
   }
   MarkCompactCollector* collector = heap->mark_compact_collector();
   if (collector->is_code_flushing_enabled()) {
+    if (IsFlushableBytecode(heap, shared)) {
+      // Interpreted functions share the entry trampoline, so it is the
+      // bytecode that gets flushed. Like for code below, the decision is
+      // postponed until marking is done, because optimized code and
+      // activations on the stack keep the bytecode alive.
+      collector->code_flusher()->AddBytecodeCandidate(shared);
+      // Treat the reference to the bytecode array weakly.
+      VisitSharedFunctionInfoWeakBytecode(heap, object);
+      return;
+    }
     if (IsFlushable(heap, shared)) {
       // This function's code looks flushable. But we have to postpone
       // the decision until we see all functions that point to the same
@@ -514,8 +528,12 @@ void StaticMarkingVisitor<StaticVisitor>::VisitJSRegExp(Map* map,
 template <typename StaticVisitor>
 void StaticMarkingVisitor<StaticVisitor>::VisitBytecodeArray(
     Map* map, HeapObject* object) {
+  Heap* heap = map->GetHeap();
+  if (FLAG_age_code && !heap->isolate()->serializer_enabled()) {
+    BytecodeArray::cast(object)->MakeOlder();
+  }
   StaticVisitor::VisitPointers(
-      map->GetHeap(), object,
+      heap, object,
       HeapObject::RawField(object, BytecodeArray::kConstantPoolOffset),
       HeapObject::RawField(object, BytecodeArray::kFrameSizeOffset));
 }
@@ -568,6 +586,13 @@ bool StaticMarkingVisitor<StaticVisitor>::IsFlushable(Heap* heap,
                                                       JSFunction* function) {
   SharedFunctionInfo* shared_info = function->shared();
 
+  // Closures running in the interpreter are reset together with the bytecode
+  // of their shared function info.
+  if (function->code()->is_interpreter_trampoline_builtin()) {
+    return function->code() == shared_info->code() &&
+           IsFlushableBytecode(heap, shared_info);
+  }
+
   // Code is either on stack, in compilation cache or referenced
   // by optimized version of function.
   MarkBit code_mark = ObjectMarking::MarkBitFrom(function->code());
@@ -657,6 +682,68 @@ bool StaticMarkingVisitor<StaticVisitor>::IsFlushable(
 }
 
 
+template <typename StaticVisitor>
+bool StaticMarkingVisitor<StaticVisitor>::IsFlushableBytecode(
+    Heap* heap, SharedFunctionInfo* shared_info) {
+  if (!FLAG_flush_bytecode || !FLAG_age_code) return false;
+
+  // Only flush bytecode of functions that run in the interpreter.
+  if (!shared_info->HasBytecodeArray() ||
+      !shared_info->code()->is_interpreter_trampoline_builtin()) {
+    return false;
+  }
+
+  // Bytecode is either on stack, in compilation cache or referenced by
+  // optimized code that deoptimizes to it.
+  BytecodeArray* bytecode = shared_info->bytecode_array();
+  MarkBit bytecode_mark = ObjectMarking::MarkBitFrom(bytecode);
+  if (Marking::IsBlackOrGrey(bytecode_mark)) {
+    return false;
+  }
+
+  // The source code must be available to be able to recompile the function
+  // in case we need it again.
+  if (!HasSourceCode(heap, shared_info)) {
+    return false;
+  }
+
+  // The same restrictions as for flushing baseline code apply.
+  if (!shared_info->allows_lazy_compilation() || shared_info->is_resumable() ||
+      shared_info->is_toplevel() || shared_info->IsBuiltin() ||
+      shared_info->HasDebugInfo() || shared_info->dont_flush()) {
+    return false;
+  }
+
+  // When the heap tries to reduce memory, e.g. for GCs started by the memory
+  // reducer or under memory pressure, flush all bytecode that didn't run since
+  // the last full GC instead of waiting for it to become old.
+  if (heap->ShouldReduceMemory()) {
+    return bytecode->bytecode_age() > BytecodeArray::kNoAgeBytecodeAge;
+  }
+
+  return bytecode->IsOld();
+}
+
+
+template <typename StaticVisitor>
+void StaticMarkingVisitor<StaticVisitor>::MarkDeoptimizationBytecode(
+    Heap* heap, Code* code) {
+  DCHECK_EQ(Code::OPTIMIZED_FUNCTION, code->kind());
+  FixedArray* raw_data = code->deoptimization_data();
+  if (raw_data->length() == 0) return;
+  DeoptimizationInputData* data = DeoptimizationInputData::cast(raw_data);
+  FixedArray* literals = data->LiteralArray();
+  int const inlined_count = data->InlinedFunctionCount()->value();
+  for (int i = -1; i < inlined_count; ++i) {
+    SharedFunctionInfo* shared = SharedFunctionInfo::cast(
+        i < 0 ? data->SharedFunctionInfo() : literals->get(i));
+    if (shared->HasBytecodeArray()) {
+      StaticVisitor::MarkObject(heap, shared->bytecode_array());
+    }
+  }
+}
+
+
 template <typename StaticVisitor>
 void StaticMarkingVisitor<StaticVisitor>::VisitSharedFunctionInfoStrongCode(
     Heap* heap, HeapObject* object) {
@@ -689,6 +776,26 @@ void StaticMarkingVisitor<StaticVisitor>::VisitSharedFunctionInfoWeakCode(
 }
 
 
+template <typename StaticVisitor>
+void StaticMarkingVisitor<StaticVisitor>::VisitSharedFunctionInfoWeakBytecode(
+    Heap* heap, HeapObject* object) {
+  Object** start_slot = HeapObject::RawField(
+      object, SharedFunctionInfo::BodyDescriptor::kStartOffset);
+  Object** end_slot =
+      HeapObject::RawField(object, SharedFunctionInfo::kFunctionDataOffset);
+  StaticVisitor::VisitPointers(heap, object, start_slot, end_slot);
+
+  // Skip visiting kFunctionDataOffset as it is treated weakly here.
+  STATIC_ASSERT(SharedFunctionInfo::kFunctionDataOffset + kPointerSize ==
+                SharedFunctionInfo::kScriptOffset);
+
+  start_slot = HeapObject::RawField(object, SharedFunctionInfo::kScriptOffset);
+  end_slot = HeapObject::RawField(
+      object, SharedFunctionInfo::BodyDescriptor::kEndOffset);
+  StaticVisitor::VisitPointers(heap, object, start_slot, end_slot);
+}
+
+
 template <typename StaticVisitor>
 void StaticMarkingVisitor<StaticVisitor>::VisitJSFunctionStrongCode(
     Map* map, HeapObject* object) {
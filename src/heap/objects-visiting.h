@@ -387,11 +387,19 @@ class StaticMarkingVisitor : public StaticVisitorBase {
   // Code flushing support.
   INLINE(static bool IsFlushable(Heap* heap, JSFunction* function));
   INLINE(static bool IsFlushable(Heap* heap, SharedFunctionInfo* shared_info));
+  INLINE(static bool IsFlushableBytecode(Heap* heap,
+                                         SharedFunctionInfo* shared_info));
+
+  // Mark the bytecode that optimized {code} deoptimizes to, for the function
+  // itself and all functions inlined into it.
+  static void MarkDeoptimizationBytecode(Heap* heap, Code* code);
 
   // Helpers used by code flushing support that visit pointer fields and treat
   // references to code objects either strongly or weakly.
   static void VisitSharedFunctionInfoStrongCode(Heap* heap, HeapObject* object);
   static void VisitSharedFunctionInfoWeakCode(Heap* heap, HeapObject* object);
+  static void VisitSharedFunctionInfoWeakBytecode(Heap* heap,
+                                                  HeapObject* object);
   static void VisitJSFunctionStrongCode(Map* map, HeapObject* object);
   static void VisitJSFunctionWeakCode(Map* map, HeapObject* object);
 
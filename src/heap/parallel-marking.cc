@@ -0,0 +1,226 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/heap/parallel-marking.h"
+
+#include "src/cancelable-task.h"
+#include "src/heap/heap-inl.h"
+#include "src/heap/heap.h"
+#include "src/heap/mark-compact-inl.h"
+#include "src/heap/mark-compact.h"
+#include "src/heap/objects-visiting.h"
+#include "src/heap/remembered-set.h"
+#include "src/heap/spaces-inl.h"
+#include "src/isolate.h"
+#include "src/v8.h"
+
+namespace v8 {
+namespace internal {
+
+// Marks the strong pointer fields of an object and records slots that point
+// into evacuation candidates. Only used for objects that do not need special
+// treatment, see ParallelMarking::IsBailoutObject.
+class ParallelMarking::Visitor : public ObjectVisitor {
+ public:
+  Visitor(Heap* heap, MarkingWorklist* shared, MarkingWorklist* bailout,
+          int task_id, TaskState* state)
+      : heap_(heap),
+        shared_(shared, task_id),
+        bailout_(bailout, task_id),
+        state_(state),
+        host_(nullptr) {}
+
+  void VisitPointers(Object** start, Object** end) override {
+    for (Object** p = start; p < end; p++) {
+      Object* object = *p;
+      if (!object->IsHeapObject()) continue;
+      HeapObject* target = HeapObject::cast(object);
+      RecordSlot(p, target);
+      MarkObject(target);
+    }
+  }
+
+  void VisitObject(HeapObject* object) {
+    Map* map = object->map();
+    MarkObject(map);
+    if (IsBailoutObject(heap_, map)) {
+      bailout_.Push(object);
+      return;
+    }
+    host_ = object;
+    object->IterateBody(map->instance_type(), object->SizeFromMap(map), this);
+    host_ = nullptr;
+    state_->visited_objects++;
+  }
+
+  bool Pop(HeapObject** object) { return shared_.Pop(object); }
+
+  void Flush() {
+    shared_.FlushToGlobal();
+    bailout_.FlushToGlobal();
+  }
+
+ private:
+  void MarkObject(HeapObject* object) {
+    MarkBit mark_bit = ObjectMarking::MarkBitFrom(object);
+    if (!Marking::TryWhiteToGrey<MarkBit::ATOMIC>(mark_bit)) return;
+    // The grey to black transition cannot fail as only the task that won the
+    // white to grey transition gets here.
+    Marking::TryGreyToBlack<MarkBit::ATOMIC>(mark_bit);
+    int size = object->Size();
+    state_->live_bytes[MemoryChunk::FromAddress(object->address())] += size;
+    state_->marked_bytes += size;
+    shared_.Push(object);
+  }
+
+  void RecordSlot(Object** slot, HeapObject* target) {
+    DCHECK_NOT_NULL(host_);
+    Page* target_page = Page::FromAddress(target->address());
+    if (target_page->IsEvacuationCandidate() &&
+        !MarkCompactCollector::ShouldSkipEvacuationSlotRecording(host_)) {
+      Page* source_page = Page::FromAddress(host_->address());
+      state_->recorded_slots.push_back(
+          std::make_pair(source_page, reinterpret_cast<Address>(slot)));
+    }
+  }
+
+  Heap* heap_;
+  MarkingWorklist::View shared_;
+  MarkingWorklist::View bailout_;
+  TaskState* state_;
+  HeapObject* host_;
+};
+
+class ParallelMarking::Task : public CancelableTask {
+ public:
+  Task(Isolate* isolate, ParallelMarking* marking, int task_id,
+       base::Semaphore* on_finish)
+      : CancelableTask(isolate),
+        marking_(marking),
+        task_id_(task_id),
+        on_finish_(on_finish) {}
+
+  virtual ~Task() {}
+
+ private:
+  // v8::internal::CancelableTask overrides.
+  void RunInternal() override {
+    marking_->MarkObjects(task_id_, &marking_->task_state_[task_id_]);
+    on_finish_->Signal();
+  }
+
+  ParallelMarking* marking_;
+  int task_id_;
+  base::Semaphore* on_finish_;
+
+  DISALLOW_COPY_AND_ASSIGN(Task);
+};
+
+ParallelMarking::ParallelMarking(Heap* heap)
+    : heap_(heap), posted_tasks_(0), pending_task_semaphore_(0) {}
+
+bool ParallelMarking::IsBailoutObject(Heap* heap, Map* map) {
+  switch (static_cast<StaticVisitorBase::VisitorId>(map->visitor_id())) {
+    case StaticVisitorBase::kVisitAllocationSite:
+    case StaticVisitorBase::kVisitBytecodeArray:
+    case StaticVisitorBase::kVisitCode:
+    case StaticVisitorBase::kVisitJSFunction:
+    case StaticVisitorBase::kVisitJSRegExp:
+    case StaticVisitorBase::kVisitJSWeakCollection:
+    case StaticVisitorBase::kVisitMap:
+    case StaticVisitorBase::kVisitNativeContext:
+    case StaticVisitorBase::kVisitPropertyCell:
+    case StaticVisitorBase::kVisitSharedFunctionInfo:
+    case StaticVisitorBase::kVisitTransitionArray:
+    case StaticVisitorBase::kVisitWeakCell:
+      return true;
+    default:
+      break;
+  }
+  // Wrappers have to be registered with the embedder heap tracer.
+  return heap->UsingEmbedderHeapTracer() &&
+         map->visitor_id() >= StaticVisitorBase::kVisitJSApiObject &&
+         map->visitor_id() <= StaticVisitorBase::kVisitJSApiObjectGeneric;
+}
+
+int ParallelMarking::NumberOfTasks() {
+  // Only start as many tasks as there are segments to steal. The main thread
+  // is always one of the tasks.
+  const int available_cores = static_cast<int>(
+      V8::GetCurrentPlatform()->NumberOfAvailableBackgroundThreads());
+  const int segments = static_cast<int>(shared_.GlobalPoolSize() /
+                                        MarkingWorklist::kSegmentCapacity);
+  const int wanted = FLAG_parallel_marking_tasks > 0
+                         ? FLAG_parallel_marking_tasks
+                         : available_cores + 1;
+  return Max(1, Min(Min(wanted, kMaxTasks), segments));
+}
+
+void ParallelMarking::MarkObjects(int task_id, TaskState* state) {
+  Visitor visitor(heap_, &shared_, &bailout_, task_id, state);
+  HeapObject* object = nullptr;
+  while (visitor.Pop(&object)) {
+    DCHECK(object->IsHeapObject());
+    DCHECK(!object->IsFiller());
+    DCHECK(Marking::IsBlack(ObjectMarking::MarkBitFrom(object)));
+    visitor.VisitObject(object);
+  }
+  visitor.Flush();
+}
+
+void ParallelMarking::FinalizeTaskState(TaskState* state) {
+  for (auto& pair : state->live_bytes) {
+    pair.first->IncrementLiveBytes(static_cast<int>(pair.second));
+  }
+  for (auto& pair : state->recorded_slots) {
+    RememberedSet<OLD_TO_OLD>::Insert(pair.first, pair.second);
+  }
+  state->live_bytes.clear();
+  state->recorded_slots.clear();
+  state->marked_bytes = 0;
+  state->visited_objects = 0;
+}
+
+void ParallelMarking::MarkTransitiveClosure(MarkingDeque* marking_deque) {
+  MarkingWorklist::View main_view(&shared_, kMainThreadTask);
+  while (!marking_deque->IsEmpty()) {
+    main_view.Push(marking_deque->Pop());
+  }
+  main_view.FlushToGlobal();
+
+  const int num_tasks = NumberOfTasks();
+  uint32_t task_ids[kMaxTasks];
+  for (int i = 1; i < num_tasks; i++) {
+    Task* task = new Task(heap_->isolate(), this, i, &pending_task_semaphore_);
+    task_ids[i] = task->id();
+    V8::GetCurrentPlatform()->CallOnBackgroundThread(
+        task, v8::Platform::kShortRunningTask);
+    posted_tasks_++;
+  }
+  // Contribute on the main thread.
+  MarkObjects(kMainThreadTask, &task_state_[kMainThreadTask]);
+  // Wait for the background tasks. Tasks that did not start yet are aborted;
+  // all their work has been stolen by the main thread at this point.
+  for (int i = 1; i < num_tasks; i++) {
+    if (!heap_->isolate()->cancelable_task_manager()->TryAbort(task_ids[i])) {
+      pending_task_semaphore_.Wait();
+    }
+  }
+  DCHECK(shared_.IsGlobalEmpty());
+
+  if (FLAG_trace_parallel_marking) {
+    PrintIsolate(heap_->isolate(), "parallel-marking: tasks=%d", num_tasks);
+    for (int i = 0; i < num_tasks; i++) {
+      PrintF(" task%d=(objects=%d bytes=%" V8PRIdPTR ")", i,
+             task_state_[i].visited_objects, task_state_[i].marked_bytes);
+    }
+    PrintF("\n");
+  }
+  for (int i = 0; i < num_tasks; i++) {
+    FinalizeTaskState(&task_state_[i]);
+  }
+}
+
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,97 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_HEAP_PARALLEL_MARKING_H_
+#define V8_HEAP_PARALLEL_MARKING_H_
+
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "src/allocation.h"
+#include "src/base/platform/semaphore.h"
+#include "src/heap/worklist.h"
+#include "src/utils.h"
+
+namespace v8 {
+namespace internal {
+
+class Heap;
+class HeapObject;
+class Map;
+class MarkingDeque;
+class MemoryChunk;
+class Page;
+
+// Computes the transitive closure of the marking deque during the atomic pause
+// of a full mark-compact GC using the main thread and background tasks.
+//
+// Every task owns a view of a shared work-stealing worklist. Mark bits are
+// updated atomically; the task that turns an object grey owns it, accounts its
+// live bytes and pushes it. Objects whose visitation has side effects beyond
+// marking (code flushing, weak references, transition trees, embedder
+// tracing, ...) are marked but not visited. They are handed back to the main
+// thread through PopBailoutObject() and visited by the regular marking
+// visitor.
+class ParallelMarking {
+ public:
+  typedef Worklist<HeapObject*, 64> MarkingWorklist;
+
+  static const int kMainThreadTask = 0;
+  static const int kMaxTasks = MarkingWorklist::kMaxNumTasks;
+
+  explicit ParallelMarking(Heap* heap);
+
+  // Drains |marking_deque| and marks everything reachable from it, except for
+  // what is only reachable through bailout objects.
+  void MarkTransitiveClosure(MarkingDeque* marking_deque);
+
+  // Pops an object that has to be visited on the main thread. The object is
+  // already black and its live bytes are accounted for.
+  bool PopBailoutObject(HeapObject** object) {
+    return bailout_.Pop(kMainThreadTask, object);
+  }
+
+  static bool IsBailoutObject(Heap* heap, Map* map);
+
+  // Number of background tasks posted so far. Main thread only.
+  int posted_tasks() const { return posted_tasks_; }
+
+ private:
+  class Task;
+  class Visitor;
+
+  typedef std::unordered_map<MemoryChunk*, intptr_t> LiveBytesMap;
+  typedef std::vector<std::pair<Page*, Address>> SlotList;
+
+  // State that a task accumulates without synchronization and that is merged
+  // on the main thread after all tasks have finished.
+  struct TaskState {
+    TaskState() : marked_bytes(0), visited_objects(0) {}
+    LiveBytesMap live_bytes;
+    SlotList recorded_slots;
+    intptr_t marked_bytes;
+    int visited_objects;
+  };
+
+  int NumberOfTasks();
+  void MarkObjects(int task_id, TaskState* state);
+  void FinalizeTaskState(TaskState* state);
+
+  Heap* heap_;
+  MarkingWorklist shared_;
+  MarkingWorklist bailout_;
+  TaskState task_state_[kMaxTasks];
+  int posted_tasks_;
+  // Semaphore that outlives the tasks. See PageParallelJob for why it cannot
+  // be created on demand.
+  base::Semaphore pending_task_semaphore_;
+
+  DISALLOW_COPY_AND_ASSIGN(ParallelMarking);
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_HEAP_PARALLEL_MARKING_H_
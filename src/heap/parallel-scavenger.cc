@@ -0,0 +1,348 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/heap/parallel-scavenger.h"
+
+#include <vector>
+
+#include "src/base/atomicops.h"
+#include "src/base/hashmap.h"
+#include "src/heap/heap-inl.h"
+#include "src/heap/heap.h"
+#include "src/heap/objects-visiting.h"
+#include "src/heap/page-parallel-job.h"
+#include "src/heap/remembered-set.h"
+#include "src/heap/scavenger.h"
+#include "src/heap/spaces-inl.h"
+#include "src/isolate.h"
+#include "src/v8.h"
+
+namespace v8 {
+namespace internal {
+
+// Task local part of the parallel scavenger. Copies objects into its own
+// allocation buffers and scans the objects it copied.
+class ParallelScavenger::Visitor : public ObjectVisitor {
+ public:
+  static const int kLabSize = 4 * KB;
+  static const int kMaxLabObjectSize = 256;
+
+  Visitor(Heap* heap, CopiedWorklist* copied, int task_id)
+      : heap_(heap),
+        copied_(copied, task_id),
+        old_space_(heap, OLD_SPACE, NOT_EXECUTABLE),
+        new_space_buffer_(LocalAllocationBuffer::InvalidBuffer()),
+        local_pretenuring_feedback_(base::HashMap::PointersMatch,
+                                    Heap::kInitialFeedbackCapacity),
+        record_slots_(false),
+        copied_objects_(0),
+        promoted_size_(0),
+        semispace_copied_size_(0) {}
+
+  void VisitPointers(Object** start, Object** end) override {
+    for (Object** p = start; p < end; p++) {
+      Object* object = *p;
+      if (!heap_->InFromSpace(object)) continue;
+      ScavengeObject(reinterpret_cast<HeapObject**>(p),
+                     reinterpret_cast<HeapObject*>(object));
+      if (record_slots_ && heap_->InNewSpace(*p)) {
+        recorded_slots_.push_back(reinterpret_cast<Address>(p));
+      }
+    }
+  }
+
+  // Code objects are never allocated in new space.
+  void VisitCodeEntry(Address code_entry_slot) override {}
+
+  // Scavenges the object referenced by an OLD_TO_NEW slot. Keeps the slot iff
+  // the object stays in new space.
+  SlotCallbackResult CheckAndScavengeObject(Address slot_address) {
+    Object** slot = reinterpret_cast<Object**>(slot_address);
+    Object* object = *slot;
+    if (heap_->InFromSpace(object)) {
+      ScavengeObject(reinterpret_cast<HeapObject**>(slot),
+                     reinterpret_cast<HeapObject*>(object));
+      if (heap_->InToSpace(*slot)) return KEEP_SLOT;
+    }
+    return REMOVE_SLOT;
+  }
+
+  // Scans copied objects until no task has published work anymore.
+  void ProcessCopiedObjects() {
+    HeapObject* object = nullptr;
+    while (copied_.Pop(&object)) {
+      Map* map = object->map();
+      // Only promoted objects need their slots into new space recorded.
+      record_slots_ = !heap_->InNewSpace(object);
+      object->IterateBody(map->instance_type(), object->SizeFromMap(map), this);
+      record_slots_ = false;
+    }
+  }
+
+  void FlushToGlobal() { copied_.FlushToGlobal(); }
+
+  void Finalize() {
+    new_space_buffer_ = LocalAllocationBuffer::InvalidBuffer();
+    heap_->old_space()->MergeCompactionSpace(&old_space_);
+    for (Address slot : recorded_slots_) {
+      RememberedSet<OLD_TO_NEW>::Insert(Page::FromAddress(slot), slot);
+    }
+    heap_->IncrementPromotedObjectsSize(promoted_size_);
+    heap_->IncrementSemiSpaceCopiedObjectSize(semispace_copied_size_);
+    heap_->MergeAllocationSitePretenuringFeedback(local_pretenuring_feedback_);
+  }
+
+  int copied_objects() { return copied_objects_; }
+  intptr_t promoted_size() { return promoted_size_; }
+  intptr_t semispace_copied_size() { return semispace_copied_size_; }
+
+ private:
+  static AllocationAlignment RequiredAlignment(Map* map) {
+    switch (static_cast<StaticVisitorBase::VisitorId>(map->visitor_id())) {
+      case StaticVisitorBase::kVisitFixedDoubleArray:
+      case StaticVisitorBase::kVisitFixedFloat64Array:
+        return kDoubleAligned;
+      default:
+        return kWordAligned;
+    }
+  }
+
+  // Returns false for objects that do not have to be scanned after copying.
+  static bool ContainsPointers(Map* map) {
+    int id = map->visitor_id();
+    switch (static_cast<StaticVisitorBase::VisitorId>(id)) {
+      case StaticVisitorBase::kVisitByteArray:
+      case StaticVisitorBase::kVisitFixedDoubleArray:
+      case StaticVisitorBase::kVisitSeqOneByteString:
+      case StaticVisitorBase::kVisitSeqTwoByteString:
+        return false;
+      default:
+        return id < StaticVisitorBase::kVisitDataObject ||
+               id > StaticVisitorBase::kVisitDataObjectGeneric;
+    }
+  }
+
+  // Installs a forwarding address to |target| in |object| unless another task
+  // did so first.
+  static bool TryForward(HeapObject* object, Map* map, HeapObject* target) {
+    base::AtomicWord expected = reinterpret_cast<base::AtomicWord>(map);
+    base::AtomicWord forwarding = reinterpret_cast<base::AtomicWord>(
+        MapWord::FromForwardingAddress(target).ToMap());
+    return base::Release_CompareAndSwap(
+               reinterpret_cast<base::AtomicWord*>(object->address()),
+               expected, forwarding) == expected;
+  }
+
+  void ScavengeObject(HeapObject** slot, HeapObject* object) {
+    DCHECK(heap_->InFromSpace(object));
+    MapWord first_word = object->synchronized_map_word();
+    if (first_word.IsForwardingAddress()) {
+      *slot = first_word.ToForwardingAddress();
+      return;
+    }
+    Map* map = first_word.ToMap();
+    // AllocationMementos are unrooted and shouldn't survive a scavenge
+    DCHECK(map != heap_->allocation_memento_map());
+    int size = object->SizeFromMap(map);
+    AllocationAlignment alignment = RequiredAlignment(map);
+
+    HeapObject* target = nullptr;
+    bool promoted = false;
+    if (!heap_->ShouldBePromoted<DEFAULT_PROMOTION>(object->address(), size) &&
+        AllocateInNewSpace(size, alignment).To(&target)) {
+      promoted = false;
+    } else if (old_space_.AllocateRaw(size, alignment).To(&target)) {
+      promoted = true;
+    } else if (!AllocateInNewSpace(size, alignment).To(&target)) {
+      FatalProcessOutOfMemory("ParallelScavenger: semi-space copy\n");
+    }
+
+    heap_->CopyBlock(target->address(), object->address(), size);
+    if (!TryForward(object, map, target)) {
+      // Another task copied the object concurrently. Our copy is unreachable.
+      heap_->CreateFillerObjectAt(target->address(), size,
+                                  ClearRecordedSlots::kNo);
+      *slot = object->synchronized_map_word().ToForwardingAddress();
+      return;
+    }
+    *slot = target;
+
+    // Only the task that forwarded the object accounts for it. The body of
+    // the object and a trailing memento are still intact.
+    heap_->UpdateAllocationSite<Heap::kCached>(map, object,
+                                               &local_pretenuring_feedback_);
+    copied_objects_++;
+    if (promoted) {
+      promoted_size_ += size;
+    } else {
+      semispace_copied_size_ += size;
+    }
+    if (ContainsPointers(map)) copied_.Push(target);
+  }
+
+  AllocationResult AllocateInNewSpace(int size, AllocationAlignment alignment) {
+    if (size > kMaxLabObjectSize) {
+      return AllocateRawInNewSpace(size, alignment);
+    }
+    AllocationResult allocation =
+        new_space_buffer_.AllocateRawAligned(size, alignment);
+    if (!allocation.IsRetry()) return allocation;
+    AllocationResult result = AllocateRawInNewSpace(kLabSize, kWordAligned);
+    LocalAllocationBuffer saved_old_buffer = new_space_buffer_;
+    new_space_buffer_ =
+        LocalAllocationBuffer::FromResult(heap_, result, kLabSize);
+    if (!new_space_buffer_.IsValid()) return result;
+    new_space_buffer_.TryMerge(&saved_old_buffer);
+    return new_space_buffer_.AllocateRawAligned(size, alignment);
+  }
+
+  AllocationResult AllocateRawInNewSpace(int size,
+                                         AllocationAlignment alignment) {
+    NewSpace* new_space = heap_->new_space();
+    AllocationResult allocation =
+        new_space->AllocateRawSynchronized(size, alignment);
+    if (allocation.IsRetry() && new_space->AddFreshPageSynchronized()) {
+      allocation = new_space->AllocateRawSynchronized(size, alignment);
+    }
+    return allocation;
+  }
+
+  Heap* heap_;
+  CopiedWorklist::View copied_;
+  // Promoted objects are allocated in a task local space, like evacuated
+  // objects during mark-compact. Allocation observers of the old space never
+  // run on background threads this way. The pages are merged into the old
+  // space on the main thread in Finalize().
+  CompactionSpace old_space_;
+  LocalAllocationBuffer new_space_buffer_;
+  base::HashMap local_pretenuring_feedback_;
+  // Slots of promoted objects that point into new space. Slot sets cannot be
+  // updated concurrently.
+  std::vector<Address> recorded_slots_;
+  bool record_slots_;
+  int copied_objects_;
+  intptr_t promoted_size_;
+  intptr_t semispace_copied_size_;
+
+  DISALLOW_COPY_AND_ASSIGN(Visitor);
+};
+
+// Processes the OLD_TO_NEW remembered set of a page and then helps scanning
+// copied objects until all work is done.
+class ParallelScavenger::JobTraits {
+ public:
+  typedef int PerPageData;  // Per page data is not used in this job.
+  typedef Visitor* PerTaskData;
+
+  static bool ProcessPageInParallel(Heap* heap, PerTaskData visitor,
+                                    MemoryChunk* chunk, PerPageData) {
+    RememberedSet<OLD_TO_NEW>::Iterate(chunk, [visitor](Address slot) {
+      return visitor->CheckAndScavengeObject(slot);
+    });
+    RememberedSet<OLD_TO_NEW>::IterateTyped(
+        chunk, [heap, visitor](SlotType type, Address host_addr, Address slot) {
+          return UpdateTypedSlotHelper::UpdateTypedSlot(
+              heap->isolate(), type, slot, [visitor](Object** slot) {
+                // We expect that objects referenced by code are long living.
+                // If we do not force promotion, then we need to clear
+                // old_to_new slots in dead code objects after mark-compact.
+                return visitor->CheckAndScavengeObject(
+                    reinterpret_cast<Address>(slot));
+              });
+        });
+    visitor->ProcessCopiedObjects();
+    return true;
+  }
+
+  static const bool NeedSequentialFinalization = false;
+  static void FinalizePageSequentially(Heap*, MemoryChunk*, bool,
+                                       PerPageData) {}
+};
+
+ParallelScavenger::ParallelScavenger(Heap* heap)
+    : heap_(heap), num_tasks_(0), page_parallel_job_semaphore_(0) {
+  for (int i = 0; i < kMaxTasks; i++) visitors_[i] = nullptr;
+}
+
+ParallelScavenger::~ParallelScavenger() { DCHECK(!in_progress()); }
+
+bool ParallelScavenger::CanScavengeInParallel() {
+  // Moving objects has to be observed by incremental marking, the logger and
+  // the profilers. Allocation observers of the old generation, e.g. the
+  // sampling heap profiler, expect to run on the main thread. Leave these
+  // cases to the sequential scavenger.
+  return FLAG_parallel_scavenge &&
+         !heap_->incremental_marking()->IsMarking() &&
+         !heap_->scavenge_collector_->IsLoggingAndProfilingEnabled() &&
+         !heap_->old_space()->HasAllocationObservers() &&
+         !heap_->lo_space()->HasAllocationObservers();
+}
+
+int ParallelScavenger::NumberOfTasks() {
+  const int available_cores = static_cast<int>(
+      V8::GetCurrentPlatform()->NumberOfAvailableBackgroundThreads());
+  const int wanted = FLAG_parallel_scavenge_tasks > 0
+                         ? FLAG_parallel_scavenge_tasks
+                         : available_cores + 1;
+  return Max(1, Min(wanted, kMaxTasks));
+}
+
+void ParallelScavenger::Start() {
+  DCHECK(!in_progress());
+  DCHECK(copied_.IsGlobalEmpty());
+  num_tasks_ = NumberOfTasks();
+  for (int i = 0; i < num_tasks_; i++) {
+    visitors_[i] = new Visitor(heap_, &copied_, i);
+  }
+}
+
+ObjectVisitor* ParallelScavenger::main_thread_visitor() {
+  DCHECK(in_progress());
+  return visitors_[kMainThreadTask];
+}
+
+void ParallelScavenger::ScavengeOldToNewPointers() {
+  DCHECK(in_progress());
+  // Make the objects copied from roots available to all tasks.
+  visitors_[kMainThreadTask]->FlushToGlobal();
+  PageParallelJob<JobTraits> job(heap_,
+                                 heap_->isolate()->cancelable_task_manager(),
+                                 &page_parallel_job_semaphore_);
+  RememberedSet<OLD_TO_NEW>::IterateMemoryChunks(
+      heap_, [&job](MemoryChunk* chunk) { job.AddPage(chunk, 0); });
+  job.Run(num_tasks_, [this](int i) { return visitors_[i]; });
+  // The job does not start any task if there are no pages.
+  ProcessCopiedObjects();
+}
+
+void ParallelScavenger::ProcessCopiedObjects() {
+  DCHECK(in_progress());
+  visitors_[kMainThreadTask]->ProcessCopiedObjects();
+  DCHECK(copied_.IsGlobalEmpty());
+}
+
+void ParallelScavenger::Finish() {
+  DCHECK(in_progress());
+  DCHECK(copied_.IsGlobalEmpty());
+  if (FLAG_trace_parallel_scavenge) {
+    PrintIsolate(heap_->isolate(), "parallel-scavenge: tasks=%d", num_tasks_);
+    for (int i = 0; i < num_tasks_; i++) {
+      PrintF(" task%d=(objects=%d copied=%" V8PRIdPTR " promoted=%" V8PRIdPTR
+             ")",
+             i, visitors_[i]->copied_objects(),
+             visitors_[i]->semispace_copied_size(),
+             visitors_[i]->promoted_size());
+    }
+    PrintF("\n");
+  }
+  for (int i = 0; i < num_tasks_; i++) {
+    visitors_[i]->Finalize();
+    delete visitors_[i];
+    visitors_[i] = nullptr;
+  }
+  num_tasks_ = 0;
+}
+
+}  // namespace internal
+}  // namespace v8
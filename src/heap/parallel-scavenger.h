@@ -0,0 +1,89 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_HEAP_PARALLEL_SCAVENGER_H_
+#define V8_HEAP_PARALLEL_SCAVENGER_H_
+
+#include "src/allocation.h"
+#include "src/base/platform/semaphore.h"
+#include "src/heap/worklist.h"
+#include "src/utils.h"
+
+namespace v8 {
+namespace internal {
+
+class Heap;
+class HeapObject;
+class ObjectVisitor;
+
+// Copies the live objects of the young generation using the main thread and
+// background tasks. Used by Heap::Scavenge instead of the sequential
+// ScavengingVisitor if --parallel_scavenge is on and neither incremental
+// marking nor logging and profiling need to observe object moves.
+//
+// Roots are visited on the main thread. The OLD_TO_NEW remembered set is split
+// by pages across the tasks of a PageParallelJob. Copied objects are scanned
+// from a shared work-stealing worklist.
+//
+// Every task owns an allocation buffer in to-space and a compaction space for
+// promoted objects, which is merged into old space in Finish(). An object
+// is first copied and then forwarded with a compare-and-swap on its map word.
+// A task that loses the race turns its copy into a filler and uses the
+// forwarding address of the winner. Slots of promoted objects that still point
+// into new space are recorded task-locally and added to the remembered set on
+// the main thread in Finish().
+class ParallelScavenger {
+ public:
+  typedef Worklist<HeapObject*, 64> CopiedWorklist;
+
+  static const int kMainThreadTask = 0;
+  static const int kMaxTasks = CopiedWorklist::kMaxNumTasks;
+
+  explicit ParallelScavenger(Heap* heap);
+  ~ParallelScavenger();
+
+  // Returns true if the current scavenge can be done in parallel.
+  bool CanScavengeInParallel();
+
+  // Sets up the task local state. Must be called after the semispaces are
+  // flipped.
+  void Start();
+
+  // Visitor that copies objects referenced from roots on the main thread.
+  ObjectVisitor* main_thread_visitor();
+
+  // Scavenges the objects referenced from the OLD_TO_NEW remembered set and
+  // everything reachable from them in parallel.
+  void ScavengeOldToNewPointers();
+
+  // Scans all copied objects that are left on the main thread.
+  void ProcessCopiedObjects();
+
+  // Closes the allocation buffers, records the slots of promoted objects and
+  // merges the statistics and the pretenuring feedback of all tasks.
+  void Finish();
+
+  bool in_progress() { return num_tasks_ > 0; }
+
+ private:
+  class JobTraits;
+  class Visitor;
+
+  int NumberOfTasks();
+
+  Heap* heap_;
+  CopiedWorklist copied_;
+  Visitor* visitors_[kMaxTasks];
+  int num_tasks_;
+
+  // Semaphore that outlives the tasks. See PageParallelJob.
+  base::Semaphore page_parallel_job_semaphore_;
+
+  DISALLOW_COPY_AND_ASSIGN(ParallelScavenger);
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_HEAP_PARALLEL_SCAVENGER_H_
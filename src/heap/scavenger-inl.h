@@ -29,7 +29,8 @@ void Scavenger::ScavengeObject(HeapObject** p, HeapObject* object) {
   }
 
   object->GetHeap()->UpdateAllocationSite<Heap::kGlobal>(
-      object, object->GetHeap()->global_pretenuring_feedback_);
+      first_word.ToMap(), object,
+      object->GetHeap()->global_pretenuring_feedback_);
 
   // AllocationMementos are unrooted and shouldn't survive a scavenge
   DCHECK(object->map() != object->GetHeap()->allocation_memento_map());
@@ -36,6 +36,10 @@ class Scavenger {
   // of the heap (i.e. incremental marking, logging and profiling).
   void SelectScavengingVisitorsTable();
 
+  // Returns true if moved objects have to be reported to the logger or the
+  // heap profiler.
+  bool IsLoggingAndProfilingEnabled();
+
   Isolate* isolate();
   Heap* heap() { return heap_; }
 
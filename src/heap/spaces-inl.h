@@ -81,7 +81,7 @@ HeapObject* HeapObjectIterator::FromCurrentPage() {
         DCHECK_EQ(space_, space_->heap()->code_space());
         DCHECK_CODEOBJECT_SIZE(obj_size, space_);
       } else {
-        DCHECK_OBJECT_SIZE(obj_size);
+        DCHECK_OLD_SPACE_OBJECT_SIZE(obj_size);
       }
       return obj;
     }
@@ -444,7 +444,8 @@ AllocationResult PagedSpace::AllocateRawUnaligned(
     }
     if (object != NULL) {
       if (heap()->incremental_marking()->black_allocation()) {
-        Marking::MarkBlack(ObjectMarking::MarkBitFrom(object));
+        // Background markers may update mark bits in the same cell.
+        Marking::MarkBlack<MarkBit::ATOMIC>(ObjectMarking::MarkBitFrom(object));
         MemoryChunk::IncrementLiveBytesFromGC(object, size_in_bytes);
       }
     }
@@ -292,7 +292,10 @@ MemoryAllocator::MemoryAllocator(Isolate* isolate)
       size_executable_(0),
       lowest_ever_allocated_(reinterpret_cast<void*>(-1)),
       highest_ever_allocated_(reinterpret_cast<void*>(0)),
-      unmapper_(this) {}
+      unmapper_(this),
+      use_huge_page_regions_(false),
+      huge_page_region_top_(nullptr),
+      huge_page_region_limit_(nullptr) {}
 
 bool MemoryAllocator::SetUp(intptr_t capacity, intptr_t capacity_executable,
                             intptr_t code_range_size) {
@@ -303,6 +306,11 @@ bool MemoryAllocator::SetUp(intptr_t capacity, intptr_t capacity_executable,
   size_ = 0;
   size_executable_ = 0;
 
+#if V8_OS_LINUX
+  // Slices of a region are released one by one, which needs munmap.
+  use_huge_page_regions_ = FLAG_transparent_huge_pages;
+#endif
+
   code_range_ = new CodeRange(isolate_);
   if (!code_range_->SetUp(static_cast<size_t>(code_range_size))) return false;
 
@@ -330,6 +338,13 @@ void MemoryAllocator::TearDown() {
     last_chunk_.Release();
   }
 
+  if (huge_page_region_top_ != huge_page_region_limit_) {
+    base::VirtualMemory::ReleaseRegion(
+        huge_page_region_top_,
+        static_cast<size_t>(huge_page_region_limit_ - huge_page_region_top_));
+    huge_page_region_top_ = huge_page_region_limit_ = nullptr;
+  }
+
   delete code_range_;
   code_range_ = nullptr;
 }
@@ -408,10 +423,48 @@ bool MemoryAllocator::CommitMemory(Address base, size_t size,
                                          executable == EXECUTABLE)) {
     return false;
   }
+  // Committing maps fresh memory, which drops earlier advice.
+  if (executable == NOT_EXECUTABLE) AdviseHugePages(base, size);
   UpdateAllocatedSpaceLimits(base, base + size);
   return true;
 }
 
+void MemoryAllocator::AdviseHugePages(Address start, size_t size) {
+  if (!use_huge_page_regions_) return;
+  base::OS::AdviseHugePages(start, size);
+}
+
+Address MemoryAllocator::AllocateHugePageRegionSlice(
+    size_t size, base::VirtualMemory* controller) {
+  DCHECK(use_huge_page_regions_);
+  DCHECK_EQ(0u, kHugePageRegionSize % size);
+  Address base = nullptr;
+  {
+    base::LockGuard<base::Mutex> guard(&huge_page_region_mutex_);
+    if (huge_page_region_top_ == huge_page_region_limit_) {
+      base::VirtualMemory region(kHugePageRegionSize, kHugePageRegionSize);
+      if (!region.IsReserved()) return nullptr;
+      DCHECK(IsAddressAligned(static_cast<Address>(region.address()),
+                              kHugePageRegionSize));
+      DCHECK_EQ(kHugePageRegionSize, region.size());
+      huge_page_region_top_ = static_cast<Address>(region.address());
+      huge_page_region_limit_ = huge_page_region_top_ + region.size();
+      // From now on the region is owned by the slices handed out below.
+      region.Reset();
+    }
+    base = huge_page_region_top_;
+    huge_page_region_top_ += size;
+  }
+  base::VirtualMemory reservation(base, size);
+  if (!CommitMemory(base, size, NOT_EXECUTABLE)) {
+    reservation.Release();
+    return nullptr;
+  }
+  size_.Increment(static_cast<intptr_t>(size));
+  controller->TakeControl(&reservation);
+  return base;
+}
+
 
 void MemoryAllocator::FreeMemory(base::VirtualMemory* reservation,
                                  Executability executable) {
@@ -716,9 +769,22 @@ MemoryChunk* MemoryAllocator::AllocateChunk(intptr_t reserve_area_size,
     size_t commit_size =
         RoundUp(MemoryChunk::kObjectStartOffset + commit_area_size,
                 base::OS::CommitPageSize());
-    base =
-        AllocateAlignedMemory(chunk_size, commit_size, MemoryChunk::kAlignment,
-                              executable, &reservation);
+    if (use_huge_page_regions_ &&
+        chunk_size == static_cast<size_t>(Page::kPageSize)) {
+      DCHECK_EQ(chunk_size, commit_size);
+      base = AllocateHugePageRegionSlice(chunk_size, &reservation);
+    } else if (use_huge_page_regions_ && chunk_size >= kHugePageRegionSize) {
+      // Large object pages get a huge page aligned start so that their area
+      // can be backed by huge pages as well.
+      base = AllocateAlignedMemory(chunk_size, commit_size,
+                                   kHugePageRegionSize, executable,
+                                   &reservation);
+      if (base != NULL) AdviseHugePages(base, commit_size);
+    } else {
+      base = AllocateAlignedMemory(chunk_size, commit_size,
+                                   MemoryChunk::kAlignment, executable,
+                                   &reservation);
+    }
 
     if (base == NULL) return NULL;
 
@@ -2963,6 +3029,7 @@ Object* LargeObjectSpace::FindObject(Address a) {
 
 
 LargePage* LargeObjectSpace::FindPage(Address a) {
+  base::LockGuard<base::Mutex> guard(&chunk_map_mutex_);
   uintptr_t key = reinterpret_cast<uintptr_t>(a) / MemoryChunk::kAlignment;
   base::HashMap::Entry* e = chunk_map_.Lookup(reinterpret_cast<void*>(key),
                                               static_cast<uint32_t>(key));
@@ -2992,6 +3059,7 @@ void LargeObjectSpace::ClearMarkingStateOfLiveObjects() {
 }
 
 void LargeObjectSpace::InsertChunkMapEntries(LargePage* page) {
+  base::LockGuard<base::Mutex> guard(&chunk_map_mutex_);
   // Register all MemoryChunk::kAlignment-aligned chunks covered by
   // this large page in the chunk map.
   uintptr_t start = reinterpret_cast<uintptr_t>(page) / MemoryChunk::kAlignment;
@@ -3011,6 +3079,7 @@ void LargeObjectSpace::RemoveChunkMapEntries(LargePage* page) {
 
 void LargeObjectSpace::RemoveChunkMapEntries(LargePage* page,
                                              Address free_start) {
+  base::LockGuard<base::Mutex> guard(&chunk_map_mutex_);
   uintptr_t start = RoundUp(reinterpret_cast<uintptr_t>(free_start),
                             MemoryChunk::kAlignment) /
                     MemoryChunk::kAlignment;
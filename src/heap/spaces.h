@@ -107,6 +107,9 @@ class Space;
 #define DCHECK_OBJECT_SIZE(size) \
   DCHECK((0 < size) && (size <= Page::kMaxRegularHeapObjectSize))
 
+#define DCHECK_OLD_SPACE_OBJECT_SIZE(size) \
+  DCHECK((0 < size) && (size <= Page::kMaxMediumHeapObjectSize))
+
 #define DCHECK_CODEOBJECT_SIZE(size, code_space) \
   DCHECK((0 < size) && (size <= code_space->AreaSize()))
 
@@ -724,6 +727,18 @@ class Page : public MemoryChunk {
   // short living objects >256K.
   static const int kMaxRegularHeapObjectSize = 600 * KB;
 
+  // Size range of medium objects. With --medium-object-pages, arrays and
+  // strings of at least kMinMediumHeapObjectSize bytes are allocated on old
+  // space pages even if new space was requested, so that they are not copied
+  // by the scavenger, and objects above kMaxRegularHeapObjectSize up to
+  // kMaxMediumHeapObjectSize do not get a large object page each. Medium
+  // objects share pages with each other and with small objects: a page holds
+  // up to seven objects of the minimum size. They are allocated from the old
+  // space free list and freed by the sweeper, instead of mapping and unmapping
+  // a page per object. The maximum leaves room for a double alignment filler.
+  static const int kMinMediumHeapObjectSize = 128 * KB;
+  static const int kMaxMediumHeapObjectSize = kAllocatableMemory - kDoubleSize;
+
   static inline Page* ConvertNewToOld(Page* old_page, PagedSpace* new_owner);
 
   // Returns the page containing a given address. The address ranges
@@ -906,6 +921,8 @@ class Space : public Malloced {
     DCHECK(removed);
   }
 
+  bool HasAllocationObservers() { return !allocation_observers_->is_empty(); }
+
   virtual void PauseAllocationObservers() {
     allocation_observers_paused_ = true;
   }
@@ -1248,6 +1265,15 @@ class MemoryAllocator {
     kPooledAndQueue,
   };
 
+  // Size of the regions that regular pages are grouped into with
+  // --transparent_huge_pages. Matches the transparent huge page size of the
+  // host.
+#if V8_HOST_ARCH_PPC && V8_OS_LINUX
+  static const size_t kHugePageRegionSize = 16 * MB;
+#else
+  static const size_t kHugePageRegionSize = 2 * MB;
+#endif
+
   explicit MemoryAllocator(Isolate* isolate);
 
   // Initializes its internal bookkeeping structures.
@@ -1323,6 +1349,10 @@ class MemoryAllocator {
 
   bool CommitMemory(Address addr, size_t size, Executability executable);
 
+  // Returns true if regular non-executable pages are carved out of huge page
+  // aligned regions. See AllocateHugePageRegionSlice.
+  bool use_huge_page_regions() { return use_huge_page_regions_; }
+
   void FreeMemory(base::VirtualMemory* reservation, Executability executable);
   void PartialFreeMemory(MemoryChunk* chunk, Address start_free);
   void FreeMemory(Address addr, size_t size, Executability executable);
@@ -1381,6 +1411,17 @@ class MemoryAllocator {
   template <typename SpaceType>
   MemoryChunk* AllocatePagePooled(SpaceType* owner);
 
+  // Reserves kHugePageRegionSize aligned regions and hands them out page by
+  // page, so that pages allocated one after the other can share a transparent
+  // huge page. Every page owns its slice of the region and releases it on its
+  // own. Returns the committed slice.
+  Address AllocateHugePageRegionSlice(size_t size,
+                                      base::VirtualMemory* controller);
+
+  // Advises the OS to back the committed region with huge pages if
+  // --transparent_huge_pages is on.
+  void AdviseHugePages(Address start, size_t size);
+
   Isolate* isolate_;
 
   CodeRange* code_range_;
@@ -1426,6 +1467,12 @@ class MemoryAllocator {
   base::VirtualMemory last_chunk_;
   Unmapper unmapper_;
 
+  bool use_huge_page_regions_;
+  // The part of the current huge page region that was not handed out yet.
+  base::Mutex huge_page_region_mutex_;
+  Address huge_page_region_top_;
+  Address huge_page_region_limit_;
+
   friend class TestCodeRangeScope;
 
   DISALLOW_IMPLICIT_CONSTRUCTORS(MemoryAllocator);
@@ -2990,6 +3037,8 @@ class LargeObjectSpace : public Space {
   intptr_t objects_size_;  // size of objects
   // Map MemoryChunk::kAlignment-aligned chunks to large pages covering them
   base::HashMap chunk_map_;
+  // Guards |chunk_map_|, which is also read by the store buffer task.
+  base::Mutex chunk_map_mutex_;
 
   friend class LargeObjectIterator;
 };
@@ -6,6 +6,7 @@
 
 #include <algorithm>
 
+#include "src/cancelable-task.h"
 #include "src/counters.h"
 #include "src/heap/incremental-marking.h"
 #include "src/isolate.h"
@@ -15,63 +16,176 @@
 namespace v8 {
 namespace internal {
 
+class StoreBuffer::Task : public CancelableTask {
+ public:
+  Task(Isolate* isolate, StoreBuffer* store_buffer, base::Semaphore* on_finish)
+      : CancelableTask(isolate),
+        store_buffer_(store_buffer),
+        on_finish_(on_finish) {}
+
+  virtual ~Task() {}
+
+ private:
+  // v8::internal::CancelableTask overrides.
+  void RunInternal() override {
+    store_buffer_->ConcurrentlyProcessStoreBuffer();
+    on_finish_->Signal();
+  }
+
+  StoreBuffer* store_buffer_;
+  base::Semaphore* on_finish_;
+
+  DISALLOW_COPY_AND_ASSIGN(Task);
+};
+
 StoreBuffer::StoreBuffer(Heap* heap)
     : heap_(heap),
       top_(nullptr),
-      start_(nullptr),
-      limit_(nullptr),
-      virtual_memory_(nullptr) {}
+      current_(0),
+      task_running_(false),
+      task_pending_(false),
+      task_id_(0),
+      pending_task_semaphore_(0),
+      virtual_memory_(nullptr) {
+  for (int i = 0; i < kStoreBuffers; i++) {
+    start_[i] = nullptr;
+    limit_[i] = nullptr;
+    lazy_top_[i] = nullptr;
+  }
+}
 
 void StoreBuffer::SetUp() {
-  // Allocate 3x the buffer size, so that we can start the new store buffer
-  // aligned to 2x the size.  This lets us use a bit test to detect the end of
-  // the area.
-  virtual_memory_ = new base::VirtualMemory(kStoreBufferSize * 2);
+  // Allocate 3x the buffer size, so that we can start the new store buffers
+  // aligned to the buffer size.  This lets us use a bit test to detect the end
+  // of each buffer.
+  virtual_memory_ = new base::VirtualMemory(kStoreBufferSize * 3);
   uintptr_t start_as_int =
       reinterpret_cast<uintptr_t>(virtual_memory_->address());
-  start_ = reinterpret_cast<Address*>(RoundUp(start_as_int, kStoreBufferSize));
-  limit_ = start_ + (kStoreBufferSize / kPointerSize);
+  start_[0] =
+      reinterpret_cast<Address*>(RoundUp(start_as_int, kStoreBufferSize));
+  limit_[0] = start_[0] + (kStoreBufferSize / kPointerSize);
+  start_[1] = limit_[0];
+  limit_[1] = start_[1] + (kStoreBufferSize / kPointerSize);
 
-  DCHECK(reinterpret_cast<Address>(start_) >= virtual_memory_->address());
-  DCHECK(reinterpret_cast<Address>(limit_) >= virtual_memory_->address());
   Address* vm_limit = reinterpret_cast<Address*>(
       reinterpret_cast<char*>(virtual_memory_->address()) +
       virtual_memory_->size());
-  DCHECK(start_ <= vm_limit);
-  DCHECK(limit_ <= vm_limit);
   USE(vm_limit);
-  DCHECK((reinterpret_cast<uintptr_t>(limit_) & kStoreBufferMask) == 0);
+  for (int i = 0; i < kStoreBuffers; i++) {
+    DCHECK(reinterpret_cast<Address>(start_[i]) >= virtual_memory_->address());
+    DCHECK(reinterpret_cast<Address>(limit_[i]) >= virtual_memory_->address());
+    DCHECK(start_[i] <= vm_limit);
+    DCHECK(limit_[i] <= vm_limit);
+    DCHECK((reinterpret_cast<uintptr_t>(limit_[i]) & kStoreBufferMask) == 0);
+  }
 
-  if (!virtual_memory_->Commit(reinterpret_cast<Address>(start_),
-                               kStoreBufferSize,
+  if (!virtual_memory_->Commit(reinterpret_cast<Address>(start_[0]),
+                               kStoreBufferSize * kStoreBuffers,
                                false)) {  // Not executable.
     V8::FatalProcessOutOfMemory("StoreBuffer::SetUp");
   }
-  top_ = start_;
+  current_ = 0;
+  top_ = start_[current_];
 }
 
 
 void StoreBuffer::TearDown() {
+  // The heap is torn down before the cancelable tasks of the isolate are
+  // cancelled, so the task has to be stopped here.
+  if (task_pending_) {
+    if (!heap_->isolate()->cancelable_task_manager()->TryAbort(task_id_)) {
+      pending_task_semaphore_.Wait();
+    }
+    task_pending_ = false;
+  }
   delete virtual_memory_;
-  top_ = start_ = limit_ = nullptr;
+  top_ = nullptr;
+  for (int i = 0; i < kStoreBuffers; i++) {
+    start_[i] = nullptr;
+    limit_[i] = nullptr;
+    lazy_top_[i] = nullptr;
+  }
 }
 
 
 void StoreBuffer::StoreBufferOverflow(Isolate* isolate) {
-  isolate->heap()->store_buffer()->MoveEntriesToRememberedSet();
+  StoreBuffer* store_buffer = isolate->heap()->store_buffer();
+  if (FLAG_concurrent_store_buffer) {
+    store_buffer->FlipStoreBuffers();
+  } else {
+    store_buffer->MoveAllEntriesToRememberedSet();
+  }
   isolate->counters()->store_buffer_overflows()->Increment();
 }
 
-void StoreBuffer::MoveEntriesToRememberedSet() {
-  if (top_ == start_) return;
-  DCHECK(top_ <= limit_);
-  for (Address* current = start_; current < top_; current++) {
+void StoreBuffer::InsertEntry(Address slot) {
+  if (heap_->gc_state() != Heap::NOT_IN_GC) {
+    // No task is running during a GC since the store buffer was emptied in the
+    // GC prologue.
+    RememberedSet<OLD_TO_NEW>::Insert(Page::FromAnyPointerAddress(heap_, slot),
+                                      slot);
+    return;
+  }
+  *top_ = slot;
+  top_++;
+  if (top_ == limit_[current_]) {
+    StoreBufferOverflow(heap_->isolate());
+  }
+}
+
+void StoreBuffer::FlipStoreBuffers() {
+  base::LockGuard<base::Mutex> guard(&mutex_);
+  int other = (current_ + 1) % kStoreBuffers;
+  // The task did not get to the other buffer yet. Its entries have to be
+  // processed before the mutator can fill it again.
+  MoveEntriesToRememberedSet(other);
+  lazy_top_[current_] = top_;
+  current_ = other;
+  top_ = start_[current_];
+
+  if (!task_running_) {
+    if (task_pending_) {
+      // The previous task is done and has signaled or is about to signal.
+      pending_task_semaphore_.Wait();
+    }
+    task_running_ = true;
+    task_pending_ = true;
+    Task* task = new Task(heap_->isolate(), this, &pending_task_semaphore_);
+    task_id_ = task->id();
+    V8::GetCurrentPlatform()->CallOnBackgroundThread(
+        task, v8::Platform::kShortRunningTask);
+  }
+}
+
+void StoreBuffer::ConcurrentlyProcessStoreBuffer() {
+  base::LockGuard<base::Mutex> guard(&mutex_);
+  int other = (current_ + 1) % kStoreBuffers;
+  MoveEntriesToRememberedSet(other);
+  task_running_ = false;
+}
+
+void StoreBuffer::MoveEntriesToRememberedSet(int index) {
+  if (lazy_top_[index] == nullptr) return;
+  DCHECK_GE(index, 0);
+  DCHECK_LT(index, kStoreBuffers);
+  DCHECK(lazy_top_[index] <= limit_[index]);
+  for (Address* current = start_[index]; current < lazy_top_[index];
+       current++) {
     DCHECK(!heap_->code_space()->Contains(*current));
     Address addr = *current;
     Page* page = Page::FromAnyPointerAddress(heap_, addr);
     RememberedSet<OLD_TO_NEW>::Insert(page, addr);
   }
-  top_ = start_;
+  lazy_top_[index] = nullptr;
+}
+
+void StoreBuffer::MoveAllEntriesToRememberedSet() {
+  base::LockGuard<base::Mutex> guard(&mutex_);
+  int other = (current_ + 1) % kStoreBuffers;
+  MoveEntriesToRememberedSet(other);
+  lazy_top_[current_] = top_;
+  MoveEntriesToRememberedSet(current_);
+  top_ = start_[current_];
 }
 
 }  // namespace internal
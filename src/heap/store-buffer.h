@@ -7,7 +7,9 @@
 
 #include "src/allocation.h"
 #include "src/base/logging.h"
+#include "src/base/platform/mutex.h"
 #include "src/base/platform/platform.h"
+#include "src/base/platform/semaphore.h"
 #include "src/globals.h"
 #include "src/heap/slot-set.h"
 
@@ -15,11 +17,19 @@ namespace v8 {
 namespace internal {
 
 // Intermediate buffer that accumulates old-to-new stores from the generated
-// code. On buffer overflow the slots are moved to the remembered set.
+// code and the runtime. The store buffer consists of two buffers of which only
+// one is filled at a time. On buffer overflow the buffers are flipped and the
+// slots of the full buffer are moved to the remembered set by a background
+// task while the mutator keeps filling the other buffer.
+//
+// The remembered set is only modified by the background task while the
+// mutator runs. Code that reads or removes OLD_TO_NEW slots has to call
+// MoveAllEntriesToRememberedSet first, which also waits for the task.
 class StoreBuffer {
  public:
   static const int kStoreBufferSize = 1 << (14 + kPointerSizeLog2);
   static const int kStoreBufferMask = kStoreBufferSize - 1;
+  static const int kStoreBuffers = 2;
 
   static void StoreBufferOverflow(Isolate* isolate);
 
@@ -30,19 +40,61 @@ class StoreBuffer {
   // Used to add entries from generated code.
   inline Address* top_address() { return reinterpret_cast<Address*>(&top_); }
 
-  void MoveEntriesToRememberedSet();
+  // Used to add entries from the runtime. Entries that are added during a GC
+  // go directly to the remembered set.
+  void InsertEntry(Address slot);
+
+  // Moves the entries of both buffers to the remembered set. Waits for a
+  // concurrently running task.
+  void MoveAllEntriesToRememberedSet();
 
  private:
+  class Task;
+
+  // Makes the other buffer the current one and starts a task that processes
+  // the full buffer.
+  void FlipStoreBuffers();
+
+  // Called by the task. Moves the entries of the buffer that is not filled
+  // by the mutator to the remembered set.
+  void ConcurrentlyProcessStoreBuffer();
+
+  // Requires |mutex_| to be held.
+  void MoveEntriesToRememberedSet(int index);
+
   Heap* heap_;
 
   Address* top_;
 
-  // The start and the limit of the buffer that contains store slots
-  // added from the generated code.
-  Address* start_;
-  Address* limit_;
+  // The start and the limit of the buffers that contain store slots added
+  // from the generated code. The limits are aligned to kStoreBufferSize so
+  // that generated code can detect the end of a buffer with a bit test.
+  Address* start_[kStoreBuffers];
+  Address* limit_[kStoreBuffers];
+
+  // The end of the entries of a buffer that has to be moved to the
+  // remembered set or nullptr if there are none.
+  Address* lazy_top_[kStoreBuffers];
+
+  // The buffer that is currently filled by the mutator.
+  int current_;
+
+  // Guards |current_|, |lazy_top_|, |task_running_| and the remembered set
+  // insertions of the task.
+  base::Mutex mutex_;
+
+  bool task_running_;
+
+  // Main thread only.
+  bool task_pending_;
+  uint32_t task_id_;
+
+  // Semaphore that outlives the task. See PageParallelJob.
+  base::Semaphore pending_task_semaphore_;
 
   base::VirtualMemory* virtual_memory_;
+
+  DISALLOW_COPY_AND_ASSIGN(StoreBuffer);
 };
 
 }  // namespace internal
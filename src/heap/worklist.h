@@ -0,0 +1,224 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_HEAP_WORKLIST_H_
+#define V8_HEAP_WORKLIST_H_
+
+#include <cstddef>
+
+#include "src/base/logging.h"
+#include "src/base/macros.h"
+#include "src/base/platform/mutex.h"
+
+namespace v8 {
+namespace internal {
+
+// A concurrent worklist based on segments. Each task gets private push and
+// pop segments. Empty pop segments are swapped with their corresponding push
+// segments. Full push segments are published to a global pool of segments
+// and replaced with empty segments. A task that runs out of local work steals
+// a whole segment from the global pool.
+//
+// Work stealing is best effort, i.e., there is no way to inform other tasks
+// of the need of items.
+template <typename EntryType, int SEGMENT_SIZE>
+class Worklist {
+ public:
+  static const int kMaxNumTasks = 8;
+  static const int kSegmentCapacity = SEGMENT_SIZE;
+
+  // A view of the worklist that is bound to a single task.
+  class View {
+   public:
+    View(Worklist<EntryType, SEGMENT_SIZE>* worklist, int task_id)
+        : worklist_(worklist), task_id_(task_id) {}
+
+    // Pushes an entry onto the worklist.
+    bool Push(EntryType entry) { return worklist_->Push(task_id_, entry); }
+
+    // Pops an entry from the worklist.
+    bool Pop(EntryType* entry) { return worklist_->Pop(task_id_, entry); }
+
+    // Returns true if the local portion of the worklist is empty.
+    bool IsLocalEmpty() { return worklist_->IsLocalEmpty(task_id_); }
+
+    // Publishes all local entries so that other tasks can steal them.
+    void FlushToGlobal() { worklist_->FlushToGlobal(task_id_); }
+
+   private:
+    Worklist<EntryType, SEGMENT_SIZE>* worklist_;
+    int task_id_;
+  };
+
+  Worklist() : global_pool_(nullptr), global_pool_length_(0) {
+    for (int i = 0; i < kMaxNumTasks; i++) {
+      private_push_segment_[i] = new Segment();
+      private_pop_segment_[i] = new Segment();
+    }
+  }
+
+  ~Worklist() {
+    CHECK(IsGlobalEmpty());
+    for (int i = 0; i < kMaxNumTasks; i++) {
+      DCHECK(private_push_segment_[i]->IsEmpty());
+      DCHECK(private_pop_segment_[i]->IsEmpty());
+      delete private_push_segment_[i];
+      delete private_pop_segment_[i];
+    }
+  }
+
+  bool Push(int task_id, EntryType entry) {
+    DCHECK_LT(task_id, kMaxNumTasks);
+    if (!private_push_segment_[task_id]->Push(entry)) {
+      PublishPushSegmentToGlobal(task_id);
+      bool success = private_push_segment_[task_id]->Push(entry);
+      USE(success);
+      DCHECK(success);
+    }
+    return true;
+  }
+
+  bool Pop(int task_id, EntryType* entry) {
+    DCHECK_LT(task_id, kMaxNumTasks);
+    if (!private_pop_segment_[task_id]->Pop(entry)) {
+      if (!private_push_segment_[task_id]->IsEmpty()) {
+        Segment* tmp = private_pop_segment_[task_id];
+        private_pop_segment_[task_id] = private_push_segment_[task_id];
+        private_push_segment_[task_id] = tmp;
+      } else if (!StealPopSegmentFromGlobal(task_id)) {
+        return false;
+      }
+      bool success = private_pop_segment_[task_id]->Pop(entry);
+      USE(success);
+      DCHECK(success);
+    }
+    return true;
+  }
+
+  bool IsLocalEmpty(int task_id) {
+    return private_pop_segment_[task_id]->IsEmpty() &&
+           private_push_segment_[task_id]->IsEmpty();
+  }
+
+  bool IsGlobalPoolEmpty() {
+    base::LockGuard<base::Mutex> guard(&lock_);
+    return global_pool_ == nullptr;
+  }
+
+  // Returns true if neither the global pool nor any of the private segments
+  // hold entries. Must not be called while tasks are using the worklist.
+  bool IsGlobalEmpty() {
+    for (int i = 0; i < kMaxNumTasks; i++) {
+      if (!IsLocalEmpty(i)) return false;
+    }
+    return IsGlobalPoolEmpty();
+  }
+
+  // Approximate number of entries in the global pool. Used to decide how
+  // many tasks are worth starting.
+  size_t GlobalPoolSize() {
+    base::LockGuard<base::Mutex> guard(&lock_);
+    return global_pool_length_ * kSegmentCapacity;
+  }
+
+  void FlushToGlobal(int task_id) {
+    DCHECK_LT(task_id, kMaxNumTasks);
+    PublishPushSegmentToGlobal(task_id);
+    PublishPopSegmentToGlobal(task_id);
+  }
+
+  // Drops all entries. Must not be called while tasks are using the worklist.
+  void Clear() {
+    for (int i = 0; i < kMaxNumTasks; i++) {
+      private_push_segment_[i]->Clear();
+      private_pop_segment_[i]->Clear();
+    }
+    base::LockGuard<base::Mutex> guard(&lock_);
+    while (global_pool_ != nullptr) {
+      Segment* segment = global_pool_;
+      global_pool_ = segment->next();
+      delete segment;
+    }
+    global_pool_length_ = 0;
+  }
+
+ private:
+  class Segment {
+   public:
+    static const int kCapacity = kSegmentCapacity;
+
+    Segment() : index_(0), next_(nullptr) {}
+
+    bool Push(EntryType entry) {
+      if (IsFull()) return false;
+      entries_[index_++] = entry;
+      return true;
+    }
+
+    bool Pop(EntryType* entry) {
+      if (IsEmpty()) return false;
+      *entry = entries_[--index_];
+      return true;
+    }
+
+    bool IsEmpty() const { return index_ == 0; }
+    bool IsFull() const { return index_ == kCapacity; }
+    void Clear() { index_ = 0; }
+
+    Segment* next() const { return next_; }
+    void set_next(Segment* segment) { next_ = segment; }
+
+   private:
+    int index_;
+    Segment* next_;
+    EntryType entries_[kCapacity];
+  };
+
+  void PublishPushSegmentToGlobal(int task_id) {
+    if (private_push_segment_[task_id]->IsEmpty()) return;
+    AddToGlobalPool(private_push_segment_[task_id]);
+    private_push_segment_[task_id] = new Segment();
+  }
+
+  void PublishPopSegmentToGlobal(int task_id) {
+    if (private_pop_segment_[task_id]->IsEmpty()) return;
+    AddToGlobalPool(private_pop_segment_[task_id]);
+    private_pop_segment_[task_id] = new Segment();
+  }
+
+  bool StealPopSegmentFromGlobal(int task_id) {
+    Segment* segment = nullptr;
+    {
+      base::LockGuard<base::Mutex> guard(&lock_);
+      if (global_pool_ == nullptr) return false;
+      segment = global_pool_;
+      global_pool_ = segment->next();
+      global_pool_length_--;
+    }
+    delete private_pop_segment_[task_id];
+    private_pop_segment_[task_id] = segment;
+    return true;
+  }
+
+  void AddToGlobalPool(Segment* segment) {
+    base::LockGuard<base::Mutex> guard(&lock_);
+    segment->set_next(global_pool_);
+    global_pool_ = segment;
+    global_pool_length_++;
+  }
+
+  Segment* private_push_segment_[kMaxNumTasks];
+  Segment* private_pop_segment_[kMaxNumTasks];
+
+  base::Mutex lock_;
+  Segment* global_pool_;
+  size_t global_pool_length_;
+
+  DISALLOW_COPY_AND_ASSIGN(Worklist);
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_HEAP_WORKLIST_H_
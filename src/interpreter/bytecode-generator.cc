@@ -682,24 +682,26 @@ BytecodeGenerator::BytecodeGenerator(CompilationInfo* info)
       generator_state_(),
       loop_depth_(0),
       home_object_symbol_(info->isolate()->factory()->home_object_symbol()),
-      prototype_string_(info->isolate()->factory()->prototype_string()) {
-  InitializeAstVisitor(info->isolate()->stack_guard()->real_climit());
-}
+      prototype_string_(info->isolate()->factory()->prototype_string()) {}
 
 Handle<BytecodeArray> BytecodeGenerator::MakeBytecode(Isolate* isolate) {
+  GenerateBytecode(isolate->stack_guard()->real_climit());
+  return FinalizeBytecode(isolate);
+}
+
+Handle<BytecodeArray> BytecodeGenerator::FinalizeBytecode(Isolate* isolate) {
   // Create an inner HandleScope to avoid unnecessarily canonicalizing handles
   // created as part of bytecode finalization.
   HandleScope scope(isolate);
 
-  GenerateBytecode();
-  FinalizeBytecode(isolate);
+  AllocateDeferredConstants();
 
   if (HasStackOverflow()) return Handle<BytecodeArray>();
 
   return scope.CloseAndEscape(builder()->ToBytecodeArray(isolate));
 }
 
-void BytecodeGenerator::FinalizeBytecode(Isolate* isolate) {
+void BytecodeGenerator::AllocateDeferredConstants() {
   // Build global declaration pair arrays.
   for (GlobalDeclarationsBuilder* globals_builder : global_declarations_) {
     Handle<FixedArray> declarations =
@@ -730,11 +732,13 @@ void BytecodeGenerator::FinalizeBytecode(Isolate* isolate) {
   }
 }
 
-void BytecodeGenerator::GenerateBytecode() {
+void BytecodeGenerator::GenerateBytecode(uintptr_t stack_limit) {
   DisallowHeapAllocation no_allocation;
   DisallowHandleAllocation no_handles;
   DisallowHandleDereference no_deref;
 
+  InitializeAstVisitor(stack_limit);
+
   // Initialize the incoming context.
   ContextScope incoming_context(this, scope(), false);
 
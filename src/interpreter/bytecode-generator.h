@@ -26,6 +26,13 @@ class BytecodeGenerator final : public AstVisitor<BytecodeGenerator> {
 
   Handle<BytecodeArray> MakeBytecode(Isolate* isolate);
 
+  // The two halves of MakeBytecode. GenerateBytecode doesn't access the heap
+  // and may run on a background thread with the given |stack_limit|, whereas
+  // FinalizeBytecode allocates the bytecode array on the main thread. Returns
+  // a null handle on stack overflow.
+  void GenerateBytecode(uintptr_t stack_limit);
+  Handle<BytecodeArray> FinalizeBytecode(Isolate* isolate);
+
 #define DECLARE_VISIT(type) void Visit##type(type* node);
   AST_NODE_LIST(DECLARE_VISIT)
 #undef DECLARE_VISIT
@@ -52,9 +59,8 @@ class BytecodeGenerator final : public AstVisitor<BytecodeGenerator> {
 
   enum class TestFallthrough { kThen, kElse, kNone };
 
-  void GenerateBytecode();
   void GenerateBytecodeBody();
-  void FinalizeBytecode(Isolate* isolate);
+  void AllocateDeferredConstants();
 
   DEFINE_AST_VISITOR_SUBCLASS_MEMBERS();
 
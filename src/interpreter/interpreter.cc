@@ -139,6 +139,13 @@ bool Interpreter::MakeBytecode(CompilationInfo* info) {
   TRACE_EVENT_RUNTIME_CALL_STATS_TRACING_SCOPED(
       info->isolate(), &tracing::TraceEventStatsTable::CompileIgnition);
 
+  InterpreterCompilationJob job(info);
+  job.Execute(info->isolate()->stack_guard()->real_climit());
+  return job.Finalize();
+}
+
+InterpreterCompilationJob::InterpreterCompilationJob(CompilationInfo* info)
+    : info_(info), executed_(false) {
   if (FLAG_print_bytecode || FLAG_print_ast) {
     OFStream os(stdout);
     std::unique_ptr<char[]> name = info->GetDebugName();
@@ -156,10 +163,22 @@ bool Interpreter::MakeBytecode(CompilationInfo* info) {
   }
 #endif  // DEBUG
 
-  BytecodeGenerator generator(info);
-  Handle<BytecodeArray> bytecodes = generator.MakeBytecode(info->isolate());
+  generator_.reset(new BytecodeGenerator(info));
+}
+
+InterpreterCompilationJob::~InterpreterCompilationJob() {}
+
+void InterpreterCompilationJob::Execute(uintptr_t stack_limit) {
+  DCHECK(!executed_);
+  generator_->GenerateBytecode(stack_limit);
+  executed_ = true;
+}
 
-  if (generator.HasStackOverflow()) return false;
+bool InterpreterCompilationJob::Finalize() {
+  DCHECK(executed_);
+  Handle<BytecodeArray> bytecodes =
+      generator_->FinalizeBytecode(info()->isolate());
+  if (generator_->HasStackOverflow()) return false;
 
   if (FLAG_print_bytecode) {
     OFStream os(stdout);
@@ -167,8 +186,8 @@ bool Interpreter::MakeBytecode(CompilationInfo* info) {
     os << std::flush;
   }
 
-  info->SetBytecodeArray(bytecodes);
-  info->SetCode(info->isolate()->builtins()->InterpreterEntryTrampoline());
+  info()->SetBytecodeArray(bytecodes);
+  info()->SetCode(info()->isolate()->builtins()->InterpreterEntryTrampoline());
   return true;
 }
 
@@ -29,8 +29,34 @@ class Node;
 
 namespace interpreter {
 
+class BytecodeGenerator;
 class InterpreterAssembler;
 
+// Generates bytecode for |info| in steps, so that the bulk of the work can be
+// done off the main thread. Construction and Finalize must happen on the main
+// thread, Execute doesn't access the heap and may run on any thread.
+class InterpreterCompilationJob final {
+ public:
+  explicit InterpreterCompilationJob(CompilationInfo* info);
+  ~InterpreterCompilationJob();
+
+  // Generates the bytecode, using |stack_limit| for stack overflow checks.
+  void Execute(uintptr_t stack_limit);
+
+  // Allocates the bytecode array and records it on the compilation info.
+  // Returns false if generating the bytecode overflowed the stack.
+  bool Finalize();
+
+  CompilationInfo* info() const { return info_; }
+
+ private:
+  CompilationInfo* info_;
+  std::unique_ptr<BytecodeGenerator> generator_;
+  bool executed_;
+
+  DISALLOW_COPY_AND_ASSIGN(InterpreterCompilationJob);
+};
+
 class Interpreter {
  public:
   explicit Interpreter(Isolate* isolate);
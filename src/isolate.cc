@@ -18,6 +18,7 @@
 #include "src/codegen.h"
 #include "src/compilation-cache.h"
 #include "src/compilation-statistics.h"
+#include "src/compiler-dispatcher/compiler-dispatcher.h"
 #include "src/crankshaft/hydrogen.h"
 #include "src/debug/debug.h"
 #include "src/deoptimizer.h"
@@ -2004,6 +2005,7 @@ Isolate::Isolate(bool enable_serializer)
       function_entry_hook_(NULL),
       deferred_handles_head_(NULL),
       optimizing_compile_dispatcher_(NULL),
+      compiler_dispatcher_(NULL),
       stress_deopt_count_(0),
       virtual_handler_register_(NULL),
       virtual_slot_register_(NULL),
@@ -2113,6 +2115,10 @@ void Isolate::Deinit() {
     optimizing_compile_dispatcher_ = NULL;
   }
 
+  if (compiler_dispatcher_ != NULL) {
+    compiler_dispatcher_->AbortAll();
+  }
+
   if (heap_.mark_compact_collector()->sweeping_in_progress()) {
     heap_.mark_compact_collector()->EnsureSweepingCompleted();
   }
@@ -2155,6 +2161,9 @@ void Isolate::Deinit() {
 
   cancelable_task_manager()->CancelAndWait();
 
+  delete compiler_dispatcher_;
+  compiler_dispatcher_ = NULL;
+
   delete cpu_profiler_;
   cpu_profiler_ = NULL;
 
@@ -2432,6 +2441,11 @@ bool Isolate::Init(Deserializer* des) {
     optimizing_compile_dispatcher_ = new OptimizingCompileDispatcher(this);
   }
 
+  if (CompilerDispatcher::Enabled()) {
+    compiler_dispatcher_ =
+        new CompilerDispatcher(this, V8::GetCurrentPlatform(), FLAG_stack_size);
+  }
+
   // Initialize runtime profiler before deserialization, because collections may
   // occur, clearing/updating ICs.
   runtime_profiler_ = new RuntimeProfiler(this);
@@ -2603,9 +2617,8 @@ void Isolate::UnlinkDeferredHandles(DeferredHandles* deferred) {
 
 
 void Isolate::DumpAndResetCompilationStats() {
-  if (turbo_statistics() != nullptr) {
-    DCHECK(FLAG_turbo_stats || FLAG_turbo_stats_nvp);
-
+  if (turbo_statistics() != nullptr &&
+      (FLAG_turbo_stats || FLAG_turbo_stats_nvp)) {
     OFStream os(stdout);
     if (FLAG_turbo_stats) {
       AsPrintableStatistics ps = {*turbo_statistics(), false};
@@ -3109,7 +3122,8 @@ void Isolate::SetTailCallEliminationEnabled(bool enabled) {
   // TODO(ishell): Introduce DependencyGroup::kTailCallChangedGroup to
   // deoptimize only those functions that are affected by the change of this
   // flag.
-  internal::Deoptimizer::DeoptimizeAll(this);
+  internal::Deoptimizer::DeoptimizeAll(this,
+                                      DeoptimizeReason::kDependencyChange);
 }
 
 // Heap::detached_contexts tracks detached contexts as pairs
@@ -52,6 +52,7 @@ class CodeStubDescriptor;
 class CodeTracer;
 class CompilationCache;
 class CompilationStatistics;
+class CompilerDispatcher;
 class ContextSlotCache;
 class Counters;
 class CpuFeatures;
@@ -425,6 +426,8 @@ typedef List<HeapObject*> DebugObjectCache;
   V(int, pending_microtask_count, 0)                                          \
   V(HStatistics*, hstatistics, nullptr)                                       \
   V(CompilationStatistics*, turbo_statistics, nullptr)                        \
+  /* true once the embedder enabled compile statistics through the API. */    \
+  V(bool, compile_statistics_enabled, false)                                  \
   V(HTracer*, htracer, nullptr)                                               \
   V(CodeTracer*, code_tracer, nullptr)                                        \
   V(bool, fp_stubs_generated, false)                                          \
@@ -1051,10 +1054,19 @@ class Isolate {
     return optimizing_compile_dispatcher_;
   }
 
+  // Null unless lazy functions are compiled in the background.
+  CompilerDispatcher* compiler_dispatcher() { return compiler_dispatcher_; }
+
   int id() const { return static_cast<int>(id_); }
 
   HStatistics* GetHStatistics();
   CompilationStatistics* GetTurboStatistics();
+  // Compile statistics are collected for --turbo-stats and --turbo-stats-nvp,
+  // or once the embedder enabled them.
+  bool collect_compile_statistics() {
+    return FLAG_turbo_stats || FLAG_turbo_stats_nvp ||
+           compile_statistics_enabled();
+  }
   HTracer* GetHTracer();
   CodeTracer* GetCodeTracer();
 
@@ -1406,6 +1418,7 @@ class Isolate {
 
   DeferredHandles* deferred_handles_head_;
   OptimizingCompileDispatcher* optimizing_compile_dispatcher_;
+  CompilerDispatcher* compiler_dispatcher_;
 
   // Counts deopt points if deopt_every_n_times is enabled.
   unsigned int stress_deopt_count_;
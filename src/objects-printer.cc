@@ -1271,6 +1271,8 @@ void Script::ScriptPrint(std::ostream& os) {  // NOLINT
   os << "\n - eval from shared: " << Brief(eval_from_shared());
   os << "\n - eval from position: " << eval_from_position();
   os << "\n - shared function infos: " << Brief(shared_function_infos());
+  os << "\n - optimization hints: " << Brief(optimization_hints());
+  os << "\n - skippable functions: " << Brief(skippable_functions());
   os << "\n";
 }
 
@@ -13129,6 +13129,57 @@ MaybeHandle<SharedFunctionInfo> Script::FindSharedFunctionInfo(
 }
 
 
+// static
+void Script::SetOptimizationHints(Handle<Script> script,
+                                  Handle<Script> hot_script) {
+  Isolate* isolate = script->GetIsolate();
+  List<int> positions;
+  WeakFixedArray::Iterator iterator(hot_script->shared_function_infos());
+  SharedFunctionInfo* shared;
+  while ((shared = iterator.Next<SharedFunctionInfo>())) {
+    if (shared->opt_count() > 0 && !shared->optimization_disabled()) {
+      positions.Add(shared->start_position());
+    }
+  }
+  if (hot_script->optimization_hints()->IsFixedArray()) {
+    FixedArray* hints = FixedArray::cast(hot_script->optimization_hints());
+    for (int i = 0; i < hints->length(); i++) {
+      int position = Smi::cast(hints->get(i))->value();
+      if (position == kNoSourcePosition) continue;  // Cleared hint.
+      if (!positions.Contains(position)) positions.Add(position);
+    }
+  }
+  if (positions.is_empty()) return;
+  Handle<FixedArray> hints =
+      isolate->factory()->NewFixedArray(positions.length(), TENURED);
+  for (int i = 0; i < positions.length(); i++) {
+    hints->set(i, Smi::FromInt(positions[i]));
+  }
+  script->set_optimization_hints(*hints);
+}
+
+
+bool Script::HasOptimizationHint(int position) {
+  if (!optimization_hints()->IsFixedArray()) return false;
+  FixedArray* hints = FixedArray::cast(optimization_hints());
+  for (int i = 0; i < hints->length(); i++) {
+    if (Smi::cast(hints->get(i))->value() == position) return true;
+  }
+  return false;
+}
+
+
+void Script::ClearOptimizationHint(int position) {
+  if (!optimization_hints()->IsFixedArray()) return;
+  FixedArray* hints = FixedArray::cast(optimization_hints());
+  for (int i = 0; i < hints->length(); i++) {
+    if (Smi::cast(hints->get(i))->value() == position) {
+      hints->set(i, Smi::FromInt(kNoSourcePosition));
+    }
+  }
+}
+
+
 Script::Iterator::Iterator(Isolate* isolate)
     : iterator_(isolate->heap()->script_list()) {}
 
@@ -14659,6 +14710,19 @@ void BytecodeArray::CopyBytecodesTo(BytecodeArray* to) {
             from->length());
 }
 
+void BytecodeArray::MakeOlder() {
+  Age age = bytecode_age();
+  if (age < kLastBytecodeAge) {
+    set_bytecode_age(static_cast<Age>(age + 1));
+  }
+  DCHECK_GE(bytecode_age(), kFirstBytecodeAge);
+  DCHECK_LE(bytecode_age(), kLastBytecodeAge);
+}
+
+bool BytecodeArray::IsOld() const {
+  return bytecode_age() >= kIsOldBytecodeAge;
+}
+
 int BytecodeArray::LookupRangeInHandlerTable(
     int code_offset, int* data, HandlerTable::CatchPrediction* prediction) {
   HandlerTable* table = HandlerTable::cast(handler_table());
@@ -14935,7 +14999,10 @@ void DependentCode::DeoptimizeDependentCodeGroup(
   DCHECK(AllowCodeDependencyChange::IsAllowed());
   DisallowHeapAllocation no_allocation_scope;
   bool marked = MarkCodeForDeoptimization(isolate, group);
-  if (marked) Deoptimizer::DeoptimizeMarkedCode(isolate);
+  if (marked) {
+    Deoptimizer::DeoptimizeMarkedCode(isolate,
+                                      DeoptimizeReason::kDependencyChange);
+  }
 }
 
 
@@ -4604,6 +4604,20 @@ class ByteArray: public FixedArrayBase {
 // BytecodeArray represents a sequence of interpreter bytecodes.
 class BytecodeArray : public FixedArrayBase {
  public:
+  enum Age {
+    kNoAgeBytecodeAge = 0,
+    kQuadragenarianBytecodeAge,
+    kQuinquagenarianBytecodeAge,
+    kSexagenarianBytecodeAge,
+    kSeptuagenarianBytecodeAge,
+    kOctogenarianBytecodeAge,
+    kAfterLastBytecodeAge,
+    kFirstBytecodeAge = kNoAgeBytecodeAge,
+    kLastBytecodeAge = kAfterLastBytecodeAge - 1,
+    kBytecodeAgeCount = kAfterLastBytecodeAge - kFirstBytecodeAge - 1,
+    kIsOldBytecodeAge = kSexagenarianBytecodeAge
+  };
+
   static int SizeFor(int length) {
     return OBJECT_POINTER_ALIGN(kHeaderSize + length);
   }
@@ -4634,6 +4648,11 @@ class BytecodeArray : public FixedArrayBase {
   inline int osr_loop_nesting_level() const;
   inline void set_osr_loop_nesting_level(int depth);
 
+  // Accessors for bytecode's code age. The age is reset by the interpreter
+  // entry trampoline and incremented by each full GC that marks the array.
+  inline Age bytecode_age() const;
+  inline void set_bytecode_age(Age age);
+
   // Accessors for the constant pool.
   DECL_ACCESSORS(constant_pool, FixedArray)
 
@@ -4665,6 +4684,10 @@ class BytecodeArray : public FixedArrayBase {
 
   void CopyBytecodesTo(BytecodeArray* to);
 
+  // Bytecode aging
+  bool IsOld() const;
+  void MakeOlder();
+
   int LookupRangeInHandlerTable(int code_offset, int* data,
                                 HandlerTable::CatchPrediction* prediction);
 
@@ -4677,7 +4700,8 @@ class BytecodeArray : public FixedArrayBase {
   static const int kParameterSizeOffset = kFrameSizeOffset + kIntSize;
   static const int kInterruptBudgetOffset = kParameterSizeOffset + kIntSize;
   static const int kOSRNestingLevelOffset = kInterruptBudgetOffset + kIntSize;
-  static const int kHeaderSize = kOSRNestingLevelOffset + kCharSize;
+  static const int kBytecodeAgeOffset = kOSRNestingLevelOffset + kCharSize;
+  static const int kHeaderSize = kBytecodeAgeOffset + kCharSize;
 
   // Maximal memory consumption for a single BytecodeArray.
   static const int kMaxSize = 512 * MB;
@@ -6657,6 +6681,15 @@ class Script: public Struct {
   // [source_mapping_url]: sourceMappingURL magic comment
   DECL_ACCESSORS(source_mapping_url, Object)
 
+  // [optimization_hints]: start positions of the functions that were
+  // optimized when the code cache for this script was produced, or undefined.
+  DECL_ACCESSORS(optimization_hints, Object)
+
+  // [skippable_functions]: scope data of inner functions that were parsed but
+  // compiled lazily, which allows later parses of their enclosing functions
+  // to skip them, or undefined. See Parser::InternalizeSkippableFunctions.
+  DECL_ACCESSORS(skippable_functions, Object)
+
   // [wasm_object]: the wasm object this script belongs to.
   // This must only be called if the type of this script is TYPE_WASM.
   DECL_ACCESSORS(wasm_object, JSObject)
@@ -6738,6 +6771,19 @@ class Script: public Struct {
   // that matches the function literal.  Return empty handle if not found.
   MaybeHandle<SharedFunctionInfo> FindSharedFunctionInfo(FunctionLiteral* fun);
 
+  // Record the functions of {hot_script} that have been optimized as
+  // optimization hints of {script}, so that they are serialized with it.
+  // Hints already recorded on {hot_script} are carried over.
+  static void SetOptimizationHints(Handle<Script> script,
+                                   Handle<Script> hot_script);
+
+  // Returns true if the function starting at {position} was optimized when
+  // this script was cached.
+  bool HasOptimizationHint(int position);
+
+  // Drops the hint for the function starting at {position} once it was used.
+  void ClearOptimizationHint(int position);
+
   // Iterate over all script objects on the heap.
   class Iterator {
    public:
@@ -6770,7 +6816,11 @@ class Script: public Struct {
   static const int kFlagsOffset = kSharedFunctionInfosOffset + kPointerSize;
   static const int kSourceUrlOffset = kFlagsOffset + kPointerSize;
   static const int kSourceMappingUrlOffset = kSourceUrlOffset + kPointerSize;
-  static const int kSize = kSourceMappingUrlOffset + kPointerSize;
+  static const int kOptimizationHintsOffset =
+      kSourceMappingUrlOffset + kPointerSize;
+  static const int kSkippableFunctionsOffset =
+      kOptimizationHintsOffset + kPointerSize;
+  static const int kSize = kSkippableFunctionsOffset + kPointerSize;
 
  private:
   int GetLineNumberWithArray(int code_pos);
@@ -844,6 +844,7 @@ Parser::Parser(ParseInfo* info)
       cached_parse_data_(NULL),
       total_preparse_skipped_(0),
       pre_parse_timer_(NULL),
+      next_skippable_function_(0),
       parsing_on_main_thread_(true) {
   // Even though we were passed ParseInfo, we should not store it in
   // Parser - this makes sure that Isolate is not accidentally accessed via
@@ -1095,6 +1096,8 @@ FunctionLiteral* Parser::ParseLazy(Isolate* isolate, ParseInfo* info) {
   Handle<SharedFunctionInfo> shared_info = info->shared_info();
   DeserializeScopeChain(info, info->context(),
                         Scope::DeserializationMode::kKeepScopeInfo);
+  LoadSkippableFunctions(info->script(), shared_info->start_position(),
+                         shared_info->end_position());
 
   // Initialize parser state.
   source = String::Flatten(source);
@@ -4327,12 +4330,14 @@ FunctionLiteral* Parser::ParseFunctionLiteral(
   // - The function literal shouldn't be hinted to eagerly compile.
   // - For asm.js functions the body needs to be available when module
   //   validation is active, because we examine the entire module at once.
+  // - When a function is compiled lazily, its own body is always needed.
   bool use_temp_zone =
       !is_lazily_parsed && FLAG_lazy && !allow_natives() &&
       extension_ == NULL && allow_lazy() &&
       function_type == FunctionLiteral::kDeclaration &&
       eager_compile_hint != FunctionLiteral::kShouldEagerCompile &&
-      !(FLAG_validate_asm && scope()->asm_module());
+      !(FLAG_validate_asm && scope()->asm_module()) &&
+      this->scope() != original_scope_;
 
   DeclarationScope* main_scope = nullptr;
   if (use_temp_zone) {
@@ -4347,6 +4352,10 @@ FunctionLiteral* Parser::ParseFunctionLiteral(
   DuplicateFinder duplicate_finder(scanner()->unicode_cache());
   bool should_be_used_once_hint = false;
   bool has_duplicate_parameters;
+  bool body_was_skipped = false;
+  int function_block_pos = kNoSourcePosition;
+  int literals_before_body = 0;
+  int properties_before_body = 0;
 
   {
     // Temporary zones can nest. When we migrate free variables (see below), we
@@ -4403,6 +4412,9 @@ FunctionLiteral* Parser::ParseFunctionLiteral(
     CheckArityRestrictions(arity, kind, formals.has_rest, start_position,
                            formals_end_position, CHECK_OK);
     Expect(Token::LBRACE, CHECK_OK);
+    function_block_pos = position();
+    literals_before_body = function_state.materialized_literal_count();
+    properties_before_body = function_state.expected_property_count();
     // Don't include the rest parameter into the function's formal parameter
     // count (esp. the SharedFunctionInfo::internal_formal_parameter_count,
     // which says whether we need to create an arguments adaptor frame).
@@ -4435,7 +4447,17 @@ FunctionLiteral* Parser::ParseFunctionLiteral(
         should_be_used_once_hint = true;
       }
     }
-    if (!is_lazily_parsed) {
+    if (use_temp_zone) {
+      // The body is not kept anyway, so there's no need to parse it again if
+      // an earlier parse recorded its scope data.
+      body_was_skipped = SkipAnalysedFunctionBody(
+          &materialized_literal_count, &expected_property_count, CHECK_OK);
+      if (body_was_skipped) {
+        materialized_literal_count += literals_before_body;
+        expected_property_count += properties_before_body;
+      }
+    }
+    if (!is_lazily_parsed && !body_was_skipped) {
       body = ParseEagerFunctionBody(function_name, pos, formals, kind,
                                     function_type, CHECK_OK);
 
@@ -4481,6 +4503,12 @@ FunctionLiteral* Parser::ParseFunctionLiteral(
     }
   }  // DiscardableZoneScope goes out of scope.
 
+  if (use_temp_zone && !body_was_skipped && FLAG_lazy_inner_functions) {
+    RecordSkippableFunction(main_scope, function_block_pos,
+                            materialized_literal_count - literals_before_body,
+                            expected_property_count - properties_before_body);
+  }
+
   FunctionLiteral::ParameterFlag duplicate_parameters =
       has_duplicate_parameters ? FunctionLiteral::kHasDuplicateParameters
                                : FunctionLiteral::kNoDuplicateParameters;
@@ -4602,6 +4630,316 @@ void Parser::SkipLazyFunctionBody(int* materialized_literal_count,
   }
 }
 
+void Parser::LoadSkippableFunctions(Handle<Script> script, int start_position,
+                                    int end_position) {
+  DCHECK(parsing_on_main_thread_);
+  DCHECK(skippable_functions_.is_empty());
+  if (!FLAG_lazy_inner_functions || !allow_lazy()) return;
+  if (!script->skippable_functions()->IsArrayList()) return;
+  Isolate* isolate = script->GetIsolate();
+  Handle<ArrayList> chunks(ArrayList::cast(script->skippable_functions()),
+                           isolate);
+  const int kRecordSize = SkippableFunction::kRecordSize;
+
+  // Records of functions in the range, as (chunk, record) indices. Several
+  // parses may have recorded the same function, and functions nested in
+  // others are not needed, since their enclosing functions are skipped as a
+  // whole. These are filtered out once the candidates are sorted.
+  struct Candidate {
+    int start_position;
+    int end_position;
+    int chunk;
+    int record;
+  };
+  List<Candidate> candidates;
+  bool has_live_chunks = false;
+  for (int c = 0; c < chunks->Length(); c++) {
+    if (!chunks->Get(c)->IsFixedArray()) continue;
+    FixedArray* chunk = FixedArray::cast(chunks->Get(c));
+    ByteArray* records =
+        ByteArray::cast(chunk->get(SkippableFunction::kRecordsIndex));
+    int count = records->length() / (kRecordSize * kIntSize);
+
+    // Find the first record that starts after |start_position|.
+    int from = 0, to = count;
+    while (from < to) {
+      int middle = from + (to - from) / 2;
+      if (records->get_int(middle * kRecordSize +
+                           FunctionEntry::kStartPositionIndex) <=
+          start_position) {
+        from = middle + 1;
+      } else {
+        to = middle;
+      }
+    }
+
+    int live_count =
+        Smi::cast(chunk->get(SkippableFunction::kLiveCountIndex))->value();
+    for (int r = from; r < count; r++) {
+      int offset = r * kRecordSize;
+      Candidate candidate;
+      candidate.start_position =
+          records->get_int(offset + FunctionEntry::kStartPositionIndex);
+      candidate.end_position =
+          records->get_int(offset + FunctionEntry::kEndPositionIndex);
+      if (candidate.start_position >= end_position) break;
+      if (candidate.end_position == SkippableFunction::kDroppedEndPosition) {
+        continue;
+      }
+      if (candidate.end_position >= end_position) {
+        // This is the record of the function itself, which is being compiled
+        // now and won't be parsed lazily again.
+        records->set_int(offset + FunctionEntry::kEndPositionIndex,
+                         SkippableFunction::kDroppedEndPosition);
+        live_count--;
+        continue;
+      }
+      candidate.chunk = c;
+      candidate.record = r;
+      candidates.Add(candidate);
+    }
+    if (live_count == 0) {
+      chunks->Clear(c, isolate->heap()->undefined_value());
+    } else {
+      chunk->set(SkippableFunction::kLiveCountIndex, Smi::FromInt(live_count));
+      has_live_chunks = true;
+    }
+  }
+  if (!has_live_chunks) {
+    script->set_skippable_functions(isolate->heap()->undefined_value());
+  }
+
+  candidates.Sort([](const Candidate* a, const Candidate* b) {
+    return Compare(a->start_position, b->start_position);
+  });
+  int skipped_until = start_position;
+  for (const Candidate& candidate : candidates) {
+    if (candidate.start_position < skipped_until) continue;
+    skipped_until = candidate.end_position;
+
+    FixedArray* chunk = FixedArray::cast(chunks->Get(candidate.chunk));
+    ByteArray* records =
+        ByteArray::cast(chunk->get(SkippableFunction::kRecordsIndex));
+    Handle<FixedArray> free_variables(
+        FixedArray::cast(chunk->get(SkippableFunction::kFreeVariablesIndex)),
+        isolate);
+    int offset = candidate.record * kRecordSize;
+    SkippableFunction function;
+    function.start_position = candidate.start_position;
+    function.end_position = candidate.end_position;
+    function.literal_count =
+        records->get_int(offset + FunctionEntry::kLiteralCountIndex);
+    function.property_count =
+        records->get_int(offset + FunctionEntry::kPropertyCountIndex);
+    function.language_mode = static_cast<LanguageMode>(
+        records->get_int(offset + FunctionEntry::kLanguageModeIndex));
+    DCHECK(is_valid_language_mode(function.language_mode));
+    function.uses_super_property =
+        records->get_int(offset + FunctionEntry::kUsesSuperPropertyIndex) != 0;
+    function.calls_eval =
+        records->get_int(offset + FunctionEntry::kCallsEvalIndex) != 0;
+    function.inner_scope_calls_eval =
+        records->get_int(offset +
+                         SkippableFunction::kInnerScopeCallsEvalIndex) != 0;
+    function.first_free_variable = skippable_function_variables_.length();
+    function.free_variable_count = records->get_int(
+        offset + SkippableFunction::kFreeVariableCountIndex);
+    int first = records->get_int(offset +
+                                 SkippableFunction::kFirstFreeVariableIndex);
+    for (int i = 0; i < function.free_variable_count; i++) {
+      int entry = (first + i) * SkippableFunction::kFreeVariableSize;
+      Handle<String> name(
+          String::cast(free_variables->get(
+              entry + SkippableFunction::kFreeVariableNameOffset)),
+          isolate);
+      SkippableFunction::FreeVariable variable;
+      variable.name = ast_value_factory()->GetString(name);
+      Object* is_assigned = free_variables->get(
+          entry + SkippableFunction::kFreeVariableIsAssignedOffset);
+      variable.is_assigned = Smi::cast(is_assigned)->value() != 0;
+      skippable_function_variables_.Add(variable);
+    }
+    skippable_functions_.Add(function);
+  }
+}
+
+bool Parser::SkipAnalysedFunctionBody(int* materialized_literal_count,
+                                      int* expected_property_count, bool* ok) {
+  int function_block_pos = position();
+  while (next_skippable_function_ < skippable_functions_.length() &&
+         skippable_functions_[next_skippable_function_].start_position <
+             function_block_pos) {
+    ++next_skippable_function_;
+  }
+  if (next_skippable_function_ == skippable_functions_.length()) return false;
+  const SkippableFunction& function =
+      skippable_functions_[next_skippable_function_];
+  if (function.start_position != function_block_pos) return false;
+  ++next_skippable_function_;
+
+  scanner()->SeekForward(function.end_position - 1);
+  scope()->set_end_position(function.end_position);
+  Expect(Token::RBRACE, ok);
+  if (!*ok) return false;
+  total_preparse_skipped_ += scope()->end_position() - function_block_pos;
+  *materialized_literal_count = function.literal_count;
+  *expected_property_count = function.property_count;
+  SetLanguageMode(scope(), function.language_mode);
+  if (function.uses_super_property) scope()->RecordSuperPropertyUsage();
+  if (function.calls_eval) scope()->RecordEvalCall();
+  if (function.inner_scope_calls_eval) scope()->RecordInnerScopeEvalCall();
+  for (int i = 0; i < function.free_variable_count; i++) {
+    const SkippableFunction::FreeVariable& variable =
+        skippable_function_variables_[function.first_free_variable + i];
+    VariableProxy* proxy = scope()->NewUnresolved(factory(), variable.name);
+    if (variable.is_assigned) proxy->set_is_assigned();
+  }
+  return true;
+}
+
+void Parser::RecordSkippableFunction(DeclarationScope* scope,
+                                     int function_block_pos,
+                                     int materialized_literal_count,
+                                     int expected_property_count) {
+  SkippableFunction function;
+  function.start_position = function_block_pos;
+  function.end_position = scope->end_position();
+  function.literal_count = materialized_literal_count;
+  function.property_count = expected_property_count;
+  function.language_mode = scope->language_mode();
+  function.uses_super_property = scope->uses_super_property();
+  function.calls_eval = scope->calls_eval();
+  function.inner_scope_calls_eval = scope->inner_scope_calls_eval();
+  function.first_free_variable = new_skippable_function_variables_.length();
+
+  // The free variables are what AnalyzePartially migrated to |scope|. A
+  // variable that is referred to more than once needs only one entry.
+  base::HashMap seen(base::HashMap::PointersMatch);
+  for (VariableProxy* proxy = scope->unresolved(); proxy != nullptr;
+       proxy = proxy->next_unresolved()) {
+    // Only plain variables are replayed by SkipAnalysedFunctionBody.
+    if (proxy->is_this() || proxy->is_new_target()) {
+      new_skippable_function_variables_.Rewind(function.first_free_variable);
+      return;
+    }
+    const AstRawString* name = proxy->raw_name();
+    base::HashMap::Entry* entry = seen.LookupOrInsert(
+        const_cast<AstRawString*>(name), name->hash());
+    if (entry->value == nullptr) {
+      entry->value = reinterpret_cast<void*>(static_cast<intptr_t>(
+          new_skippable_function_variables_.length() + 1));
+      SkippableFunction::FreeVariable variable;
+      variable.name = name;
+      variable.is_assigned = false;
+      new_skippable_function_variables_.Add(variable);
+    }
+    if (proxy->is_assigned()) {
+      int index =
+          static_cast<int>(reinterpret_cast<intptr_t>(entry->value)) - 1;
+      new_skippable_function_variables_[index].is_assigned = true;
+    }
+  }
+  function.free_variable_count = new_skippable_function_variables_.length() -
+                                 function.first_free_variable;
+  new_skippable_functions_.Add(function);
+}
+
+void Parser::InternalizeSkippableFunctions(Isolate* isolate,
+                                           Handle<Script> script) {
+  if (new_skippable_functions_.is_empty()) return;
+  new_skippable_functions_.Sort(
+      [](const SkippableFunction* a, const SkippableFunction* b) {
+        return Compare(a->start_position, b->start_position);
+      });
+
+  const int kRecordSize = SkippableFunction::kRecordSize;
+  const int kFreeVariableSize = SkippableFunction::kFreeVariableSize;
+  int count = 0;
+  for (int i = 0; i < new_skippable_functions_.length(); i++) {
+    if (i == 0 || new_skippable_functions_[i - 1].start_position !=
+                      new_skippable_functions_[i].start_position) {
+      count++;
+    }
+  }
+  Handle<ByteArray> records =
+      isolate->factory()->NewByteArray(count * kRecordSize * kIntSize, TENURED);
+  Handle<FixedArray> free_variables = isolate->factory()->NewFixedArray(
+      new_skippable_function_variables_.length() * kFreeVariableSize, TENURED);
+  Handle<FixedArray> chunk =
+      isolate->factory()->NewFixedArray(SkippableFunction::kChunkSize, TENURED);
+
+  {
+    DisallowHeapAllocation no_gc;
+    int next_variable = 0;
+    for (int i = 0, k = 0; i < new_skippable_functions_.length(); i++) {
+      const SkippableFunction& function = new_skippable_functions_[i];
+      if (i > 0 && new_skippable_functions_[i - 1].start_position ==
+                       function.start_position) {
+        continue;
+      }
+      int offset = k++ * kRecordSize;
+      records->set_int(offset + FunctionEntry::kStartPositionIndex,
+                       function.start_position);
+      records->set_int(offset + FunctionEntry::kEndPositionIndex,
+                       function.end_position);
+      records->set_int(offset + FunctionEntry::kLiteralCountIndex,
+                       function.literal_count);
+      records->set_int(offset + FunctionEntry::kPropertyCountIndex,
+                       function.property_count);
+      records->set_int(offset + FunctionEntry::kLanguageModeIndex,
+                       function.language_mode);
+      records->set_int(offset + FunctionEntry::kUsesSuperPropertyIndex,
+                       function.uses_super_property);
+      records->set_int(offset + FunctionEntry::kCallsEvalIndex,
+                       function.calls_eval);
+      records->set_int(offset + SkippableFunction::kInnerScopeCallsEvalIndex,
+                       function.inner_scope_calls_eval);
+      records->set_int(offset + SkippableFunction::kFirstFreeVariableIndex,
+                       next_variable);
+      records->set_int(offset + SkippableFunction::kFreeVariableCountIndex,
+                       function.free_variable_count);
+      for (int v = 0; v < function.free_variable_count; v++) {
+        const SkippableFunction::FreeVariable& variable =
+            new_skippable_function_variables_[function.first_free_variable +
+                                              v];
+        int entry = next_variable++ * kFreeVariableSize;
+        free_variables->set(entry + SkippableFunction::kFreeVariableNameOffset,
+                            *variable.name->string());
+        free_variables->set(
+            entry + SkippableFunction::kFreeVariableIsAssignedOffset,
+            Smi::FromInt(variable.is_assigned ? 1 : 0));
+      }
+    }
+    chunk->set(SkippableFunction::kRecordsIndex, *records);
+    chunk->set(SkippableFunction::kFreeVariablesIndex, *free_variables);
+    chunk->set(SkippableFunction::kLiveCountIndex, Smi::FromInt(count));
+  }
+
+  // Append the chunk, and drop the chunks whose functions were all compiled
+  // in the meantime if they make up at least half of the list.
+  Handle<ArrayList> chunks =
+      Handle<ArrayList>::cast(isolate->factory()->empty_fixed_array());
+  if (script->skippable_functions()->IsArrayList()) {
+    chunks = handle(ArrayList::cast(script->skippable_functions()), isolate);
+    int live_chunks = 0;
+    for (int c = 0; c < chunks->Length(); c++) {
+      if (chunks->Get(c)->IsFixedArray()) live_chunks++;
+    }
+    if (2 * live_chunks <= chunks->Length()) {
+      Handle<ArrayList> old_chunks = chunks;
+      chunks = Handle<ArrayList>::cast(isolate->factory()->NewFixedArray(
+          live_chunks + 2, TENURED));
+      chunks->SetLength(0);
+      for (int c = 0; c < old_chunks->Length(); c++) {
+        if (!old_chunks->Get(c)->IsFixedArray()) continue;
+        chunks = ArrayList::Add(chunks, handle(old_chunks->Get(c), isolate));
+      }
+    }
+  }
+  chunks = ArrayList::Add(chunks, chunk);
+  script->set_skippable_functions(*chunks);
+}
+
 
 Statement* Parser::BuildAssertIsCoercible(Variable* var) {
   // if (var === null || var === undefined)
@@ -5399,6 +5737,9 @@ void Parser::Internalize(Isolate* isolate, Handle<Script> script, bool error) {
   }
   isolate->counters()->total_preparse_skipped()->Increment(
       total_preparse_skipped_);
+  if (!error && !script.is_null()) {
+    InternalizeSkippableFunctions(isolate, script);
+  }
 }
 
 
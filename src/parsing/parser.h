@@ -324,6 +324,50 @@ class ParseData {
   DISALLOW_COPY_AND_ASSIGN(ParseData);
 };
 
+// Scope data of an inner function whose body was parsed but not kept, see
+// Script::skippable_functions. Besides what a FunctionEntry has, the scope
+// analysis of the enclosing function needs to know whether inner scopes of
+// the function call eval, and which variables it refers to from outside.
+struct SkippableFunction {
+  // Script::skippable_functions is an ArrayList with one chunk per parse
+  // that recorded functions. A chunk holds a ByteArray of records sorted by
+  // start position, a FixedArray of (name, is assigned) pairs which the
+  // records refer to for their free variables, and the number of records
+  // that were not dropped yet. A record is dropped when its function is
+  // compiled, and a chunk once all of its records are.
+  enum { kRecordsIndex, kFreeVariablesIndex, kLiveCountIndex, kChunkSize };
+  // End position of dropped records.
+  enum { kDroppedEndPosition = -1 };
+  enum {
+    kInnerScopeCallsEvalIndex = FunctionEntry::kSize,
+    kFirstFreeVariableIndex,
+    kFreeVariableCountIndex,
+    kRecordSize
+  };
+  enum {
+    kFreeVariableNameOffset,
+    kFreeVariableIsAssignedOffset,
+    kFreeVariableSize
+  };
+
+  struct FreeVariable {
+    const AstRawString* name;
+    bool is_assigned;
+  };
+
+  int start_position;  // Position of the opening {.
+  int end_position;    // Position after the closing }.
+  int literal_count;   // Literals of the body, not counting the formals.
+  int property_count;
+  LanguageMode language_mode;
+  bool uses_super_property;
+  bool calls_eval;
+  bool inner_scope_calls_eval;
+  // Index of the first free variable in the parser's list of free variables.
+  int first_free_variable;
+  int free_variable_count;
+};
+
 // ----------------------------------------------------------------------------
 // JAVASCRIPT PARSING
 
@@ -754,6 +798,12 @@ class Parser : public ParserBase<ParserTraits> {
   void DeserializeScopeChain(ParseInfo* info, Handle<Context> context,
                              Scope::DeserializationMode deserialization_mode);
 
+  // Loads the scope data recorded on |script| for the functions directly
+  // nested between |start_position| and |end_position|, which allows the
+  // parser to skip their bodies. Only called on the main thread.
+  void LoadSkippableFunctions(Handle<Script> script, int start_position,
+                              int end_position);
+
   // Handle errors detected during parsing, move statistics to Isolate,
   // internalize strings (move them to the heap).
   void Internalize(Isolate* isolate, Handle<Script> script, bool error);
@@ -1124,6 +1174,19 @@ class Parser : public ParserBase<ParserTraits> {
   PreParser::PreParseResult ParseLazyFunctionBodyWithPreParser(
       SingletonLogger* logger, Scanner::BookmarkScope* bookmark = nullptr);
 
+  // Skip over the body of an inner function that is parsed into a temporary
+  // zone, using the scope data loaded by LoadSkippableFunctions. Returns false
+  // if there is no such data. Otherwise consumes the ending }.
+  bool SkipAnalysedFunctionBody(int* materialized_literal_count,
+                                int* expected_property_count, bool* ok);
+
+  // Record the scope data of an inner function whose body was parsed into a
+  // temporary zone and migrated to |scope|.
+  void RecordSkippableFunction(DeclarationScope* scope, int function_block_pos,
+                               int materialized_literal_count,
+                               int expected_property_count);
+  void InternalizeSkippableFunctions(Isolate* isolate, Handle<Script> script);
+
   Block* BuildParameterInitializationBlock(
       const ParserFormalParameters& parameters, bool* ok);
   Block* BuildRejectPromiseOnException(Block* block);
@@ -1190,6 +1253,16 @@ class Parser : public ParserBase<ParserTraits> {
   int total_preparse_skipped_;
   HistogramTimer* pre_parse_timer_;
 
+  // Scope data loaded from the script, sorted by start position, and the index
+  // of the next function to skip. Functions are looked up in source order.
+  List<SkippableFunction> skippable_functions_;
+  List<SkippableFunction::FreeVariable> skippable_function_variables_;
+  int next_skippable_function_;
+
+  // Scope data recorded while parsing, which is added to the script.
+  List<SkippableFunction> new_skippable_functions_;
+  List<SkippableFunction::FreeVariable> new_skippable_function_variables_;
+
   bool parsing_on_main_thread_;
 
 #ifdef DEBUG
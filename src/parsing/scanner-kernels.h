@@ -0,0 +1,236 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_PARSING_SCANNER_KERNELS_H_
+#define V8_PARSING_SCANNER_KERNELS_H_
+
+#include <stdint.h>
+#include <string.h>
+
+#include "src/base/bits.h"
+#include "src/base/macros.h"
+#include "src/char-predicates-inl.h"
+
+#if V8_HOST_ARCH_X64
+#include <emmintrin.h>
+#endif
+
+namespace v8 {
+namespace internal {
+
+// Bulk scanning of the stream buffer, see Utf16CharacterStream::
+// AdvanceBuffered.
+//
+// Each scan function below returns a pointer to the first code unit in
+// [cursor, end) that the scanner has to look at one at a time. Blocks of four
+// code units are tested with arithmetic on 64-bit words, which works on
+// either byte order since a block is only checked for whether any of its code
+// units stops the scan. On x64, eight code units are classified at once with
+// SSE2 instead. The code units that remain are classified one at a time.
+//
+// Every scan class provides Stops() for a single code unit, StopsInWord() for
+// a 64-bit word and, on x64, StopsInVector() which returns a mask of the code
+// units that stop the scan.
+namespace scanner_kernels {
+
+inline uint64_t SplatWord(uint16_t code_unit) {
+  return code_unit * V8_UINT64_C(0x0001000100010001);
+}
+
+// Whether any of the four code units in |block| is zero.
+inline bool HasZero(uint64_t block) {
+  return ((block - SplatWord(0x0001)) & ~block & SplatWord(0x8000)) != 0;
+}
+
+inline bool Contains(uint64_t block, uint16_t code_unit) {
+  return HasZero(block ^ SplatWord(code_unit));
+}
+
+inline bool IsAscii(uint64_t block) {
+  return (block & SplatWord(0xFF80)) == 0;
+}
+
+// For ASCII code units only: sets the top bit of the code units that are at
+// least |code_unit|. No carries cross code units.
+inline uint64_t AtLeast(uint64_t block, uint16_t code_unit) {
+  return (block + SplatWord(0x8000 - code_unit)) & SplatWord(0x8000);
+}
+
+inline uint64_t InRange(uint64_t block, uint16_t from, uint16_t to) {
+  return AtLeast(block, from) & ~AtLeast(block, to + 1);
+}
+
+#if V8_HOST_ARCH_X64
+
+inline __m128i Splat(uint16_t code_unit) {
+  return _mm_set1_epi16(static_cast<int16_t>(code_unit));
+}
+
+inline __m128i Equals(__m128i block, uint16_t code_unit) {
+  return _mm_cmpeq_epi16(block, Splat(code_unit));
+}
+
+// Code units in [from, to], compared as unsigned numbers.
+inline __m128i InRange(__m128i block, uint16_t from, uint16_t to) {
+  __m128i offset = _mm_sub_epi16(block, Splat(from));
+  return _mm_cmplt_epi16(_mm_xor_si128(offset, Splat(0x8000)),
+                         Splat((to - from + 1) ^ 0x8000));
+}
+
+inline __m128i IsAscii(__m128i block) {
+  return _mm_cmpeq_epi16(_mm_and_si128(block, Splat(0xFF80)),
+                         _mm_setzero_si128());
+}
+
+inline __m128i Not(__m128i mask) {
+  return _mm_xor_si128(mask, _mm_set1_epi32(-1));
+}
+
+#endif  // V8_HOST_ARCH_X64
+
+// Stops at line terminators: \n, \r, U+2028 and U+2029.
+struct LineTerminatorScan {
+  static bool Stops(uint16_t c) {
+    return c == '\n' || c == '\r' || (c & 0xFFFE) == 0x2028;
+  }
+  static bool StopsInWord(uint64_t block) {
+    return Contains(block, '\n') || Contains(block, '\r') ||
+           Contains(block & SplatWord(0xFFFE), 0x2028);
+  }
+#if V8_HOST_ARCH_X64
+  static __m128i StopsInVector(__m128i block) {
+    return _mm_or_si128(
+        _mm_or_si128(Equals(block, '\n'), Equals(block, '\r')),
+        Equals(_mm_and_si128(block, Splat(0xFFFE)), 0x2028));
+  }
+#endif
+};
+
+// Stops at '*', which may end a multi-line comment, and at line terminators.
+struct MultiLineCommentScan {
+  static bool Stops(uint16_t c) {
+    return c == '*' || LineTerminatorScan::Stops(c);
+  }
+  static bool StopsInWord(uint64_t block) {
+    return Contains(block, '*') || LineTerminatorScan::StopsInWord(block);
+  }
+#if V8_HOST_ARCH_X64
+  static __m128i StopsInVector(__m128i block) {
+    return _mm_or_si128(Equals(block, '*'),
+                        LineTerminatorScan::StopsInVector(block));
+  }
+#endif
+};
+
+// Stops at '*' only, once a multi-line comment is known to span lines.
+struct AsteriskScan {
+  static bool Stops(uint16_t c) { return c == '*'; }
+  static bool StopsInWord(uint64_t block) { return Contains(block, '*'); }
+#if V8_HOST_ARCH_X64
+  static __m128i StopsInVector(__m128i block) { return Equals(block, '*'); }
+#endif
+};
+
+// Stops at anything but spaces and tabs, e.g. after indentation.
+struct SpaceScan {
+  static bool Stops(uint16_t c) { return c != ' ' && c != '\t'; }
+  static bool StopsInWord(uint64_t block) {
+    if (!IsAscii(block)) return true;
+    uint64_t spaces = InRange(block, ' ', ' ') | InRange(block, '\t', '\t');
+    return spaces != SplatWord(0x8000);
+  }
+#if V8_HOST_ARCH_X64
+  static __m128i StopsInVector(__m128i block) {
+    return Not(_mm_or_si128(Equals(block, ' '), Equals(block, '\t')));
+  }
+#endif
+};
+
+// Stops at anything but ASCII identifier characters: a-z, A-Z, 0-9, _ and $.
+struct AsciiIdentifierScan {
+  static bool Stops(uint16_t c) { return !IsAsciiIdentifier(c); }
+  static bool StopsInWord(uint64_t block) {
+    if (!IsAscii(block)) return true;
+    uint64_t lower_case = block | SplatWord(0x20);
+    uint64_t identifier_chars =
+        InRange(lower_case, 'a', 'z') | InRange(block, '0', '9') |
+        InRange(block, '_', '_') | InRange(block, '$', '$');
+    return identifier_chars != SplatWord(0x8000);
+  }
+#if V8_HOST_ARCH_X64
+  static __m128i StopsInVector(__m128i block) {
+    __m128i lower_case = _mm_or_si128(block, Splat(0x20));
+    __m128i letters = InRange(lower_case, 'a', 'z');
+    __m128i digits = InRange(block, '0', '9');
+    __m128i others = _mm_or_si128(Equals(block, '_'), Equals(block, '$'));
+    return Not(_mm_or_si128(_mm_or_si128(letters, digits), others));
+  }
+#endif
+};
+
+// Stops at the characters that end the ASCII fast path of string literals:
+// the quote, backslashes, line terminators and non-ASCII characters.
+template <uint16_t quote>
+struct StringScan {
+  static bool Stops(uint16_t c) {
+    return c > 0x7F || c == quote || c == '\\' || c == '\n' || c == '\r';
+  }
+  static bool StopsInWord(uint64_t block) {
+    return !IsAscii(block) || Contains(block, quote) ||
+           Contains(block, '\\') || Contains(block, '\n') ||
+           Contains(block, '\r');
+  }
+#if V8_HOST_ARCH_X64
+  static __m128i StopsInVector(__m128i block) {
+    __m128i ends = _mm_or_si128(Equals(block, quote), Equals(block, '\\'));
+    __m128i newlines = _mm_or_si128(Equals(block, '\n'), Equals(block, '\r'));
+    return _mm_or_si128(_mm_or_si128(ends, newlines), Not(IsAscii(block)));
+  }
+#endif
+};
+
+template <typename Scan>
+const uint16_t* ScanCodeUnits(const uint16_t* cursor, const uint16_t* end) {
+  while (cursor < end && !Scan::Stops(*cursor)) ++cursor;
+  return cursor;
+}
+
+template <typename Scan>
+const uint16_t* ScanWords(const uint16_t* cursor, const uint16_t* end) {
+  while (end - cursor >= 4) {
+    uint64_t block;
+    memcpy(&block, cursor, sizeof(block));
+    if (Scan::StopsInWord(block)) break;
+    cursor += 4;
+  }
+  return ScanCodeUnits<Scan>(cursor, end);
+}
+
+#if V8_HOST_ARCH_X64
+template <typename Scan>
+const uint16_t* ScanVectors(const uint16_t* cursor, const uint16_t* end) {
+  while (end - cursor >= 8) {
+    __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cursor));
+    int mask = _mm_movemask_epi8(Scan::StopsInVector(block));
+    if (mask != 0) return cursor + base::bits::CountTrailingZeros32(mask) / 2;
+    cursor += 8;
+  }
+  return ScanCodeUnits<Scan>(cursor, end);
+}
+#endif  // V8_HOST_ARCH_X64
+
+template <typename Scan>
+const uint16_t* ScanBuffer(const uint16_t* cursor, const uint16_t* end) {
+#if V8_HOST_ARCH_X64
+  return ScanVectors<Scan>(cursor, end);
+#else
+  return ScanWords<Scan>(cursor, end);
+#endif
+}
+
+}  // namespace scanner_kernels
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_PARSING_SCANNER_KERNELS_H_
@@ -15,6 +15,7 @@
 #include "src/conversions-inl.h"
 #include "src/list-inl.h"
 #include "src/parsing/parser.h"
+#include "src/parsing/scanner-kernels.h"
 
 namespace v8 {
 namespace internal {
@@ -31,6 +32,14 @@ Handle<String> Scanner::LiteralBuffer::Internalize(Isolate* isolate) const {
 bool Utf16CharacterStream::SetBookmark() { return false; }
 void Utf16CharacterStream::ResetToBookmark() { UNREACHABLE(); }
 
+using scanner_kernels::AsciiIdentifierScan;
+using scanner_kernels::AsteriskScan;
+using scanner_kernels::LineTerminatorScan;
+using scanner_kernels::MultiLineCommentScan;
+using scanner_kernels::ScanBuffer;
+using scanner_kernels::SpaceScan;
+using scanner_kernels::StringScan;
+
 
 // ----------------------------------------------------------------------------
 // Scanner
@@ -321,6 +330,8 @@ bool Scanner::SkipWhiteSpace() {
                  !IsLittleEndianByteOrderMark(c0_)) {
         break;
       }
+      // Skip the spaces and tabs that follow, e.g. indentation, in bulk.
+      source_->AdvanceBuffered(ScanBuffer<SpaceScan>);
       Advance();
     }
 
@@ -357,6 +368,7 @@ Token::Value Scanner::SkipSingleLineComment() {
   // stream of input elements for the syntactic grammar (see
   // ECMA-262, section 7.4).
   while (c0_ >= 0 && !unicode_cache_->IsLineTerminator(c0_)) {
+    source_->AdvanceBuffered(ScanBuffer<LineTerminatorScan>);
     Advance();
   }
 
@@ -431,6 +443,17 @@ Token::Value Scanner::SkipMultiLineComment() {
 
   while (c0_ >= 0) {
     uc32 ch = c0_;
+    if (ch != '*' && !unicode_cache_->IsLineTerminator(ch)) {
+      // Skip ahead to the next character that may end the comment, or that
+      // makes it span lines.
+      if (has_multiline_comment_before_next_) {
+        source_->AdvanceBuffered(ScanBuffer<AsteriskScan>);
+      } else {
+        source_->AdvanceBuffered(ScanBuffer<MultiLineCommentScan>);
+      }
+      Advance();
+      continue;
+    }
     Advance();
     if (c0_ >= 0 && unicode_cache_->IsLineTerminator(ch)) {
       // Following ECMA-262, section 7.4, a comment containing
@@ -902,8 +925,13 @@ Token::Value Scanner::ScanString() {
     }
     char c = static_cast<char>(c0_);
     if (c == '\\') break;
-    Advance<false, false>();
     AddLiteralChar(c);
+    // Copy the rest of the plain ASCII characters in bulk.
+    Vector<const uint16_t> chars =
+        quote == '"' ? source_->AdvanceBuffered(ScanBuffer<StringScan<'"'>>)
+                     : source_->AdvanceBuffered(ScanBuffer<StringScan<'\''>>);
+    next_.literal_chars->AddAsciiChars(chars);
+    Advance<false, false>();
   }
 
   while (c0_ != quote && c0_ >= 0
@@ -1327,14 +1355,8 @@ Token::Value Scanner::ScanIdentifierOrKeyword() {
     if (IsDecimalDigit(c0_) || IsInRange(c0_, 'A', 'Z') || c0_ == '_' ||
         c0_ == '$') {
       // Identifier starting with lowercase.
-      char first_char = static_cast<char>(c0_);
-      Advance<false, false>();
-      AddLiteralChar(first_char);
-      while (IsAsciiIdentifier(c0_)) {
-        char first_char = static_cast<char>(c0_);
-        Advance<false, false>();
-        AddLiteralChar(first_char);
-      }
+      AddAsciiIdentifierCharsAdvance();
+      while (IsAsciiIdentifier(c0_)) AddAsciiIdentifierCharsAdvance();
       if (c0_ <= kMaxAscii && c0_ != '\\') {
         literal.Complete();
         return Token::IDENTIFIER;
@@ -1353,9 +1375,7 @@ Token::Value Scanner::ScanIdentifierOrKeyword() {
     HandleLeadSurrogate();
   } else if (IsInRange(c0_, 'A', 'Z') || c0_ == '_' || c0_ == '$') {
     do {
-      char first_char = static_cast<char>(c0_);
-      Advance<false, false>();
-      AddLiteralChar(first_char);
+      AddAsciiIdentifierCharsAdvance();
     } while (IsAsciiIdentifier(c0_));
 
     if (c0_ <= kMaxAscii && c0_ != '\\') {
@@ -1405,6 +1425,16 @@ Token::Value Scanner::ScanIdentifierOrKeyword() {
 }
 
 
+void Scanner::AddAsciiIdentifierCharsAdvance() {
+  DCHECK(IsAsciiIdentifier(c0_));
+  AddLiteralChar(static_cast<char>(c0_));
+  Vector<const uint16_t> chars =
+      source_->AdvanceBuffered(ScanBuffer<AsciiIdentifierScan>);
+  next_.literal_chars->AddAsciiChars(chars);
+  Advance<false, false>();
+}
+
+
 Token::Value Scanner::ScanIdentifierSuffix(LiteralScope* literal,
                                            bool escaped) {
   // Scan the rest of the identifier characters.
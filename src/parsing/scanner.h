@@ -74,6 +74,22 @@ class Utf16CharacterStream {
     return SlowSeekForward(code_unit_count);
   }
 
+  // Advances past the buffered code units in front of the first one that
+  // |scan| stops at, and returns them. The buffer is not refilled, so this
+  // may return fewer code units than |scan| would accept. |scan| is called
+  // with the bounds of the buffered code units and returns a pointer to the
+  // code unit it stops at. Used by the scanner to skip or copy runs of
+  // characters in bulk.
+  template <typename ScanFunction>
+  inline Vector<const uint16_t> AdvanceBuffered(ScanFunction scan) {
+    const uint16_t* start = buffer_cursor_;
+    buffer_cursor_ = scan(start, buffer_end_);
+    DCHECK(start <= buffer_cursor_ && buffer_cursor_ <= buffer_end_);
+    size_t count = buffer_cursor_ - start;
+    pos_ += count;
+    return Vector<const uint16_t>(start, static_cast<int>(count));
+  }
+
   // Pushes back the most recently read UTF-16 code unit (or negative
   // value if at end of input), i.e., the value returned by the most recent
   // call to Advance.
@@ -384,6 +400,20 @@ class Scanner {
       }
     }
 
+    // Adds code units that are all ASCII, e.g. a run returned by
+    // Utf16CharacterStream::AdvanceBuffered.
+    void AddAsciiChars(Vector<const uint16_t> code_units) {
+      DCHECK(is_one_byte_);
+      while (position_ + code_units.length() > backing_store_.length()) {
+        ExpandBuffer();
+      }
+      for (int i = 0; i < code_units.length(); i++) {
+        DCHECK_LE(code_units[i], 0x7F);
+        backing_store_[position_ + i] = static_cast<byte>(code_units[i]);
+      }
+      position_ += code_units.length();
+    }
+
     bool is_one_byte() const { return is_one_byte_; }
 
     bool is_contextual_keyword(Vector<const char> keyword) const {
@@ -603,6 +633,11 @@ class Scanner {
     Advance();
   }
 
+  // Adds c0_, which has to be an ASCII identifier character, and the ASCII
+  // identifier characters buffered after it to the literal, and advances
+  // past them.
+  void AddAsciiIdentifierCharsAdvance();
+
   // Low-level scanning support.
   template <bool capture_raw = false, bool check_surrogate = true>
   void Advance() {
@@ -84,6 +84,26 @@ HeapSnapshot* HeapProfiler::TakeSnapshot(
   return result;
 }
 
+bool HeapProfiler::TakeSnapshotToStream(
+    v8::OutputStream* stream, v8::ActivityControl* control,
+    v8::HeapProfiler::ObjectNameResolver* resolver) {
+  bool result;
+  {
+    HeapSnapshot snapshot(this);
+    HeapSnapshotBinaryWriter writer(&snapshot, stream);
+    snapshot.set_binary_writer(&writer);
+    HeapSnapshotGenerator generator(&snapshot, control, resolver, heap());
+    result = generator.GenerateSnapshot() && writer.Finish();
+  }
+  ids_->RemoveDeadEntries();
+  is_tracking_object_moves_ = true;
+
+  heap()->isolate()->debug()->feature_tracker()->Track(
+      DebugFeatureTracker::kHeapSnapshot);
+
+  return result;
+}
+
 bool HeapProfiler::StartSamplingHeapProfiler(
     uint64_t sample_interval, int stack_depth,
     v8::HeapProfiler::SamplingFlags flags) {
@@ -31,6 +31,12 @@ class HeapProfiler {
       v8::ActivityControl* control,
       v8::HeapProfiler::ObjectNameResolver* resolver);
 
+  // Writes a snapshot in the binary format of HeapSnapshotBinaryWriter to
+  // |stream| while the heap is walked. The snapshot is not retained.
+  bool TakeSnapshotToStream(v8::OutputStream* stream,
+                            v8::ActivityControl* control,
+                            v8::HeapProfiler::ObjectNameResolver* resolver);
+
   bool StartSamplingHeapProfiler(uint64_t sample_interval, int stack_depth,
                                  v8::HeapProfiler::SamplingFlags);
   void StopSamplingHeapProfiler();
@@ -62,8 +62,13 @@ HeapEntry::HeapEntry(HeapSnapshot* snapshot,
 void HeapEntry::SetNamedReference(HeapGraphEdge::Type type,
                                   const char* name,
                                   HeapEntry* entry) {
-  HeapGraphEdge edge(type, name, this->index(), entry->index());
-  snapshot_->edges().Add(edge);
+  if (snapshot_->binary_writer() != nullptr) {
+    snapshot_->binary_writer()->WriteNamedEdge(type, name, this->index(),
+                                               entry->index());
+  } else {
+    HeapGraphEdge edge(type, name, this->index(), entry->index());
+    snapshot_->edges().Add(edge);
+  }
   ++children_count_;
 }
 
@@ -71,8 +76,13 @@ void HeapEntry::SetNamedReference(HeapGraphEdge::Type type,
 void HeapEntry::SetIndexedReference(HeapGraphEdge::Type type,
                                     int index,
                                     HeapEntry* entry) {
-  HeapGraphEdge edge(type, index, this->index(), entry->index());
-  snapshot_->edges().Add(edge);
+  if (snapshot_->binary_writer() != nullptr) {
+    snapshot_->binary_writer()->WriteIndexedEdge(type, index, this->index(),
+                                                 entry->index());
+  } else {
+    HeapGraphEdge edge(type, index, this->index(), entry->index());
+    snapshot_->edges().Add(edge);
+  }
   ++children_count_;
 }
 
@@ -182,7 +192,8 @@ HeapSnapshot::HeapSnapshot(HeapProfiler* profiler)
     : profiler_(profiler),
       root_index_(HeapEntry::kNoEntry),
       gc_roots_index_(HeapEntry::kNoEntry),
-      max_snapshot_js_object_id_(0) {
+      max_snapshot_js_object_id_(0),
+      binary_writer_(nullptr) {
   STATIC_ASSERT(
       sizeof(HeapGraphEdge) ==
       SnapshotSizeConstants<kPointerSize>::kExpectedHeapGraphEdgeSize);
@@ -2533,7 +2544,8 @@ bool HeapSnapshotGenerator::GenerateSnapshot() {
 
   if (!FillReferences()) return false;
 
-  snapshot_->FillChildren();
+  // Streamed snapshots do not keep their edges.
+  if (snapshot_->binary_writer() == nullptr) snapshot_->FillChildren();
   snapshot_->RememberLastJSObjectId();
 
   progress_counter_ = progress_total_;
@@ -2607,6 +2619,11 @@ class OutputStreamWriter {
   void AddString(const char* s) {
     AddSubstring(s, StrLength(s));
   }
+  void AddByte(uint8_t b) {
+    DCHECK(chunk_pos_ < chunk_size_);
+    chunk_[chunk_pos_++] = static_cast<char>(b);
+    MaybeWriteChunk();
+  }
   void AddSubstring(const char* s, int n) {
     if (n <= 0) return;
     DCHECK(static_cast<size_t>(n) <= strlen(s));
@@ -2854,14 +2871,15 @@ void HeapSnapshotJSONSerializer::SerializeNodes() {
 }
 
 
-void HeapSnapshotJSONSerializer::SerializeSnapshot() {
-  writer_->AddString("\"meta\":");
+// Writes the description of the node and edge layout.
+static void SerializeSnapshotMeta(OutputStreamWriter* writer) {
+  writer->AddString("\"meta\":");
   // The object describing node serialization layout.
   // We use a set of macros to improve readability.
 #define JSON_A(s) "[" s "]"
 #define JSON_O(s) "{" s "}"
 #define JSON_S(s) "\"" s "\""
-  writer_->AddString(JSON_O(
+  writer->AddString(JSON_O(
     JSON_S("node_fields") ":" JSON_A(
         JSON_S("type") ","
         JSON_S("name") ","
@@ -2923,6 +2941,11 @@ void HeapSnapshotJSONSerializer::SerializeSnapshot() {
 #undef JSON_S
 #undef JSON_O
 #undef JSON_A
+}
+
+
+void HeapSnapshotJSONSerializer::SerializeSnapshot() {
+  SerializeSnapshotMeta(writer_);
   writer_->AddString(",\"node_count\":");
   writer_->AddNumber(snapshot_->entries().length());
   writer_->AddString(",\"edge_count\":");
@@ -3062,53 +3085,59 @@ void HeapSnapshotJSONSerializer::SerializeSamples() {
 }
 
 
-void HeapSnapshotJSONSerializer::SerializeString(const unsigned char* s) {
-  writer_->AddCharacter('\n');
-  writer_->AddCharacter('\"');
+static void SerializeJSONString(OutputStreamWriter* writer,
+                                const unsigned char* s) {
+  writer->AddCharacter('\n');
+  writer->AddCharacter('\"');
   for ( ; *s != '\0'; ++s) {
     switch (*s) {
       case '\b':
-        writer_->AddString("\\b");
+        writer->AddString("\\b");
         continue;
       case '\f':
-        writer_->AddString("\\f");
+        writer->AddString("\\f");
         continue;
       case '\n':
-        writer_->AddString("\\n");
+        writer->AddString("\\n");
         continue;
       case '\r':
-        writer_->AddString("\\r");
+        writer->AddString("\\r");
         continue;
       case '\t':
-        writer_->AddString("\\t");
+        writer->AddString("\\t");
         continue;
       case '\"':
       case '\\':
-        writer_->AddCharacter('\\');
-        writer_->AddCharacter(*s);
+        writer->AddCharacter('\\');
+        writer->AddCharacter(*s);
         continue;
       default:
         if (*s > 31 && *s < 128) {
-          writer_->AddCharacter(*s);
+          writer->AddCharacter(*s);
         } else if (*s <= 31) {
           // Special character with no dedicated literal.
-          WriteUChar(writer_, *s);
+          WriteUChar(writer, *s);
         } else {
           // Convert UTF-8 into \u UTF-16 literal.
           size_t length = 1, cursor = 0;
           for ( ; length <= 4 && *(s + length) != '\0'; ++length) { }
           unibrow::uchar c = unibrow::Utf8::CalculateValue(s, length, &cursor);
           if (c != unibrow::Utf8::kBadChar) {
-            WriteUChar(writer_, c);
+            WriteUChar(writer, c);
             DCHECK(cursor != 0);
             s += cursor - 1;
           } else {
-            writer_->AddCharacter('?');
+            writer->AddCharacter('?');
           }
         }
     }
   }
-  writer_->AddCharacter('\"');
+  writer->AddCharacter('\"');
+}
+
+
+void HeapSnapshotJSONSerializer::SerializeString(const unsigned char* s) {
+  SerializeJSONString(writer_, s);
 }
 
 
@@ -3129,5 +3158,319 @@ void HeapSnapshotJSONSerializer::SerializeStrings() {
 }
 
 
+const char HeapSnapshotBinaryWriter::kMagic[] = "V8HS";
+
+HeapSnapshotBinaryWriter::HeapSnapshotBinaryWriter(HeapSnapshot* snapshot,
+                                                   v8::OutputStream* stream)
+    : snapshot_(snapshot),
+      writer_(new OutputStreamWriter(stream)),
+      strings_(StringsMatch),
+      next_string_id_(1),
+      edge_count_(0),
+      last_from_(0) {
+  writer_->AddString(kMagic);
+  WriteVarint(kVersion);
+}
+
+
+HeapSnapshotBinaryWriter::~HeapSnapshotBinaryWriter() { delete writer_; }
+
+
+void HeapSnapshotBinaryWriter::WriteNamedEdge(HeapGraphEdge::Type type,
+                                              const char* name, int from,
+                                              int to) {
+  WriteEdge(type, GetStringId(name), from, to);
+}
+
+
+void HeapSnapshotBinaryWriter::WriteIndexedEdge(HeapGraphEdge::Type type,
+                                                int index, int from, int to) {
+  WriteEdge(type, index, from, to);
+}
+
+
+bool HeapSnapshotBinaryWriter::Finish() {
+  List<HeapEntry>& entries = snapshot_->entries();
+  for (int i = 0; i < entries.length(); ++i) {
+    HeapEntry* entry = &entries[i];
+    int name = GetStringId(entry->name());
+    writer_->AddByte(kNode);
+    WriteVarint(entry->type());
+    WriteVarint(name);
+    WriteVarint(entry->id());
+    WriteVarint(entry->self_size());
+    WriteVarint(entry->trace_node_id());
+    if (writer_->aborted()) return false;
+  }
+  writer_->AddByte(kEnd);
+  WriteVarint(entries.length());
+  WriteVarint(edge_count_);
+  if (writer_->aborted()) return false;
+  writer_->Finalize();
+  return true;
+}
+
+
+int HeapSnapshotBinaryWriter::GetStringId(const char* s) {
+  base::HashMap::Entry* cache_entry =
+      strings_.LookupOrInsert(const_cast<char*>(s), StringHash(s));
+  if (cache_entry->value == NULL) {
+    int id = next_string_id_++;
+    cache_entry->value = reinterpret_cast<void*>(id);
+    int length = StrLength(s);
+    writer_->AddByte(kString);
+    WriteVarint(id);
+    WriteVarint(length);
+    writer_->AddSubstring(s, length);
+  }
+  return static_cast<int>(reinterpret_cast<intptr_t>(cache_entry->value));
+}
+
+
+void HeapSnapshotBinaryWriter::WriteEdge(HeapGraphEdge::Type type,
+                                         int name_or_index, int from, int to) {
+  writer_->AddByte(kEdge);
+  WriteVarint(type);
+  WriteVarint(static_cast<uint32_t>(name_or_index));
+  // Edges are mostly added per parent, so deltas keep the records small.
+  WriteSignedVarint(static_cast<int64_t>(from) - last_from_);
+  WriteSignedVarint(static_cast<int64_t>(to) - from);
+  last_from_ = from;
+  ++edge_count_;
+}
+
+
+void HeapSnapshotBinaryWriter::WriteVarint(uint64_t value) {
+  while (value >= 0x80) {
+    writer_->AddByte(static_cast<uint8_t>(value | 0x80));
+    value >>= 7;
+  }
+  writer_->AddByte(static_cast<uint8_t>(value));
+}
+
+
+void HeapSnapshotBinaryWriter::WriteSignedVarint(int64_t value) {
+  WriteVarint((static_cast<uint64_t>(value) << 1) ^
+              static_cast<uint64_t>(value >> 63));
+}
+
+
+HeapSnapshotBinaryToJSONConverter::HeapSnapshotBinaryToJSONConverter(
+    const char* data, size_t size)
+    : pos_(reinterpret_cast<const uint8_t*>(data)),
+      end_(reinterpret_cast<const uint8_t*>(data) + size) {}
+
+
+bool HeapSnapshotBinaryToJSONConverter::Convert(v8::OutputStream* stream) {
+  if (!Parse()) return false;
+  OutputStreamWriter writer(stream);
+  WriteJSON(&writer);
+  if (writer.aborted()) return false;
+  writer.Finalize();
+  return true;
+}
+
+
+bool HeapSnapshotBinaryToJSONConverter::Parse() {
+  const size_t magic_length = strlen(HeapSnapshotBinaryWriter::kMagic);
+  if (static_cast<size_t>(end_ - pos_) < magic_length ||
+      memcmp(pos_, HeapSnapshotBinaryWriter::kMagic, magic_length) != 0) {
+    return false;
+  }
+  pos_ += magic_length;
+  uint64_t version;
+  if (!ReadVarint(&version) ||
+      version != static_cast<uint64_t>(HeapSnapshotBinaryWriter::kVersion)) {
+    return false;
+  }
+  // String ids start at 1, like the string ids of the JSON format.
+  strings_.push_back("<dummy>");
+  int64_t from = 0;
+  while (true) {
+    uint8_t tag;
+    if (!ReadByte(&tag)) return false;
+    switch (tag) {
+      case HeapSnapshotBinaryWriter::kString: {
+        uint64_t id, length;
+        if (!ReadVarint(&id) || !ReadVarint(&length)) return false;
+        if (id != strings_.size()) return false;
+        if (length > static_cast<uint64_t>(end_ - pos_)) return false;
+        strings_.push_back(std::string(reinterpret_cast<const char*>(pos_),
+                                       static_cast<size_t>(length)));
+        pos_ += length;
+        break;
+      }
+      case HeapSnapshotBinaryWriter::kEdge: {
+        uint64_t type, name_or_index;
+        int64_t from_delta, to_delta;
+        if (!ReadVarint(&type) || !ReadVarint(&name_or_index) ||
+            !ReadSignedVarint(&from_delta) || !ReadSignedVarint(&to_delta)) {
+          return false;
+        }
+        from += from_delta;
+        int64_t to = from + to_delta;
+        if (from < 0 || to < 0) return false;
+        Edge edge = {static_cast<uint32_t>(type),
+                     static_cast<uint32_t>(name_or_index),
+                     static_cast<uint32_t>(from), static_cast<uint32_t>(to)};
+        edges_.push_back(edge);
+        break;
+      }
+      case HeapSnapshotBinaryWriter::kNode: {
+        uint64_t type, name, id, self_size, trace_node_id;
+        if (!ReadVarint(&type) || !ReadVarint(&name) || !ReadVarint(&id) ||
+            !ReadVarint(&self_size) || !ReadVarint(&trace_node_id)) {
+          return false;
+        }
+        if (name >= strings_.size()) return false;
+        Node node = {static_cast<uint32_t>(type),
+                     static_cast<uint32_t>(name),
+                     static_cast<uint32_t>(id),
+                     self_size,
+                     static_cast<uint32_t>(trace_node_id),
+                     0};
+        nodes_.push_back(node);
+        break;
+      }
+      case HeapSnapshotBinaryWriter::kEnd: {
+        uint64_t node_count, edge_count;
+        if (!ReadVarint(&node_count) || !ReadVarint(&edge_count)) return false;
+        if (node_count != nodes_.size() || edge_count != edges_.size()) {
+          return false;
+        }
+        for (const Edge& edge : edges_) {
+          if (edge.from >= nodes_.size() || edge.to >= nodes_.size()) {
+            return false;
+          }
+          bool named = edge.type != HeapGraphEdge::kElement &&
+                       edge.type != HeapGraphEdge::kHidden;
+          if (named && edge.name_or_index >= strings_.size()) return false;
+          nodes_[edge.from].edge_count++;
+        }
+        return true;
+      }
+      default:
+        return false;
+    }
+  }
+}
+
+
+bool HeapSnapshotBinaryToJSONConverter::ReadByte(uint8_t* value) {
+  if (pos_ == end_) return false;
+  *value = *pos_++;
+  return true;
+}
+
+
+bool HeapSnapshotBinaryToJSONConverter::ReadVarint(uint64_t* value) {
+  uint64_t result = 0;
+  for (int shift = 0; shift < 64; shift += 7) {
+    uint8_t byte;
+    if (!ReadByte(&byte)) return false;
+    result |= static_cast<uint64_t>(byte & 0x7f) << shift;
+    if ((byte & 0x80) == 0) {
+      *value = result;
+      return true;
+    }
+  }
+  return false;
+}
+
+
+bool HeapSnapshotBinaryToJSONConverter::ReadSignedVarint(int64_t* value) {
+  uint64_t zigzag;
+  if (!ReadVarint(&zigzag)) return false;
+  *value =
+      static_cast<int64_t>(zigzag >> 1) ^ -static_cast<int64_t>(zigzag & 1);
+  return true;
+}
+
+
+void HeapSnapshotBinaryToJSONConverter::WriteJSON(OutputStreamWriter* writer) {
+  const int kNodeFieldsCount = 6;
+  writer->AddCharacter('{');
+  writer->AddString("\"snapshot\":{");
+  SerializeSnapshotMeta(writer);
+  writer->AddString(",\"node_count\":");
+  writer->AddNumber(static_cast<unsigned>(nodes_.size()));
+  writer->AddString(",\"edge_count\":");
+  writer->AddNumber(static_cast<unsigned>(edges_.size()));
+  writer->AddString(",\"trace_function_count\":0");
+  writer->AddString("},\n");
+
+  // The buffer needs space for 5 unsigned ints, 1 uint64_t, 6 commas, \n and
+  // \0.
+  static const int kBufferSize =
+      5 * MaxDecimalDigitsIn<sizeof(unsigned)>::kUnsigned  // NOLINT
+      + MaxDecimalDigitsIn<sizeof(uint64_t)>::kUnsigned  // NOLINT
+      + 6 + 1 + 1;
+  EmbeddedVector<char, kBufferSize> buffer;
+  writer->AddString("\"nodes\":[");
+  for (size_t i = 0; i < nodes_.size(); ++i) {
+    const Node& node = nodes_[i];
+    int buffer_pos = 0;
+    if (i > 0) buffer[buffer_pos++] = ',';
+    buffer_pos = utoa(node.type, buffer, buffer_pos);
+    buffer[buffer_pos++] = ',';
+    buffer_pos = utoa(node.name, buffer, buffer_pos);
+    buffer[buffer_pos++] = ',';
+    buffer_pos = utoa(node.id, buffer, buffer_pos);
+    buffer[buffer_pos++] = ',';
+    buffer_pos = utoa(node.self_size, buffer, buffer_pos);
+    buffer[buffer_pos++] = ',';
+    buffer_pos = utoa(node.edge_count, buffer, buffer_pos);
+    buffer[buffer_pos++] = ',';
+    buffer_pos = utoa(node.trace_node_id, buffer, buffer_pos);
+    buffer[buffer_pos++] = '\n';
+    buffer[buffer_pos++] = '\0';
+    writer->AddString(buffer.start());
+    if (writer->aborted()) return;
+  }
+  writer->AddString("],\n");
+
+  // Edges are grouped by their from node, in the order they were written.
+  std::vector<uint32_t> first_edge(nodes_.size() + 1, 0);
+  for (size_t i = 0; i < nodes_.size(); ++i) {
+    first_edge[i + 1] = first_edge[i] + nodes_[i].edge_count;
+  }
+  std::vector<uint32_t> sorted_edges(edges_.size());
+  for (size_t i = 0; i < edges_.size(); ++i) {
+    sorted_edges[first_edge[edges_[i].from]++] = static_cast<uint32_t>(i);
+  }
+  writer->AddString("\"edges\":[");
+  for (size_t i = 0; i < sorted_edges.size(); ++i) {
+    const Edge& edge = edges_[sorted_edges[i]];
+    int buffer_pos = 0;
+    if (i > 0) buffer[buffer_pos++] = ',';
+    buffer_pos = utoa(edge.type, buffer, buffer_pos);
+    buffer[buffer_pos++] = ',';
+    buffer_pos = utoa(edge.name_or_index, buffer, buffer_pos);
+    buffer[buffer_pos++] = ',';
+    buffer_pos = utoa(edge.to * kNodeFieldsCount, buffer, buffer_pos);
+    buffer[buffer_pos++] = '\n';
+    buffer[buffer_pos++] = '\0';
+    writer->AddString(buffer.start());
+    if (writer->aborted()) return;
+  }
+  writer->AddString("],\n");
+
+  writer->AddString("\"trace_function_infos\":[],\n");
+  writer->AddString("\"trace_tree\":[],\n");
+  writer->AddString("\"samples\":[],\n");
+
+  writer->AddString("\"strings\":[");
+  writer->AddString("\"<dummy>\"");
+  for (size_t i = 1; i < strings_.size(); ++i) {
+    writer->AddCharacter(',');
+    SerializeJSONString(
+        writer, reinterpret_cast<const unsigned char*>(strings_[i].c_str()));
+    if (writer->aborted()) return;
+  }
+  writer->AddCharacter(']');
+  writer->AddCharacter('}');
+}
+
+
 }  // namespace internal
 }  // namespace v8
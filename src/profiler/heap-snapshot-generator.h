@@ -5,7 +5,9 @@
 #ifndef V8_PROFILER_HEAP_SNAPSHOT_GENERATOR_H_
 #define V8_PROFILER_HEAP_SNAPSHOT_GENERATOR_H_
 
+#include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "include/v8-profiler.h"
 #include "src/base/platform/time.h"
@@ -21,6 +23,7 @@ class HeapEntry;
 class HeapIterator;
 class HeapProfiler;
 class HeapSnapshot;
+class HeapSnapshotBinaryWriter;
 class SnapshotFiller;
 
 class HeapGraphEdge BASE_EMBEDDED {
@@ -180,6 +183,13 @@ class HeapSnapshot {
   List<HeapEntry*>* GetSortedEntriesList();
   void FillChildren();
 
+  // If set, edges are written to |writer| instead of being stored in the
+  // snapshot. Such a snapshot cannot be traversed.
+  HeapSnapshotBinaryWriter* binary_writer() { return binary_writer_; }
+  void set_binary_writer(HeapSnapshotBinaryWriter* writer) {
+    binary_writer_ = writer;
+  }
+
   void Print(int max_depth);
 
  private:
@@ -196,6 +206,7 @@ class HeapSnapshot {
   List<HeapGraphEdge*> children_;
   List<HeapEntry*> sorted_entries_;
   SnapshotObjectId max_snapshot_js_object_id_;
+  HeapSnapshotBinaryWriter* binary_writer_;
 
   friend class HeapSnapshotTester;
 
@@ -624,6 +635,111 @@ class HeapSnapshotJSONSerializer {
   DISALLOW_COPY_AND_ASSIGN(HeapSnapshotJSONSerializer);
 };
 
+// Streams a heap snapshot in a compact binary format while the snapshot is
+// generated. Edges are written as soon as the generator adds them, nodes are
+// written by Finish() because their names may still change during generation.
+//
+// The stream starts with the magic "V8HS" and a varint format version,
+// followed by records that start with a tag byte. All numbers are LEB128
+// varints, signed numbers are zigzag encoded.
+//
+//   kString:  id, length, bytes
+//             Defines the string with the next id. Strings are deduplicated
+//             and defined before the first record that uses them.
+//   kEdge:    type, name string id or index, from node (signed delta to the
+//             from node of the previous edge), to node (signed delta to the
+//             from node)
+//   kNode:    type, name string id, id, self size, trace node id
+//             Nodes are written in index order.
+//   kEnd:     node count, edge count
+class HeapSnapshotBinaryWriter {
+ public:
+  enum Tag { kString = 1, kEdge = 2, kNode = 3, kEnd = 4 };
+  static const char kMagic[];
+  static const int kVersion = 1;
+
+  HeapSnapshotBinaryWriter(HeapSnapshot* snapshot, v8::OutputStream* stream);
+  ~HeapSnapshotBinaryWriter();
+
+  void WriteNamedEdge(HeapGraphEdge::Type type, const char* name, int from,
+                      int to);
+  void WriteIndexedEdge(HeapGraphEdge::Type type, int index, int from, int to);
+
+  // Writes the nodes and ends the stream. Returns false if the stream was
+  // aborted.
+  bool Finish();
+
+ private:
+  INLINE(static bool StringsMatch(void* key1, void* key2)) {
+    return strcmp(reinterpret_cast<char*>(key1),
+                  reinterpret_cast<char*>(key2)) == 0;
+  }
+
+  INLINE(static uint32_t StringHash(const void* string)) {
+    const char* s = reinterpret_cast<const char*>(string);
+    int len = static_cast<int>(strlen(s));
+    return StringHasher::HashSequentialString(
+        s, len, v8::internal::kZeroHashSeed);
+  }
+
+  int GetStringId(const char* s);
+  void WriteEdge(HeapGraphEdge::Type type, int name_or_index, int from,
+                 int to);
+  void WriteVarint(uint64_t value);
+  void WriteSignedVarint(int64_t value);
+
+  HeapSnapshot* snapshot_;
+  OutputStreamWriter* writer_;
+  base::HashMap strings_;
+  int next_string_id_;
+  int edge_count_;
+  int last_from_;
+
+  DISALLOW_COPY_AND_ASSIGN(HeapSnapshotBinaryWriter);
+};
+
+// Converts the output of HeapSnapshotBinaryWriter into the format of
+// HeapSnapshotJSONSerializer. Runs without an isolate, so allocation traces
+// and heap object samples are not part of the result.
+class HeapSnapshotBinaryToJSONConverter {
+ public:
+  HeapSnapshotBinaryToJSONConverter(const char* data, size_t size);
+
+  // Returns false if the input is malformed or the stream was aborted.
+  bool Convert(v8::OutputStream* stream);
+
+ private:
+  struct Node {
+    uint32_t type;
+    uint32_t name;
+    uint32_t id;
+    uint64_t self_size;
+    uint32_t trace_node_id;
+    uint32_t edge_count;
+  };
+
+  struct Edge {
+    uint32_t type;
+    uint32_t name_or_index;
+    uint32_t from;
+    uint32_t to;
+  };
+
+  bool Parse();
+  bool ReadByte(uint8_t* value);
+  bool ReadVarint(uint64_t* value);
+  bool ReadSignedVarint(int64_t* value);
+  void WriteJSON(OutputStreamWriter* writer);
+
+  const uint8_t* pos_;
+  const uint8_t* end_;
+  std::vector<std::string> strings_;
+  std::vector<Node> nodes_;
+  std::vector<Edge> edges_;
+
+  DISALLOW_COPY_AND_ASSIGN(HeapSnapshotBinaryToJSONConverter);
+};
+
 
 }  // namespace internal
 }  // namespace v8
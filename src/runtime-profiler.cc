@@ -25,6 +25,9 @@ static const int kProfilerTicksBeforeBaseline = 1;
 // Number of times a function has to be seen on the stack before it is
 // optimized.
 static const int kProfilerTicksBeforeOptimization = 2;
+// Number of times a function with an optimization hint has to be seen on the
+// stack before it is optimized, so that its ICs have collected feedback.
+static const int kProfilerTicksBeforeHintedOptimization = 1;
 // If the function optimization was disabled due to high deoptimization count,
 // but the function is hot and has been seen on the stack this number of times,
 // then we try to reenable optimization for this function.
@@ -93,6 +96,22 @@ static void GetICCounts(JSFunction* function, int* ic_with_type_info_count,
   }
 }
 
+// Functions that were optimized when the code cache for their script was
+// produced need a shorter warm-up before being optimized. The hint is used
+// for the first optimization only, and ignored once the function deoptimized.
+static bool HasOptimizationHint(SharedFunctionInfo* shared) {
+  if (!FLAG_serialize_optimization_hints) return false;
+  if (shared->deopt_count() > 0) return false;
+  if (!shared->script()->IsScript()) return false;
+  return Script::cast(shared->script())
+      ->HasOptimizationHint(shared->start_position());
+}
+
+static void ClearOptimizationHint(SharedFunctionInfo* shared) {
+  Script::cast(shared->script())
+      ->ClearOptimizationHint(shared->start_position());
+}
+
 static void TraceRecompile(JSFunction* function, const char* reason,
                            const char* type) {
   if (FLAG_trace_opt &&
@@ -229,14 +248,19 @@ void RuntimeProfiler::MaybeOptimizeFullCodegen(JSFunction* function,
 
   int ticks = shared_code->profiler_ticks();
 
-  if (ticks >= kProfilerTicksBeforeOptimization) {
+  bool hinted = ticks >= kProfilerTicksBeforeHintedOptimization &&
+                HasOptimizationHint(shared);
+  if (ticks >= kProfilerTicksBeforeOptimization || hinted) {
     int typeinfo, generic, total, type_percentage, generic_percentage;
     GetICCounts(function, &typeinfo, &generic, &total, &type_percentage,
                 &generic_percentage);
+    // The hint only shortens the warm-up, the ICs still need feedback.
+    bool has_feedback = total == 0 || typeinfo > 0;
     if (type_percentage >= FLAG_type_info_threshold &&
-        generic_percentage <= FLAG_generic_ic_threshold) {
+        generic_percentage <= FLAG_generic_ic_threshold && has_feedback) {
       // If this particular function hasn't had any ICs patched for enough
       // ticks, optimize it now.
+      if (hinted) ClearOptimizationHint(shared);
       Optimize(function, "hot and stable");
     } else if (ticks >= kTicksWhenNotEnoughTypeInfo) {
       Optimize(function, "not much type info but very hot");
@@ -350,14 +374,19 @@ void RuntimeProfiler::MaybeOptimizeIgnition(JSFunction* function,
   }
   if (function->IsOptimized()) return;
 
-  if (ticks >= kProfilerTicksBeforeOptimization) {
+  bool hinted = ticks >= kProfilerTicksBeforeHintedOptimization &&
+                HasOptimizationHint(shared);
+  if (ticks >= kProfilerTicksBeforeOptimization || hinted) {
     int typeinfo, generic, total, type_percentage, generic_percentage;
     GetICCounts(function, &typeinfo, &generic, &total, &type_percentage,
                 &generic_percentage);
+    // The hint only shortens the warm-up, the ICs still need feedback.
+    bool has_feedback = total == 0 || typeinfo > 0;
     if (type_percentage >= FLAG_type_info_threshold &&
-        generic_percentage <= FLAG_generic_ic_threshold) {
+        generic_percentage <= FLAG_generic_ic_threshold && has_feedback) {
       // If this particular function hasn't had any ICs patched for enough
       // ticks, optimize it now.
+      if (hinted) ClearOptimizationHint(shared);
       Optimize(function, "hot and stable");
     } else if (ticks >= kTicksWhenNotEnoughTypeInfo) {
       Optimize(function, "not much type info but very hot");
@@ -205,7 +205,8 @@ RUNTIME_FUNCTION(Runtime_NotifyDeoptimized) {
     // TODO(titzer): we should probably do DeoptimizeCodeList(code)
     // unconditionally if the code is not already marked for deoptimization.
     // If there is an index by shared function info, all the better.
-    Deoptimizer::DeoptimizeFunction(*function);
+    // The deoptimization that got us here was counted already.
+    Deoptimizer::DeoptimizeFunction(*function, DeoptimizeReason::kNoReason);
   }
 
   return isolate->heap()->undefined_value();
@@ -48,7 +48,7 @@ RUNTIME_FUNCTION(Runtime_DeoptimizeFunction) {
     return isolate->heap()->undefined_value();
   }
 
-  Deoptimizer::DeoptimizeFunction(*function);
+  Deoptimizer::DeoptimizeFunction(*function, DeoptimizeReason::kTesting);
 
   return isolate->heap()->undefined_value();
 }
@@ -74,7 +74,7 @@ RUNTIME_FUNCTION(Runtime_DeoptimizeNow) {
     return isolate->heap()->undefined_value();
   }
 
-  Deoptimizer::DeoptimizeFunction(*function);
+  Deoptimizer::DeoptimizeFunction(*function, DeoptimizeReason::kTesting);
 
   return isolate->heap()->undefined_value();
 }
@@ -5,6 +5,7 @@
 #include "src/v8.h"
 
 #include "src/assembler.h"
+#include "src/base/accounting-allocator.h"
 #include "src/base/once.h"
 #include "src/base/platform/platform.h"
 #include "src/bootstrapper.h"
@@ -49,6 +50,7 @@ void V8::TearDown() {
   Isolate::GlobalTearDown();
   sampler::Sampler::TearDown();
   FlagList::ResetAllFlags();  // Frees memory held by string arguments.
+  base::AccountingAllocator::ReleasePool();
 }
 
 
@@ -72,6 +74,7 @@ void V8::InitializeOncePerProcessImpl() {
   }
 
   base::OS::Initialize(FLAG_random_seed, FLAG_hard_abort, FLAG_gc_fake_mmap);
+  base::AccountingAllocator::ConfigurePool(FLAG_zone_segment_pool_size * KB);
 
   Isolate::InitializeOncePerProcess();
 
@@ -557,6 +557,8 @@
         'compiler/ast-loop-assignment-analyzer.h',
         'compiler/basic-block-instrumentor.cc',
         'compiler/basic-block-instrumentor.h',
+        'compiler/bounds-check-elimination.cc',
+        'compiler/bounds-check-elimination.h',
         'compiler/branch-elimination.cc',
         'compiler/branch-elimination.h',
         'compiler/bytecode-branch-analysis.cc',
@@ -602,6 +604,8 @@
         "compiler/frame-states.h",
         'compiler/gap-resolver.cc',
         'compiler/gap-resolver.h',
+        'compiler/global-value-numbering.cc',
+        'compiler/global-value-numbering.h',
         'compiler/graph-reducer.cc',
         'compiler/graph-reducer.h',
         'compiler/graph-replay.cc',
@@ -747,6 +751,8 @@
         'compiler/zone-pool.h',
         'compiler-dispatcher/compiler-dispatcher-job.cc',
         'compiler-dispatcher/compiler-dispatcher-job.h',
+        'compiler-dispatcher/compiler-dispatcher.cc',
+        'compiler-dispatcher/compiler-dispatcher.h',
         'compiler-dispatcher/optimizing-compile-dispatcher.cc',
         'compiler-dispatcher/optimizing-compile-dispatcher.h',
         'compiler.cc',
@@ -906,11 +912,15 @@
         'handles.cc',
         'handles.h',
         'heap-symbols.h',
+        'heap/array-buffer-collector.cc',
+        'heap/array-buffer-collector.h',
         'heap/array-buffer-tracker-inl.h',
         'heap/array-buffer-tracker.cc',
         'heap/array-buffer-tracker.h',
         'heap/code-stats.cc',
         'heap/code-stats.h',
+        'heap/concurrent-marking.cc',
+        'heap/concurrent-marking.h',
         'heap/memory-reducer.cc',
         'heap/memory-reducer.h',
         'heap/gc-idle-time-handler.cc',
@@ -935,6 +945,10 @@
         'heap/objects-visiting.cc',
         'heap/objects-visiting.h',
         'heap/page-parallel-job.h',
+        'heap/parallel-marking.cc',
+        'heap/parallel-marking.h',
+        'heap/parallel-scavenger.cc',
+        'heap/parallel-scavenger.h',
         'heap/remembered-set.cc',
         'heap/remembered-set.h',
         'heap/scavenge-job.h',
@@ -948,6 +962,7 @@
         'heap/spaces.h',
         'heap/store-buffer.cc',
         'heap/store-buffer.h',
+        'heap/worklist.h',
         'i18n.cc',
         'i18n.h',
         'icu_util.cc',
@@ -1067,6 +1082,7 @@
         'parsing/rewriter.h',
         'parsing/scanner-character-streams.cc',
         'parsing/scanner-character-streams.h',
+        'parsing/scanner-kernels.h',
         'parsing/scanner.cc',
         'parsing/scanner.h',
         'parsing/token.cc',
@@ -232,11 +232,13 @@ Address Zone::NewExpand(size_t size) {
   // Compute the new segment size. We use a 'high water mark'
   // strategy, where we increase the segment size every time we expand
   // except that we employ a maximum segment size when we delete. This
-  // is to avoid excessive malloc() and free() overhead.
+  // is to avoid excessive malloc() and free() overhead. Segment sizes are
+  // rounded up to the sizes pooled by the allocator below, so adding the
+  // old size roughly doubles the segment size.
   Segment* head = segment_head_;
   const size_t old_size = (head == nullptr) ? 0 : head->size();
   static const size_t kSegmentOverhead = sizeof(Segment) + kAlignment;
-  const size_t new_size_no_overhead = size + (old_size << 1);
+  const size_t new_size_no_overhead = size + old_size;
   size_t new_size = kSegmentOverhead + new_size_no_overhead;
   const size_t min_new_size = kSegmentOverhead + size;
   // Guard against integer overflow.
@@ -253,6 +255,8 @@ Address Zone::NewExpand(size_t size) {
     // requested size.
     new_size = Max(min_new_size, kMaximumSegmentSize);
   }
+  // Segments of the pooled sizes are reused across zones and threads.
+  new_size = base::AccountingAllocator::RoundUpToPooledSize(new_size);
   if (new_size > INT_MAX) {
     V8::FatalProcessOutOfMemory("Zone");
     return nullptr;
@@ -46,6 +46,9 @@ std::vector<Handle<FixedArray>> CreatePadding(Heap* heap, int padding_size,
         static_cast<int>(*heap->new_space()->allocation_limit_address() -
                          *heap->new_space()->allocation_top_address());
     CHECK(padding_size <= overall_free_memory || overall_free_memory == 0);
+    // Medium objects would not go to new space.
+    object_size =
+        Min(object_size, Page::kMinMediumHeapObjectSize - kPointerSize);
   }
   while (free_memory > 0) {
     if (free_memory > object_size) {
@@ -2,6 +2,7 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include "src/heap/array-buffer-collector.h"
 #include "src/heap/array-buffer-tracker.h"
 #include "test/cctest/cctest.h"
 #include "test/cctest/heap/heap-utils.h"
@@ -109,6 +110,36 @@ TEST(ArrayBuffer_ScavengeAndMC) {
   CHECK(!IsTracked(raw_ab));
 }
 
+TEST(ArrayBuffer_BackingStoreFreedAfterScavenge) {
+  CcTest::InitializeVM();
+  LocalContext env;
+  v8::Isolate* isolate = env->GetIsolate();
+  Heap* heap = reinterpret_cast<Isolate*>(isolate)->heap();
+  ArrayBufferCollector* collector = heap->array_buffer_collector();
+  const size_t kLength = 1 * MB;
+
+  heap::GcAndSweep(heap, OLD_SPACE);
+  while (collector->pending_bytes() > 0) {
+    base::OS::Sleep(base::TimeDelta::FromMilliseconds(1));
+  }
+  heap->account_external_memory_concurrently_freed();
+  const int64_t external_memory_before = heap->external_memory();
+  {
+    v8::HandleScope handle_scope(isolate);
+    v8::ArrayBuffer::New(isolate, kLength);
+    CHECK_EQ(external_memory_before + static_cast<int64_t>(kLength),
+             heap->external_memory());
+  }
+  heap::GcAndSweep(heap, NEW_SPACE);
+  // The backing store is freed by a background task unless
+  // --concurrent_array_buffer_freeing is off.
+  while (collector->pending_bytes() > 0) {
+    base::OS::Sleep(base::TimeDelta::FromMilliseconds(1));
+  }
+  heap->account_external_memory_concurrently_freed();
+  CHECK_EQ(external_memory_before, heap->external_memory());
+}
+
 TEST(ArrayBuffer_Compaction) {
   FLAG_manual_evacuation_candidates_selection = true;
   CcTest::InitializeVM();
@@ -39,6 +39,7 @@
 #include "src/heap/gc-tracer.h"
 #include "src/heap/memory-reducer.h"
 #include "src/ic/ic.h"
+#include "src/interpreter/interpreter.h"
 #include "src/macro-assembler.h"
 #include "src/regexp/jsregexp.h"
 #include "src/snapshot/snapshot.h"
@@ -793,6 +794,134 @@ TEST(PromoteGreyOrBlackObjectsOnScavenge) {
   CHECK(!heap->InNewSpace(*marked));
 }
 
+UNINITIALIZED_TEST(ParallelScavenge) {
+  FLAG_parallel_scavenge = true;
+  FLAG_parallel_scavenge_tasks = 4;
+  v8::Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator = CcTest::array_buffer_allocator();
+  v8::Isolate* isolate = v8::Isolate::New(create_params);
+  {
+    v8::Isolate::Scope isolate_scope(isolate);
+    v8::HandleScope handle_scope(isolate);
+    v8::Context::New(isolate)->Enter();
+    Isolate* i_isolate = reinterpret_cast<Isolate*>(isolate);
+    Factory* factory = i_isolate->factory();
+    Heap* heap = i_isolate->heap();
+
+    // Old arrays that point into new space spread the OLD_TO_NEW remembered
+    // set over several pages. Every young leaf is referenced from two old
+    // arrays so that tasks race for copying it.
+    const int kWidth = 64;
+    const int kLength = 128;
+    Handle<FixedArray> first = factory->NewFixedArray(kWidth, TENURED);
+    Handle<FixedArray> second = factory->NewFixedArray(kWidth, TENURED);
+    for (int i = 0; i < kWidth; i++) {
+      Handle<FixedArray> inner_first = factory->NewFixedArray(kLength, TENURED);
+      Handle<FixedArray> inner_second =
+          factory->NewFixedArray(kLength, TENURED);
+      for (int j = 0; j < kLength; j++) {
+        Handle<FixedArray> leaf = factory->NewFixedArray(2);
+        leaf->set(0, Smi::FromInt(i * kLength + j));
+        inner_first->set(j, *leaf);
+        inner_second->set(kLength - j - 1, *leaf);
+      }
+      first->set(i, *inner_first);
+      second->set(i, *inner_second);
+    }
+
+    // The first scavenge copies the leaves within new space, the second one
+    // promotes them.
+    for (int gc = 0; gc < 2; gc++) {
+      heap->CollectGarbage(NEW_SPACE);
+      for (int i = 0; i < kWidth; i++) {
+        FixedArray* inner_first = FixedArray::cast(first->get(i));
+        FixedArray* inner_second = FixedArray::cast(second->get(i));
+        for (int j = 0; j < kLength; j++) {
+          Object* leaf = inner_first->get(j);
+          CHECK_EQ(leaf, inner_second->get(kLength - j - 1));
+          CHECK_EQ(Smi::FromInt(i * kLength + j),
+                   FixedArray::cast(leaf)->get(0));
+        }
+      }
+    }
+    CHECK(!heap->InNewSpace(FixedArray::cast(first->get(0))->get(0)));
+
+    heap->CollectAllGarbage();
+#ifdef VERIFY_HEAP
+    heap->Verify();
+#endif
+  }
+  isolate->Dispose();
+}
+
+TEST(MinorMarkCompact) {
+  FLAG_minor_mc = true;
+  CcTest::InitializeVM();
+  Isolate* isolate = CcTest::i_isolate();
+  Factory* factory = isolate->factory();
+  Heap* heap = isolate->heap();
+  HandleScope scope(isolate);
+
+  // One young array is only reachable from old space, the other one only from
+  // a handle.
+  Handle<FixedArray> old = factory->NewFixedArray(1, TENURED);
+  Handle<FixedArray> from_old = factory->NewFixedArray(2);
+  from_old->set(0, Smi::FromInt(42));
+  old->set(0, *from_old);
+  from_old = Handle<FixedArray>::null();
+  Handle<FixedArray> from_handle = factory->NewFixedArray(2);
+  from_handle->set(0, Smi::FromInt(43));
+  {
+    HandleScope garbage_scope(isolate);
+    for (int i = 0; i < 1000; i++) factory->NewFixedArray(16);
+  }
+
+  intptr_t size_before = heap->new_space()->SizeOfObjects();
+  heap->CollectGarbage(NEW_SPACE);
+  CHECK_LT(heap->new_space()->SizeOfObjects(), size_before);
+  CHECK(heap->InNewSpace(old->get(0)));
+  CHECK(heap->InNewSpace(*from_handle));
+  CHECK_EQ(Smi::FromInt(42), FixedArray::cast(old->get(0))->get(0));
+  CHECK_EQ(Smi::FromInt(43), from_handle->get(0));
+
+  // Survivors of the previous GC are promoted.
+  heap->CollectGarbage(NEW_SPACE);
+  CHECK(!heap->InNewSpace(old->get(0)));
+  CHECK(!heap->InNewSpace(*from_handle));
+  CHECK_EQ(Smi::FromInt(42), FixedArray::cast(old->get(0))->get(0));
+  CHECK_EQ(Smi::FromInt(43), from_handle->get(0));
+
+  heap->CollectAllGarbage();
+#ifdef VERIFY_HEAP
+  heap->Verify();
+#endif
+}
+
+TEST(StoreBufferOverflowFromRuntime) {
+  CcTest::InitializeVM();
+  Isolate* isolate = CcTest::i_isolate();
+  Factory* factory = isolate->factory();
+  Heap* heap = isolate->heap();
+  HandleScope scope(isolate);
+
+  // Fills the store buffer several times from the runtime.
+  const int kLength = 4 * StoreBuffer::kStoreBufferSize / kPointerSize;
+  // The array is small enough for a regular page, so it goes to old space.
+  STATIC_ASSERT(FixedArray::kHeaderSize + kLength * kPointerSize <=
+                Page::kMaxRegularHeapObjectSize);
+  Handle<FixedArray> old = factory->NewFixedArray(kLength, TENURED);
+  CHECK(heap->old_space()->Contains(*old));
+  for (int i = 0; i < kLength; i++) {
+    HandleScope inner_scope(isolate);
+    Handle<HeapNumber> number = factory->NewHeapNumber(i);
+    old->set(i, *number);
+  }
+  heap->CollectGarbage(NEW_SPACE);
+  for (int i = 0; i < kLength; i++) {
+    CHECK_EQ(i, HeapNumber::cast(old->get(i))->value());
+  }
+}
+
 TEST(BytecodeArray) {
   static const uint8_t kRawBytes[] = {0xc3, 0x7e, 0xa5, 0x5a};
   static const int kRawBytesSize = sizeof(kRawBytes);
@@ -1394,6 +1523,68 @@ TEST(TestCodeFlushingPreAged) {
 }
 
 
+TEST(TestBytecodeFlushing) {
+  // If we do not flush bytecode this test is invalid.
+  if (!FLAG_flush_code || !FLAG_flush_bytecode) return;
+  i::FLAG_allow_natives_syntax = true;
+  i::FLAG_always_opt = false;
+  CcTest::InitializeVM();
+  i::FLAG_ignition = true;
+  CcTest::i_isolate()->interpreter()->Initialize();
+  Isolate* isolate = CcTest::i_isolate();
+  Factory* factory = isolate->factory();
+  v8::HandleScope scope(CcTest::isolate());
+  const char* source = "function foo() {"
+                       "  var x = 42;"
+                       "  var y = 42;"
+                       "  var z = x + y;"
+                       "};"
+                       "foo()";
+  Handle<String> foo_name = factory->InternalizeUtf8String("foo");
+
+  { v8::HandleScope scope(CcTest::isolate());
+    CompileRun(source);
+  }
+
+  // Check function is compiled to bytecode.
+  Handle<Object> func_value =
+      Object::GetProperty(isolate->global_object(), foo_name).ToHandleChecked();
+  CHECK(func_value->IsJSFunction());
+  Handle<JSFunction> function = Handle<JSFunction>::cast(func_value);
+  CHECK(function->shared()->HasBytecodeArray());
+
+  // The bytecode will survive at least two GCs.
+  CcTest::heap()->CollectAllGarbage();
+  CcTest::heap()->CollectAllGarbage();
+  CHECK(function->shared()->HasBytecodeArray());
+
+  // Simulate several GCs that use full marking.
+  const int kAgingThreshold = 6;
+  for (int i = 0; i < kAgingThreshold; i++) {
+    CcTest::heap()->CollectAllGarbage();
+  }
+
+  // foo should no longer have bytecode and be reset to lazy compilation.
+  CHECK(!function->shared()->HasBytecodeArray());
+  CHECK(!function->shared()->is_compiled());
+  CHECK(!function->is_compiled());
+
+  // Call foo to get it recompiled.
+  CompileRun("foo()");
+  CHECK(function->shared()->HasBytecodeArray());
+  CHECK(function->shared()->is_compiled());
+  CHECK(function->is_compiled());
+
+  // Running foo made the bytecode young again, but a GC that reduces memory
+  // flushes it as soon as it wasn't executed since the last full GC.
+  CcTest::heap()->CollectAllGarbage(Heap::kReduceMemoryFootprintMask);
+  CHECK(function->shared()->HasBytecodeArray());
+  CcTest::heap()->CollectAllGarbage(Heap::kReduceMemoryFootprintMask);
+  CHECK(!function->shared()->HasBytecodeArray());
+  CHECK(!function->is_compiled());
+}
+
+
 TEST(TestCodeFlushingIncremental) {
   // If we do not flush code this test is invalid.
   if (!FLAG_flush_code) return;
@@ -4940,7 +5131,7 @@ TEST(NoWeakHashTableLeakWithIncrementalMarking) {
   v8::internal::Heap* heap = CcTest::heap();
 
   // Get a clean slate regarding optimized functions on the heap.
-  i::Deoptimizer::DeoptimizeAll(isolate);
+  i::Deoptimizer::DeoptimizeAll(isolate, i::DeoptimizeReason::kTesting);
   heap->CollectAllGarbage();
 
   if (!isolate->use_crankshaft()) return;
@@ -6671,6 +6862,7 @@ TEST(Regress598319) {
   // This test ensures that no white objects can cross the progress bar of large
   // objects during incremental marking. It checks this by using Shift() during
   // incremental marking.
+  FLAG_medium_object_pages = false;
   CcTest::InitializeVM();
   v8::HandleScope scope(CcTest::isolate());
   Heap* heap = CcTest::heap();
@@ -7181,5 +7373,86 @@ TEST(RememberedSetRemoveRange) {
   });
 }
 
+TEST(MediumObjectPages) {
+  FLAG_medium_object_pages = true;
+  CcTest::InitializeVM();
+  Isolate* isolate = CcTest::i_isolate();
+  Factory* factory = isolate->factory();
+  Heap* heap = isolate->heap();
+  HandleScope scope(isolate);
+
+  // Medium objects go to old space, even if new space was requested.
+  const int kMediumLength =
+      heap::FixedArrayLenFromSize(Page::kMaxRegularHeapObjectSize + KB);
+  Handle<FixedArray> medium = factory->NewFixedArray(kMediumLength);
+  CHECK_LT(Page::kMaxRegularHeapObjectSize, medium->Size());
+  CHECK(heap->old_space()->Contains(*medium));
+  Handle<FixedArray> tenured_medium =
+      factory->NewFixedArray(kMediumLength, TENURED);
+  CHECK(heap->old_space()->Contains(*tenured_medium));
+
+  // Objects that do not fit on a page still get a large object page.
+  const int kLargeLength =
+      heap::FixedArrayLenFromSize(Page::kMaxMediumHeapObjectSize + KB);
+  Handle<FixedArray> large = factory->NewFixedArray(kLargeLength);
+  CHECK(heap->lo_space()->Contains(*large));
+
+  for (int i = 0; i < kMediumLength; i++) {
+    medium->set(i, Smi::FromInt(i));
+  }
+  heap->CollectAllGarbage();
+  heap->CollectAllGarbage();
+  CHECK(heap->old_space()->Contains(*medium));
+  for (int i = 0; i < kMediumLength; i++) {
+    CHECK_EQ(Smi::FromInt(i), medium->get(i));
+  }
+
+  FLAG_medium_object_pages = false;
+  Handle<FixedArray> regular_large = factory->NewFixedArray(kMediumLength);
+  CHECK(heap->lo_space()->Contains(*regular_large));
+  FLAG_medium_object_pages = true;
+#ifdef VERIFY_HEAP
+  heap->Verify();
+#endif
+}
+
+TEST(MediumObjectsShareAPage) {
+  FLAG_medium_object_pages = true;
+  CcTest::InitializeVM();
+  Isolate* isolate = CcTest::i_isolate();
+  Factory* factory = isolate->factory();
+  Heap* heap = isolate->heap();
+  HandleScope scope(isolate);
+
+  // Start on a fresh old space page.
+  heap::SimulateFullSpace(heap->old_space());
+  const int kObjects = 4;
+  const int kLength = heap::FixedArrayLenFromSize(200 * KB);
+  STATIC_ASSERT(kObjects * 200 * KB <= Page::kAllocatableMemory);
+  Handle<FixedArray> arrays[kObjects];
+  for (int i = 0; i < kObjects; i++) {
+    arrays[i] = factory->NewFixedArray(kLength);
+    CHECK(heap->old_space()->Contains(*arrays[i]));
+    CHECK_EQ(Page::FromAddress(arrays[0]->address()),
+             Page::FromAddress(arrays[i]->address()));
+    arrays[i]->set(0, Smi::FromInt(i));
+  }
+
+  // Objects below the medium size still go to new space.
+  Handle<FixedArray> small = factory->NewFixedArray(
+      heap::FixedArrayLenFromSize(Page::kMinMediumHeapObjectSize - KB));
+  CHECK(heap->InNewSpace(*small));
+
+  heap->CollectAllGarbage();
+  heap->mark_compact_collector()->EnsureSweepingCompleted();
+  for (int i = 0; i < kObjects; i++) {
+    CHECK(heap->old_space()->Contains(*arrays[i]));
+    CHECK_EQ(Smi::FromInt(i), arrays[i]->get(0));
+  }
+#ifdef VERIFY_HEAP
+  heap->Verify();
+#endif
+}
+
 }  // namespace internal
 }  // namespace v8
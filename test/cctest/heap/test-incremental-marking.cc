@@ -18,6 +18,8 @@
 
 #include "src/full-codegen/full-codegen.h"
 #include "src/global-handles.h"
+#include "src/heap/concurrent-marking.h"
+#include "src/heap/gc-tracer.h"
 #include "test/cctest/cctest.h"
 #include "test/cctest/heap/heap-utils.h"
 
@@ -193,5 +195,67 @@ TEST(IncrementalMarkingUsingDelayedTasks) {
   i::V8::SetPlatformForTesting(old_platform);
 }
 
+
+UNINITIALIZED_TEST(ConcurrentMarking) {
+  if (!i::FLAG_incremental_marking) return;
+  FLAG_concurrent_marking = true;
+  FLAG_concurrent_marking_tasks = 2;
+  v8::Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator = CcTest::array_buffer_allocator();
+  v8::Isolate* isolate = v8::Isolate::New(create_params);
+  {
+    v8::Isolate::Scope isolate_scope(isolate);
+    v8::HandleScope handle_scope(isolate);
+    v8::Context::New(isolate)->Enter();
+    Isolate* i_isolate = reinterpret_cast<Isolate*>(isolate);
+    Factory* factory = i_isolate->factory();
+    Heap* heap = i_isolate->heap();
+    CHECK_EQ(ConcurrentMarking::IsSupported(),
+             heap->concurrent_marking() != nullptr);
+
+    // Fixed arrays and heap numbers can be visited by the background tasks.
+    const int kWidth = 128;
+    Handle<FixedArray> root = factory->NewFixedArray(kWidth, TENURED);
+    for (int i = 0; i < kWidth; i++) {
+      Handle<FixedArray> inner = factory->NewFixedArray(kWidth, TENURED);
+      for (int j = 0; j < kWidth; j++) {
+        Handle<HeapNumber> number = factory->NewHeapNumber(i * kWidth + j);
+        Handle<FixedArray> leaf = factory->NewFixedArray(2);
+        leaf->set(0, *number);
+        inner->set(j, *leaf);
+      }
+      root->set(i, *inner);
+    }
+
+    heap->CollectAllGarbage();
+    i::heap::SimulateIncrementalMarking(heap, false);
+    IncrementalMarking* marking = heap->incremental_marking();
+    marking->Step(i::MB, IncrementalMarking::NO_GC_VIA_STACK_GUARD);
+    // Mutate the graph while background tasks are marking. The write barrier
+    // and the snapshot protocol have to keep the moved leaves alive.
+    for (int i = 0; i < kWidth; i += 2) {
+      Handle<FixedArray> inner = factory->NewFixedArray(kWidth);
+      for (int j = 0; j < kWidth; j++) {
+        inner->set(j, FixedArray::cast(root->get(i + 1))->get(j));
+      }
+      root->set(i, *inner);
+    }
+    i::heap::SimulateIncrementalMarking(heap);
+    heap->CollectAllGarbage();
+
+    for (int i = 0; i < kWidth; i++) {
+      FixedArray* inner = FixedArray::cast(root->get(i));
+      int expected_row = (i % 2 == 0) ? i + 1 : i;
+      for (int j = 0; j < kWidth; j++) {
+        FixedArray* leaf = FixedArray::cast(inner->get(j));
+        CHECK_EQ(static_cast<double>(expected_row * kWidth + j),
+                 leaf->get(0)->Number());
+      }
+    }
+    CHECK_GE(heap->tracer()->cumulative_concurrent_marking_duration(), 0.0);
+  }
+  isolate->Dispose();
+}
+
 }  // namespace internal
 }  // namespace v8
@@ -41,6 +41,7 @@
 
 #include "src/full-codegen/full-codegen.h"
 #include "src/global-handles.h"
+#include "src/heap/parallel-marking.h"
 #include "test/cctest/cctest.h"
 #include "test/cctest/heap/heap-tester.h"
 #include "test/cctest/heap/heap-utils.h"
@@ -76,6 +77,8 @@ TEST(MarkingDeque) {
 }
 
 TEST(Promotion) {
+  // Large arrays are allocated in new space only without medium pages.
+  FLAG_medium_object_pages = false;
   CcTest::InitializeVM();
   Isolate* isolate = CcTest::i_isolate();
   {
@@ -97,6 +100,8 @@ TEST(Promotion) {
 }
 
 HEAP_TEST(NoPromotion) {
+  // Large arrays are allocated in new space only without medium pages.
+  FLAG_medium_object_pages = false;
   CcTest::InitializeVM();
   Isolate* isolate = CcTest::i_isolate();
   {
@@ -380,6 +385,56 @@ TEST(EmptyObjectGroups) {
 }
 
 
+UNINITIALIZED_TEST(ParallelMarking) {
+  FLAG_parallel_marking = true;
+  FLAG_parallel_marking_tasks = 4;
+  v8::Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator = CcTest::array_buffer_allocator();
+  v8::Isolate* isolate = v8::Isolate::New(create_params);
+  {
+    v8::Isolate::Scope isolate_scope(isolate);
+    v8::HandleScope handle_scope(isolate);
+    v8::Context::New(isolate)->Enter();
+    Isolate* i_isolate = reinterpret_cast<Isolate*>(isolate);
+    Factory* factory = i_isolate->factory();
+    Heap* heap = i_isolate->heap();
+
+    // Build a wide tree of arrays so that the marking worklist publishes
+    // enough segments for several tasks.
+    const int kWidth = 256;
+    const int kDepth = 3;
+    Handle<FixedArray> root = factory->NewFixedArray(kWidth, TENURED);
+    for (int i = 0; i < kWidth; i++) {
+      Handle<FixedArray> inner = factory->NewFixedArray(kWidth, TENURED);
+      for (int j = 0; j < kWidth; j++) {
+        Handle<FixedArray> leaf = factory->NewFixedArray(kDepth);
+        leaf->set(0, Smi::FromInt(i * kWidth + j));
+        inner->set(j, *leaf);
+      }
+      root->set(i, *inner);
+    }
+
+    heap->CollectAllGarbage();
+    heap->CollectAllGarbage();
+    // The inner arrays fill several worklist segments, so background tasks
+    // were started for them.
+    ParallelMarking* parallel_marking =
+        heap->mark_compact_collector()->parallel_marking();
+    CHECK_NOT_NULL(parallel_marking);
+    CHECK_LT(0, parallel_marking->posted_tasks());
+
+    for (int i = 0; i < kWidth; i++) {
+      FixedArray* inner = FixedArray::cast(root->get(i));
+      for (int j = 0; j < kWidth; j++) {
+        FixedArray* leaf = FixedArray::cast(inner->get(j));
+        CHECK_EQ(Smi::FromInt(i * kWidth + j), leaf->get(0));
+      }
+    }
+  }
+  isolate->Dispose();
+}
+
+
 #if defined(__has_feature)
 #if __has_feature(address_sanitizer)
 #define V8_WITH_ASAN 1
@@ -348,6 +348,84 @@ TEST(MemoryAllocator) {
 }
 
 
+TEST(MemoryAllocatorHugePageRegions) {
+  FLAG_transparent_huge_pages = true;
+  Isolate* isolate = CcTest::i_isolate();
+  Heap* heap = isolate->heap();
+  MemoryAllocator* memory_allocator = new MemoryAllocator(isolate);
+  CHECK(memory_allocator->SetUp(heap->MaxReserved(), heap->MaxExecutableSize(),
+                                0));
+  TestMemoryAllocatorScope test_scope(isolate, memory_allocator);
+
+  // Huge page regions are only used where the OS supports them.
+  if (memory_allocator->use_huge_page_regions()) {
+    OldSpace faked_space(heap, OLD_SPACE, NOT_EXECUTABLE);
+    const int kPagesPerRegion = static_cast<int>(
+        MemoryAllocator::kHugePageRegionSize / Page::kPageSize);
+    Page* first_page = nullptr;
+    for (int i = 0; i < kPagesPerRegion; i++) {
+      Page* page = memory_allocator->AllocatePage(
+          faked_space.AreaSize(), static_cast<PagedSpace*>(&faked_space),
+          NOT_EXECUTABLE);
+      CHECK(Page::IsValid(page));
+      page->InsertAfter(faked_space.anchor()->prev_page());
+      if (first_page == nullptr) {
+        first_page = page;
+        CHECK(IsAddressAligned(first_page->address(),
+                               MemoryAllocator::kHugePageRegionSize));
+      }
+      // Pages are handed out back to back from the same region.
+      CHECK_EQ(first_page->address() + i * Page::kPageSize, page->address());
+    }
+    // OldSpace's destructor will tear down the space and free up all pages.
+  }
+  memory_allocator->TearDown();
+  delete memory_allocator;
+  FLAG_transparent_huge_pages = false;
+}
+
+
+UNINITIALIZED_TEST(TransparentHugePagesSplayTree) {
+  FLAG_transparent_huge_pages = true;
+  v8::Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator = CcTest::array_buffer_allocator();
+  v8::Isolate* isolate = v8::Isolate::New(create_params);
+  {
+    v8::Isolate::Scope isolate_scope(isolate);
+    v8::HandleScope handle_scope(isolate);
+    v8::Local<v8::Context> context = v8::Context::New(isolate);
+    context->Enter();
+
+    Isolate* i_isolate = reinterpret_cast<Isolate*>(isolate);
+    Heap* heap = i_isolate->heap();
+
+    // Builds a tree of splay.js style nodes that survives into old space.
+    CompileRun(
+        "function Node(key, left, right) {"
+        "  this.key = key;"
+        "  this.value = { array: [key, key + 1], string: 'node' + key };"
+        "  this.left = left;"
+        "  this.right = right;"
+        "}"
+        "function build(from, to) {"
+        "  if (from > to) return null;"
+        "  var mid = (from + to) >> 1;"
+        "  return new Node(mid, build(from, mid - 1), build(mid + 1, to));"
+        "}"
+        "function count(node) {"
+        "  return node === null ? 0 : 1 + count(node.left) + count(node.right);"
+        "}"
+        "var root = build(0, 49999);");
+    heap->CollectAllGarbage();
+    heap->CollectAllGarbage();
+    CHECK_EQ(50000, CompileRun("count(root)")->Int32Value(context).FromJust());
+    context->Exit();
+  }
+  isolate->Dispose();
+  FLAG_transparent_huge_pages = false;
+}
+
+
 TEST(NewSpace) {
   Isolate* isolate = CcTest::i_isolate();
   Heap* heap = isolate->heap();
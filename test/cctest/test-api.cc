@@ -18060,6 +18060,94 @@ THREADED_TEST(GetHeapStatistics) {
 }
 
 
+TEST(GetGCStatistics) {
+  LocalContext env;
+  v8::Isolate* isolate = env->GetIsolate();
+  v8::HandleScope scope(isolate);
+  v8::GCStatistics before;
+  CHECK_EQ(0u, before.scavenge().count());
+  CHECK_EQ(0u, before.mark_compact().count());
+  isolate->GetGCStatistics(&before);
+  CompileRun("var a = []; for (var i = 0; i < 1000; i++) a.push({x: i});");
+  v8::GCStatistics allocated;
+  isolate->GetGCStatistics(&allocated);
+  CHECK_LT(before.new_space_allocated_bytes(),
+           allocated.new_space_allocated_bytes());
+  CcTest::heap()->CollectGarbage(i::NEW_SPACE);
+  CcTest::heap()->CollectAllGarbage();
+  v8::GCStatistics after;
+  isolate->GetGCStatistics(&after);
+  CHECK_EQ(allocated.scavenge().count() + 1, after.scavenge().count());
+  CHECK_EQ(allocated.mark_compact().count() + 1,
+           after.mark_compact().count());
+  const v8::GCPauseStatistics& pauses = after.mark_compact();
+  CHECK_LE(pauses.p50_ms(), pauses.p90_ms());
+  CHECK_LE(pauses.p90_ms(), pauses.p99_ms());
+  CHECK_LE(pauses.p99_ms(), pauses.max_ms());
+  CHECK_LE(pauses.max_ms(), pauses.total_ms());
+}
+
+
+
+
+TEST(GetCompileStatistics) {
+  i::FLAG_allow_natives_syntax = true;
+  LocalContext env;
+  v8::Isolate* isolate = env->GetIsolate();
+  v8::HandleScope scope(isolate);
+  if (!CcTest::i_isolate()->use_crankshaft() || i::FLAG_always_opt) return;
+  // Nothing is collected before the statistics are enabled.
+  CompileRun(
+      "function sub(a, b) { return a - b; }"
+      "sub(1, 2); sub(3, 4);"
+      "%OptimizeFunctionOnNextCall(sub);"
+      "sub(5, 6);");
+  v8::CompileStatistics before;
+  isolate->GetCompileStatistics(&before);
+  CHECK_EQ(0u, before.optimization_count());
+  CHECK_EQ(0u, isolate->NumberOfCompilePhases());
+
+  isolate->EnableCompileStatistics();
+  CompileRun(
+      "function add(a, b) { return a + b; }"
+      "add(1, 2); add(3, 4);"
+      "%OptimizeFunctionOnNextCall(add);"
+      "add(5, 6);"
+      "add('a', 'b');");
+  v8::CompileStatistics after;
+  isolate->GetCompileStatistics(&after);
+  CHECK_LT(before.optimization_count(), after.optimization_count());
+  CHECK_LT(before.deoptimization_count(), after.deoptimization_count());
+
+  v8::CompileReasonStatistics reason;
+  size_t deopts = 0;
+  for (size_t i = 0; i < isolate->NumberOfDeoptimizationReasons(); i++) {
+    CHECK(isolate->GetDeoptimizationStatistics(&reason, i));
+    CHECK_NOT_NULL(reason.reason());
+    deopts += reason.count();
+  }
+  CHECK_EQ(after.deoptimization_count(), deopts);
+  CHECK(!isolate->GetDeoptimizationStatistics(
+      &reason, isolate->NumberOfDeoptimizationReasons()));
+  size_t bailouts = 0;
+  for (size_t i = 0; i < isolate->NumberOfBailoutReasons(); i++) {
+    CHECK(isolate->GetBailoutStatistics(&reason, i));
+    bailouts += reason.count();
+  }
+  CHECK_EQ(after.bailout_count(), bailouts);
+
+  v8::CompilePhaseStatistics phase;
+  for (size_t i = 0; i < isolate->NumberOfCompilePhases(); i++) {
+    CHECK(isolate->GetCompilePhaseStatistics(&phase, i));
+    CHECK_NOT_NULL(phase.phase_name());
+    CHECK_NOT_NULL(phase.phase_kind_name());
+    CHECK_LE(phase.max_allocated_bytes(), phase.total_allocated_bytes());
+  }
+  CHECK(!isolate->GetCompilePhaseStatistics(&phase,
+                                            isolate->NumberOfCompilePhases()));
+}
+
+
 class VisitorImpl : public v8::ExternalResourceVisitor {
  public:
   explicit VisitorImpl(TestResource** resource) {
@@ -580,7 +580,7 @@ static void DebugEventBreakPointHitCount(
     // Perform a full deoptimization when the specified number of
     // breaks have been hit.
     if (break_point_hit_count == break_point_hit_count_deoptimize) {
-      i::Deoptimizer::DeoptimizeAll(isolate);
+      i::Deoptimizer::DeoptimizeAll(isolate, i::DeoptimizeReason::kTesting);
     }
   }
 }
@@ -861,7 +861,7 @@ static void DebugEventBreakMax(
     // Perform a full deoptimization when the specified number of
     // breaks have been hit.
     if (break_point_hit_count == break_point_hit_count_deoptimize) {
-      i::Deoptimizer::DeoptimizeAll(isolate);
+      i::Deoptimizer::DeoptimizeAll(isolate, i::DeoptimizeReason::kTesting);
     }
   }
 }
@@ -7262,7 +7262,8 @@ static void DebugEventBreakDeoptimize(
             result->ToString(context).ToLocalChecked());
         function_name->WriteUtf8(fn);
         if (strcmp(fn, "bar") == 0) {
-          i::Deoptimizer::DeoptimizeAll(CcTest::i_isolate());
+          i::Deoptimizer::DeoptimizeAll(CcTest::i_isolate(),
+                                        i::DeoptimizeReason::kTesting);
           debug_event_break_deoptimize_done = true;
         }
       }
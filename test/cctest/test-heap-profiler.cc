@@ -1068,6 +1068,89 @@ TEST(HeapSnapshotJSONSerializationAborting) {
   CHECK_EQ(0, stream.eos_signaled());
 }
 
+
+TEST(HeapSnapshotBinaryStreaming) {
+  LocalContext env;
+  v8::Isolate* isolate = env->GetIsolate();
+  v8::HandleScope scope(isolate);
+  v8::HeapProfiler* heap_profiler = isolate->GetHeapProfiler();
+
+  CompileRun(
+      "function A(s) { this.s = s; }\n"
+      "function B(x) { this.x = x; }\n"
+      "var a = new A('streamed \\u0101 string');\n"
+      "var b = new B(a);");
+  TestJSONStream binary_stream;
+  CHECK(heap_profiler->TakeHeapSnapshotToStream(&binary_stream));
+  CHECK_EQ(1, binary_stream.eos_signaled());
+  i::ScopedVector<char> binary(binary_stream.size());
+  binary_stream.WriteTo(binary);
+
+  // Truncated input is rejected.
+  TestJSONStream truncated_stream;
+  CHECK(!v8::HeapProfiler::ConvertBinaryHeapSnapshotToJSON(
+      binary.start(), binary.length() - 1, &truncated_stream));
+
+  TestJSONStream stream;
+  CHECK(v8::HeapProfiler::ConvertBinaryHeapSnapshotToJSON(
+      binary.start(), binary.length(), &stream));
+  CHECK_EQ(1, stream.eos_signaled());
+  i::ScopedVector<char> json(stream.size());
+  stream.WriteTo(json);
+  // The binary snapshot is considerably smaller than its JSON form.
+  CHECK_LT(binary.length(), json.length());
+
+  OneByteResource* json_res = new OneByteResource(json);
+  v8::Local<v8::String> json_string =
+      v8::String::NewExternalOneByte(isolate, json_res).ToLocalChecked();
+  env->Global()
+      ->Set(env.local(), v8_str("json_snapshot"), json_string)
+      .FromJust();
+  // Follow <root> -> <global>.b.x.s in the converted snapshot.
+  v8::Local<v8::Value> result = CompileRun(
+      "var parsed = JSON.parse(json_snapshot);\n"
+      "var meta = parsed.snapshot.meta;\n"
+      "var node_fields_count = meta.node_fields.length;\n"
+      "var edge_fields_count = meta.edge_fields.length;\n"
+      "var edge_count_offset = meta.node_fields.indexOf('edge_count');\n"
+      "var property_type = meta.edge_types[0].indexOf('property');\n"
+      "var first_edge_indexes = [];\n"
+      "for (var i = 0, first = 0; i < parsed.snapshot.node_count; ++i) {\n"
+      "  first_edge_indexes[i] = first;\n"
+      "  first += edge_fields_count *\n"
+      "      parsed.nodes[i * node_fields_count + edge_count_offset];\n"
+      "}\n"
+      "first_edge_indexes.push(parsed.edges.length);\n"
+      "function GetChild(pos, name) {\n"
+      "  var ordinal = pos / node_fields_count;\n"
+      "  for (var i = first_edge_indexes[ordinal];\n"
+      "       i < first_edge_indexes[ordinal + 1]; i += edge_fields_count) {\n"
+      "    if (parsed.edges[i] === property_type &&\n"
+      "        parsed.strings[parsed.edges[i + 1]] === name) {\n"
+      "      return parsed.edges[i + 2];\n"
+      "    }\n"
+      "  }\n"
+      "  return null;\n"
+      "}\n"
+      "var global_pos = parsed.edges[edge_fields_count + 2];\n"
+      "var s_pos = GetChild(GetChild(GetChild(global_pos, 'b'), 'x'), 's');\n"
+      "var edge_count = parsed.edges.length / edge_fields_count;\n"
+      "edge_count === parsed.snapshot.edge_count &&\n"
+      "    parsed.strings[parsed.nodes[s_pos + 1]] === a.s;");
+  CHECK(result->BooleanValue(env.local()).FromJust());
+}
+
+
+TEST(HeapSnapshotBinaryStreamingAborting) {
+  LocalContext env;
+  v8::HandleScope scope(env->GetIsolate());
+  v8::HeapProfiler* heap_profiler = env->GetIsolate()->GetHeapProfiler();
+  TestJSONStream stream(5);
+  CHECK(!heap_profiler->TakeHeapSnapshotToStream(&stream));
+  CHECK_GT(stream.size(), 0);
+  CHECK_EQ(0, stream.eos_signaled());
+}
+
 namespace {
 
 class TestStatsStream : public v8::OutputStream {
@@ -875,6 +875,45 @@ TEST(StreamScanner) {
 }
 
 
+TEST(ScanLongRuns) {
+  v8::V8::Initialize();
+
+  // Runs of whitespace, comments, identifier and string characters that are
+  // longer than the stream's buffer are skipped and copied in bulk.
+  std::string spaces(1000, ' ');
+  std::string identifier = "abc" + std::string(1000, 'B') + "_$9";
+  std::string string_chars(1001, 's');
+  std::string source = spaces + "/*" + std::string(999, 'x') + "\n" +
+                       std::string(300, 'y') + "**/" + identifier + "\t\"" +
+                       string_chars + "\" //" + std::string(1000, 'c') +
+                       "\n\t z /* \xE2\x80\xA8 */";
+  i::Utf8ToUtf16CharacterStream stream(
+      reinterpret_cast<const i::byte*>(source.c_str()),
+      static_cast<unsigned>(source.length()));
+  i::Scanner scanner(CcTest::i_isolate()->unicode_cache());
+  scanner.Initialize(&stream);
+
+  CHECK_EQ(i::Token::IDENTIFIER, scanner.Next());
+  CHECK(scanner.HasAnyLineTerminatorBeforeNext());
+  CHECK(scanner.LiteralMatches(identifier.c_str(),
+                               static_cast<int>(identifier.length())));
+  CHECK_EQ(static_cast<int>(spaces.length() + 2 + 999 + 1 + 300 + 3),
+           scanner.location().beg_pos);
+
+  CHECK_EQ(i::Token::STRING, scanner.Next());
+  CHECK(!scanner.HasAnyLineTerminatorBeforeNext());
+  CHECK(scanner.LiteralMatches(string_chars.c_str(),
+                               static_cast<int>(string_chars.length())));
+
+  CHECK_EQ(i::Token::IDENTIFIER, scanner.Next());
+  CHECK(scanner.HasAnyLineTerminatorBeforeNext());
+  CHECK(scanner.LiteralMatches("z", 1));
+
+  CHECK_EQ(i::Token::EOS, scanner.Next());
+  CHECK(scanner.HasAnyLineTerminatorBeforeNext());
+}
+
+
 void TestScanRegExp(const char* re_source, const char* expected) {
   i::Utf8ToUtf16CharacterStream stream(
        reinterpret_cast<const i::byte*>(re_source),
@@ -8148,3 +8187,62 @@ TEST(TrailingCommasInParametersErrors) {
   RunParserSyncTest(context_data, data, kError, NULL, 0, always_flags,
                     arraysize(always_flags));
 }
+
+static int total_preparse_skipped = 0;
+
+
+static int* LookupCounterTotalPreparseSkipped(const char* name) {
+  if (strcmp(name, "c:V8.TotalPreparseSkipped") == 0) {
+    return &total_preparse_skipped;
+  }
+  return NULL;
+}
+
+
+TEST(LazyInnerFunctionsSkipRecordedBodies) {
+  i::FLAG_lazy_inner_functions = true;
+  i::Isolate* isolate = CcTest::i_isolate();
+  i::HandleScope scope(isolate);
+  LocalContext env;
+  env->GetIsolate()->SetCounterFunction(LookupCounterTotalPreparseSkipped);
+
+  // Compiling outer lazily records the scope data of inner on the script.
+  CompileRun(
+      "function outer() {"
+      "  var captured = 1, local = 2;"
+      "  function inner(y) { captured += y; return captured; }"
+      "  return inner;"
+      "}"
+      "var inner = outer();");
+  i::Handle<i::JSFunction> outer = i::Handle<i::JSFunction>::cast(
+      v8::Utils::OpenHandle(*CompileRun("outer")));
+  i::Handle<i::Script> script(i::Script::cast(outer->shared()->script()));
+  CHECK(script->skippable_functions()->IsArrayList());
+
+  // Parsing outer again skips the body of inner, but inner still captures
+  // the variable it assigns.
+  int skipped_before = total_preparse_skipped;
+  {
+    i::Zone zone(isolate->allocator());
+    i::ParseInfo info(&zone, outer);
+    info.set_allow_lazy_parsing();
+    i::Parser parser(&info);
+    CHECK(parser.Parse(&info));
+    CHECK(i::Compiler::Analyze(&info));
+    i::DeclarationScope* outer_scope = info.literal()->scope();
+    i::Variable* captured =
+        outer_scope->LookupLocal(info.ast_value_factory()->GetOneByteString(
+            i::OneByteVector("captured")));
+    i::Variable* local =
+        outer_scope->LookupLocal(info.ast_value_factory()->GetOneByteString(
+            i::OneByteVector("local")));
+    CHECK(captured->IsContextSlot());
+    CHECK_EQ(i::kMaybeAssigned, captured->maybe_assigned());
+    CHECK(local->IsStackLocal());
+  }
+  CHECK_LT(skipped_before, total_preparse_skipped);
+
+  // Compiling inner drops its record, which leaves nothing on the script.
+  CHECK_EQ(3, CompileRun("inner(2)")->Int32Value(env.local()).FromJust());
+  CHECK(script->skippable_functions()->IsUndefined(isolate));
+}
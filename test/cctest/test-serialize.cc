@@ -993,6 +993,67 @@ TEST(CodeSerializerPromotedToCompilationCache) {
   delete cache;
 }
 
+TEST(CodeSerializerOptimizationHints) {
+  FLAG_serialize_toplevel = true;
+  FLAG_serialize_optimization_hints = true;
+  LocalContext context;
+  Isolate* isolate = CcTest::i_isolate();
+
+  v8::HandleScope scope(CcTest::isolate());
+
+  const char* source =
+      "function hot(x) { return x + 1; }"
+      "function cold(x) { return x - 1; }"
+      "hot(1) + cold(1)";
+
+  Handle<String> src = isolate->factory()
+                           ->NewStringFromUtf8(CStrVector(source))
+                           .ToHandleChecked();
+  Handle<String> copy_src = isolate->factory()
+                                ->NewStringFromUtf8(CStrVector(source))
+                                .ToHandleChecked();
+  ScriptData* cache = NULL;
+
+  // Run the script once and pretend that {hot} has been optimized since.
+  Handle<SharedFunctionInfo> warm = CompileScript(
+      isolate, src, src, &cache, v8::ScriptCompiler::kNoCompileOptions);
+  Handle<JSFunction> warm_fun =
+      isolate->factory()->NewFunctionFromSharedFunctionInfo(
+          warm, isolate->native_context());
+  Handle<JSObject> global(isolate->context()->global_object());
+  Execution::Call(isolate, warm_fun, global, 0, NULL).ToHandleChecked();
+  Handle<JSFunction> hot = Handle<JSFunction>::cast(
+      v8::Utils::OpenHandle(*CompileRun("hot")));
+  Handle<JSFunction> cold = Handle<JSFunction>::cast(
+      v8::Utils::OpenHandle(*CompileRun("cold")));
+  hot->shared()->set_opt_count(1);
+
+  // Producing the cache recompiles the script, but records the hint.
+  CompileScript(isolate, src, src, &cache,
+                v8::ScriptCompiler::kProduceCodeCache);
+
+  isolate->compilation_cache()->Disable();  // Force deserialization.
+  Handle<SharedFunctionInfo> copy;
+  {
+    DisallowCompilation no_compile_expected(isolate);
+    copy = CompileScript(isolate, copy_src, copy_src, &cache,
+                         v8::ScriptCompiler::kConsumeCodeCache);
+  }
+  CHECK_NE(*warm, *copy);
+
+  Script* script = Script::cast(copy->script());
+  CHECK(script->HasOptimizationHint(hot->shared()->start_position()));
+  CHECK(!script->HasOptimizationHint(cold->shared()->start_position()));
+
+  // Hints are used once.
+  script->ClearOptimizationHint(hot->shared()->start_position());
+  CHECK(!script->HasOptimizationHint(hot->shared()->start_position()));
+
+  isolate->compilation_cache()->Enable();
+  FLAG_serialize_optimization_hints = false;
+  delete cache;
+}
+
 TEST(CodeSerializerInternalizedString) {
   FLAG_serialize_toplevel = true;
   LocalContext context;
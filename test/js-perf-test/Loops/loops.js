@@ -0,0 +1,95 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+new BenchmarkSuite('ArraySum', [1000], [
+  new Benchmark('ArraySum', false, false, 0,
+                ArraySum, ArraySumSetup, ArraySumTearDown)
+]);
+
+new BenchmarkSuite('InvariantProperty', [1000], [
+  new Benchmark('InvariantProperty', false, false, 0,
+                InvariantProperty, InvariantPropertySetup,
+                InvariantPropertyTearDown)
+]);
+
+new BenchmarkSuite('InvariantElement', [1000], [
+  new Benchmark('InvariantElement', false, false, 0,
+                InvariantElement, InvariantElementSetup,
+                InvariantElementTearDown)
+]);
+
+// ----------------------------------------------------------------------------
+
+var result;
+var array;
+var point;
+
+function ArraySumSetup() {
+  array = [];
+  for (var i = 0; i < 1000; ++i) array.push(i);
+}
+
+// The map check and the length load of {a} are loop invariant.
+function sum(a) {
+  var result = 0;
+  for (var i = 0; i < a.length; ++i) {
+    result += a[i];
+  }
+  return result;
+}
+
+function ArraySum() {
+  result = sum(array);
+}
+
+function ArraySumTearDown() {
+  return result == 499500;
+}
+
+// ----------------------------------------------------------------------------
+
+function InvariantPropertySetup() {
+  point = {x: 1.5, y: 2.5};
+}
+
+// The map check and the loads of {p.x} and {p.y} are loop invariant.
+function scale(p, n) {
+  var result = 0;
+  for (var i = 0; i < n; ++i) {
+    result += i * p.x + p.y;
+  }
+  return result;
+}
+
+function InvariantProperty() {
+  result = scale(point, 1000);
+}
+
+function InvariantPropertyTearDown() {
+  return result == 751750;
+}
+
+// ----------------------------------------------------------------------------
+
+function InvariantElementSetup() {
+  array = [];
+  for (var i = 0; i < 1000; ++i) array.push(i);
+}
+
+// The bounds check of {a[k]} is loop invariant.
+function offset(a, k, n) {
+  var result = 0;
+  for (var i = 0; i < n; ++i) {
+    result += a[k] + i;
+  }
+  return result;
+}
+
+function InvariantElement() {
+  result = offset(array, 10, 1000);
+}
+
+function InvariantElementTearDown() {
+  return result == 509500;
+}
@@ -0,0 +1,78 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax --turbo --turbo-bounds-check-elimination
+
+// Counted loop over a JSArray.
+(function() {
+  function sum(a) {
+    var result = 0;
+    for (var i = 0; i < a.length; ++i) result += a[i];
+    return result;
+  }
+  assertEquals(6, sum([1, 2, 3]));
+  assertEquals(10, sum([1, 2, 3, 4]));
+  %OptimizeFunctionOnNextCall(sum);
+  assertEquals(15, sum([1, 2, 3, 4, 5]));
+  assertEquals(0, sum([]));
+})();
+
+// Counted loop over a TypedArray.
+(function() {
+  function sum(a) {
+    var result = 0;
+    for (var i = 0; i < a.length; ++i) result += a[i];
+    return result;
+  }
+  assertEquals(6, sum(new Int32Array([1, 2, 3])));
+  assertEquals(10, sum(new Int32Array([1, 2, 3, 4])));
+  %OptimizeFunctionOnNextCall(sum);
+  assertEquals(15, sum(new Int32Array([1, 2, 3, 4, 5])));
+  assertEquals(0, sum(new Int32Array(0)));
+})();
+
+// The loop bound is not the length of the array.
+(function() {
+  function sum(a, n) {
+    var result = 0;
+    for (var i = 0; i < n; ++i) result += a[i];
+    return result;
+  }
+  var a = [1, 2, 3];
+  assertEquals(6, sum(a, 3));
+  assertEquals(3, sum(a, 2));
+  %OptimizeFunctionOnNextCall(sum);
+  assertEquals(6, sum(a, 3));
+  assertEquals(NaN, sum(a, 4));
+})();
+
+// The array shrinks inside of the loop.
+(function() {
+  function f(a) {
+    var result = 0;
+    for (var i = 0; i < a.length; ++i) {
+      result += a[i];
+      if (i == 1) a.length = 1;
+    }
+    return result;
+  }
+  assertEquals(3, f([1, 2, 3]));
+  assertEquals(3, f([1, 2, 3]));
+  %OptimizeFunctionOnNextCall(f);
+  assertEquals(3, f([1, 2, 3]));
+})();
+
+// The index is decremented.
+(function() {
+  function f(a) {
+    var result = 0;
+    for (var i = a.length - 1; i >= 0; --i) result += a[i];
+    return result;
+  }
+  assertEquals(6, f([1, 2, 3]));
+  assertEquals(6, f([1, 2, 3]));
+  %OptimizeFunctionOnNextCall(f);
+  assertEquals(10, f([1, 2, 3, 4]));
+  assertEquals(0, f([]));
+})();
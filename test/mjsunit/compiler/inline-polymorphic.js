@@ -0,0 +1,140 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax --turbo --polymorphic-inlining
+
+// Polymorphic method call, dispatched on the known targets.
+(function() {
+  function A() {}
+  A.prototype.visit = function(x) { return x + 1; };
+  function B() {}
+  B.prototype.visit = function(x) { return x * 2; };
+  function C() {}
+  C.prototype.visit = function(x) { return x - 3; };
+
+  function visitAll(nodes, x) {
+    var result = 0;
+    for (var i = 0; i < nodes.length; i++) result += nodes[i].visit(x);
+    return result;
+  }
+
+  var nodes = [new A(), new B(), new C(), new A()];
+  assertEquals(9, visitAll(nodes, 2));
+  assertEquals(9, visitAll(nodes, 2));
+  %OptimizeFunctionOnNextCall(visitAll);
+  assertEquals(9, visitAll(nodes, 2));
+  assertEquals(24, visitAll(nodes, 5));
+})();
+
+// Known targets and a fallback call for the unknown one.
+(function() {
+  function inc(x) { return x + 1; }
+  function dec(x) { return x - 1; }
+  var holder = { fn: function(x) { return x * 10; } };
+
+  function call(c, x) {
+    var f = c == 0 ? inc : c == 1 ? dec : holder.fn;
+    return f(x);
+  }
+
+  for (var i = 0; i < 3; i++) {
+    assertEquals(3, call(0, 2));
+    assertEquals(1, call(1, 2));
+    assertEquals(20, call(2, 2));
+  }
+  %OptimizeFunctionOnNextCall(call);
+  assertEquals(3, call(0, 2));
+  assertEquals(1, call(1, 2));
+  assertEquals(20, call(2, 2));
+  holder.fn = inc;
+  assertEquals(3, call(2, 2));
+  holder.fn = function(x) { return -x; };
+  assertEquals(-2, call(2, 2));
+})();
+
+// Exceptions thrown by one of the targets.
+(function() {
+  function ok(x) { return x; }
+  function fail(x) { throw x; }
+
+  function call(c, x) {
+    var f = c ? fail : ok;
+    try {
+      return f(x);
+    } catch (e) {
+      return e + 100;
+    }
+  }
+
+  for (var i = 0; i < 3; i++) {
+    assertEquals(1, call(false, 1));
+    assertEquals(101, call(true, 1));
+  }
+  %OptimizeFunctionOnNextCall(call);
+  assertEquals(1, call(false, 1));
+  assertEquals(101, call(true, 1));
+})();
+
+// Construct calls with polymorphic targets.
+(function() {
+  function P(x) { this.x = x; }
+  function Q(x) { this.x = x * 2; }
+
+  function make(c, x) {
+    var F = c ? Q : P;
+    return new F(x).x;
+  }
+
+  for (var i = 0; i < 3; i++) {
+    assertEquals(1, make(false, 1));
+    assertEquals(2, make(true, 1));
+  }
+  %OptimizeFunctionOnNextCall(make);
+  assertEquals(3, make(false, 3));
+  assertEquals(6, make(true, 3));
+})();
+
+// Construct calls pass the matching known target as new.target.
+(function() {
+  function P() { this.target = new.target; }
+  function Q() { this.target = new.target; }
+
+  function make(c) {
+    var F = c ? Q : P;
+    return new F();
+  }
+
+  for (var i = 0; i < 3; i++) {
+    assertSame(P, make(false).target);
+    assertSame(Q, make(true).target);
+  }
+  %OptimizeFunctionOnNextCall(make);
+  assertSame(P, make(false).target);
+  assertSame(Q, make(true).target);
+  assertInstanceof(make(false), P);
+  assertInstanceof(make(true), Q);
+})();
+
+// None of the known targets can be inlined, and a fallback call remains.
+(function() {
+  var realm = Realm.create();
+  var inc = Realm.eval(realm, "(function(x) { return x + 1; })");
+  var dec = Realm.eval(realm, "(function(x) { return x - 1; })");
+  var holder = { fn: function(x) { return x * 10; } };
+
+  function call(c, x) {
+    var f = c == 0 ? inc : c == 1 ? dec : holder.fn;
+    return f(x);
+  }
+
+  for (var i = 0; i < 3; i++) {
+    assertEquals(3, call(0, 2));
+    assertEquals(1, call(1, 2));
+    assertEquals(20, call(2, 2));
+  }
+  %OptimizeFunctionOnNextCall(call);
+  assertEquals(3, call(0, 2));
+  assertEquals(1, call(1, 2));
+  assertEquals(20, call(2, 2));
+})();
@@ -0,0 +1,88 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/base/accounting-allocator.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace v8 {
+namespace base {
+
+class AccountingAllocatorTest : public ::testing::Test {
+ public:
+  AccountingAllocatorTest() {
+    AccountingAllocator::ReleasePool();
+    AccountingAllocator::ConfigurePool(
+        AccountingAllocator::kDefaultMaxPoolSize);
+  }
+  ~AccountingAllocatorTest() override {
+    AccountingAllocator::ReleasePool();
+    AccountingAllocator::ConfigurePool(
+        AccountingAllocator::kDefaultMaxPoolSize);
+  }
+};
+
+TEST_F(AccountingAllocatorTest, RoundUpToPooledSize) {
+  EXPECT_EQ(AccountingAllocator::kMinPooledSize,
+            AccountingAllocator::RoundUpToPooledSize(1));
+  EXPECT_EQ(AccountingAllocator::kMinPooledSize,
+            AccountingAllocator::RoundUpToPooledSize(8 * 1024));
+  EXPECT_EQ(16u * 1024, AccountingAllocator::RoundUpToPooledSize(8 * 1024 + 1));
+  EXPECT_EQ(AccountingAllocator::kMaxPooledSize,
+            AccountingAllocator::RoundUpToPooledSize(1024 * 1024));
+  EXPECT_EQ(1024u * 1024 + 1,
+            AccountingAllocator::RoundUpToPooledSize(1024 * 1024 + 1));
+}
+
+TEST_F(AccountingAllocatorTest, ReusesPooledSizes) {
+  AccountingAllocator allocator;
+  const size_t kSize = 16 * 1024;
+  void* memory = allocator.Allocate(kSize);
+  ASSERT_NE(nullptr, memory);
+  EXPECT_EQ(kSize, allocator.GetCurrentMemoryUsage());
+  allocator.Free(memory, kSize);
+  EXPECT_EQ(0u, allocator.GetCurrentMemoryUsage());
+  EXPECT_EQ(kSize, AccountingAllocator::GetPoolSize());
+
+  // Any allocator in the process gets the pooled block back.
+  AccountingAllocator other;
+  EXPECT_EQ(memory, other.Allocate(kSize));
+  EXPECT_EQ(0u, AccountingAllocator::GetPoolSize());
+  EXPECT_EQ(kSize, other.GetCurrentMemoryUsage());
+  other.Free(memory, kSize);
+}
+
+TEST_F(AccountingAllocatorTest, DoesNotPoolOtherSizes) {
+  AccountingAllocator allocator;
+  const size_t kSizes[] = {100, 12 * 1024, 2 * 1024 * 1024};
+  for (size_t size : kSizes) {
+    allocator.Free(allocator.Allocate(size), size);
+    EXPECT_EQ(0u, AccountingAllocator::GetPoolSize());
+  }
+}
+
+TEST_F(AccountingAllocatorTest, PoolSizeIsBounded) {
+  AccountingAllocator::ConfigurePool(64 * 1024);
+  AccountingAllocator allocator;
+  const size_t kSize = 32 * 1024;
+  void* blocks[3];
+  for (int i = 0; i < 3; i++) blocks[i] = allocator.Allocate(kSize);
+  for (int i = 0; i < 3; i++) allocator.Free(blocks[i], kSize);
+  EXPECT_EQ(64u * 1024, AccountingAllocator::GetPoolSize());
+
+  // Lowering the limit and releasing the pool give the memory back.
+  AccountingAllocator::ConfigurePool(32 * 1024);
+  EXPECT_EQ(0u, AccountingAllocator::GetPoolSize());
+  allocator.Free(allocator.Allocate(kSize), kSize);
+  EXPECT_EQ(kSize, AccountingAllocator::GetPoolSize());
+  AccountingAllocator::ReleasePool();
+  EXPECT_EQ(0u, AccountingAllocator::GetPoolSize());
+
+  // A zero limit disables the pool.
+  AccountingAllocator::ConfigurePool(0);
+  allocator.Free(allocator.Allocate(kSize), kSize);
+  EXPECT_EQ(0u, AccountingAllocator::GetPoolSize());
+}
+
+}  // namespace base
+}  // namespace v8
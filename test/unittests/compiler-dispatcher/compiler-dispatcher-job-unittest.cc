@@ -62,6 +62,17 @@ Handle<JSFunction> CreateFunction(
   return scope.CloseAndEscape(function);
 }
 
+Handle<JSFunction> CompileFunction(v8::Isolate* isolate, const char* source) {
+  return Handle<JSFunction>::cast(Utils::OpenHandle(
+      *v8::Script::Compile(isolate->GetCurrentContext(),
+                           v8::String::NewFromUtf8(isolate, source,
+                                                   v8::NewStringType::kNormal)
+                               .ToLocalChecked())
+           .ToLocalChecked()
+           ->Run(isolate->GetCurrentContext())
+           .ToLocalChecked()));
+}
+
 }  // namespace
 
 TEST_F(CompilerDispatcherJobTest, Construct) {
@@ -93,9 +104,38 @@ TEST_F(CompilerDispatcherJobTest, StateTransitions) {
   job->Parse();
   ASSERT_TRUE(job->status() == CompileJobStatus::kParsed);
   job->FinalizeParsingOnMainThread();
+  ASSERT_TRUE(job->status() == CompileJobStatus::kReadyToAnalyse);
+  job->ResetOnMainThread();
+  ASSERT_TRUE(job->status() == CompileJobStatus::kInitial);
+}
+
+TEST_F(CompilerDispatcherJobTest, CompileToBytecode) {
+  bool old_flag = FLAG_ignition;
+  FLAG_ignition = true;
+  Handle<JSFunction> f = CompileFunction(
+      isolate(),
+      "function g() { var y = 1; function f(x) { return x * y }; return f; } "
+      "g();");
+  ASSERT_FALSE(f->shared()->is_compiled());
+
+  std::unique_ptr<CompilerDispatcherJob> job(
+      new CompilerDispatcherJob(i_isolate(), f, FLAG_stack_size));
+
+  job->PrepareToParseOnMainThread();
+  job->Parse();
+  job->FinalizeParsingOnMainThread();
+  job->PrepareToCompileOnMainThread();
   ASSERT_TRUE(job->status() == CompileJobStatus::kReadyToCompile);
+  job->Compile();
+  ASSERT_TRUE(job->status() == CompileJobStatus::kCompiled);
+  job->FinalizeCompilingOnMainThread();
+  ASSERT_TRUE(job->status() == CompileJobStatus::kDone);
+  ASSERT_TRUE(f->shared()->is_compiled());
+  ASSERT_TRUE(f->shared()->HasBytecodeArray());
+
   job->ResetOnMainThread();
   ASSERT_TRUE(job->status() == CompileJobStatus::kInitial);
+  FLAG_ignition = old_flag;
 }
 
 TEST_F(CompilerDispatcherJobTest, SyntaxError) {
@@ -119,14 +159,7 @@ TEST_F(CompilerDispatcherJobTest, ScopeChain) {
   const char script[] =
       "function g() { var g = 1; function f(x) { return x * g }; return f; } "
       "g();";
-  Handle<JSFunction> f = Handle<JSFunction>::cast(Utils::OpenHandle(
-      *v8::Script::Compile(isolate()->GetCurrentContext(),
-                           v8::String::NewFromUtf8(isolate(), script,
-                                                   v8::NewStringType::kNormal)
-                               .ToLocalChecked())
-           .ToLocalChecked()
-           ->Run(isolate()->GetCurrentContext())
-           .ToLocalChecked()));
+  Handle<JSFunction> f = CompileFunction(isolate(), script);
 
   std::unique_ptr<CompilerDispatcherJob> job(
       new CompilerDispatcherJob(i_isolate(), f, FLAG_stack_size));
@@ -134,7 +167,7 @@ TEST_F(CompilerDispatcherJobTest, ScopeChain) {
   job->PrepareToParseOnMainThread();
   job->Parse();
   job->FinalizeParsingOnMainThread();
-  ASSERT_TRUE(job->status() == CompileJobStatus::kReadyToCompile);
+  ASSERT_TRUE(job->status() == CompileJobStatus::kReadyToAnalyse);
 
   const AstRawString* var_x =
       job->parse_info_->ast_value_factory()->GetOneByteString("x");
@@ -0,0 +1,329 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <string>
+#include <vector>
+
+#include "include/v8-platform.h"
+#include "include/v8.h"
+#include "src/api.h"
+#include "src/compiler-dispatcher/compiler-dispatcher-job.h"
+#include "src/compiler-dispatcher/compiler-dispatcher.h"
+#include "src/flags.h"
+#include "src/handles.h"
+#include "src/isolate-inl.h"
+#include "test/unittests/test-utils.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace v8 {
+namespace internal {
+
+class CompilerDispatcherTest : public TestWithContext {
+ public:
+  CompilerDispatcherTest() : old_ignition_flag_(FLAG_ignition) {
+    FLAG_ignition = true;
+  }
+  ~CompilerDispatcherTest() override { FLAG_ignition = old_ignition_flag_; }
+
+ private:
+  bool old_ignition_flag_;
+
+  DISALLOW_COPY_AND_ASSIGN(CompilerDispatcherTest);
+};
+
+namespace {
+
+// A platform that only queues tasks, so that tests decide when they run.
+class MockPlatform : public v8::Platform {
+ public:
+  MockPlatform()
+      : time_(0.0),
+        time_step_(0.0),
+        idle_tasks_enabled_(true),
+        idle_task_(nullptr) {}
+  ~MockPlatform() override {
+    EXPECT_TRUE(background_tasks_.empty());
+    EXPECT_EQ(nullptr, idle_task_);
+  }
+
+  size_t NumberOfAvailableBackgroundThreads() override { return 1; }
+
+  void CallOnBackgroundThread(Task* task,
+                              ExpectedRuntime expected_runtime) override {
+    background_tasks_.push_back(task);
+  }
+
+  void CallOnForegroundThread(v8::Isolate* isolate, Task* task) override {
+    UNREACHABLE();
+  }
+
+  void CallDelayedOnForegroundThread(v8::Isolate* isolate, Task* task,
+                                     double delay_in_seconds) override {
+    UNREACHABLE();
+  }
+
+  void CallIdleOnForegroundThread(v8::Isolate* isolate,
+                                  IdleTask* task) override {
+    ASSERT_EQ(nullptr, idle_task_);
+    idle_task_ = task;
+  }
+
+  bool IdleTasksEnabled(v8::Isolate* isolate) override {
+    return idle_tasks_enabled_;
+  }
+
+  double MonotonicallyIncreasingTime() override {
+    time_ += time_step_;
+    return time_;
+  }
+
+  void RunIdleTask(double deadline_in_seconds, double time_step) {
+    ASSERT_NE(nullptr, idle_task_);
+    time_step_ = time_step;
+    IdleTask* task = idle_task_;
+    idle_task_ = nullptr;
+    task->Run(deadline_in_seconds);
+    delete task;
+  }
+
+  bool IdleTaskPending() const { return idle_task_ != nullptr; }
+
+  void RunBackgroundTasks() {
+    std::vector<Task*> tasks;
+    tasks.swap(background_tasks_);
+    for (Task* task : tasks) {
+      task->Run();
+      delete task;
+    }
+  }
+
+  bool BackgroundTasksPending() const { return !background_tasks_.empty(); }
+
+  void ClearIdleTask() {
+    delete idle_task_;
+    idle_task_ = nullptr;
+  }
+
+  void set_idle_tasks_enabled(bool enabled) { idle_tasks_enabled_ = enabled; }
+
+ private:
+  double time_;
+  double time_step_;
+  bool idle_tasks_enabled_;
+
+  IdleTask* idle_task_;
+  std::vector<Task*> background_tasks_;
+
+  DISALLOW_COPY_AND_ASSIGN(MockPlatform);
+};
+
+void RunJS(v8::Isolate* isolate, const char* source) {
+  v8::Script::Compile(isolate->GetCurrentContext(),
+                      v8::String::NewFromUtf8(isolate, source,
+                                              v8::NewStringType::kNormal)
+                          .ToLocalChecked())
+      .ToLocalChecked()
+      ->Run(isolate->GetCurrentContext())
+      .ToLocalChecked();
+}
+
+// Runs |source|, which has to return a lazily compiled function.
+Handle<JSFunction> CreateLazyFunction(v8::Isolate* isolate,
+                                      const char* source) {
+  Handle<JSFunction> function = Handle<JSFunction>::cast(Utils::OpenHandle(
+      *v8::Script::Compile(isolate->GetCurrentContext(),
+                           v8::String::NewFromUtf8(isolate, source,
+                                                   v8::NewStringType::kNormal)
+                               .ToLocalChecked())
+           .ToLocalChecked()
+           ->Run(isolate->GetCurrentContext())
+           .ToLocalChecked()));
+  CHECK(!function->shared()->is_compiled());
+  return function;
+}
+
+}  // namespace
+
+TEST_F(CompilerDispatcherTest, Construct) {
+  MockPlatform platform;
+  CompilerDispatcher dispatcher(i_isolate(), &platform, FLAG_stack_size);
+}
+
+TEST_F(CompilerDispatcherTest, IsEnqueued) {
+  MockPlatform platform;
+  CompilerDispatcher dispatcher(i_isolate(), &platform, FLAG_stack_size);
+
+  Handle<JSFunction> f = CreateLazyFunction(
+      isolate(), "function g1() { function f1(x) { return x; } return f1; } "
+                 "g1();");
+  Handle<SharedFunctionInfo> shared(f->shared(), i_isolate());
+
+  ASSERT_FALSE(dispatcher.IsEnqueued(shared));
+  ASSERT_TRUE(dispatcher.Enqueue(f));
+  ASSERT_TRUE(dispatcher.IsEnqueued(shared));
+  ASSERT_FALSE(dispatcher.Enqueue(f));
+  dispatcher.AbortAll();
+  ASSERT_FALSE(dispatcher.IsEnqueued(shared));
+
+  platform.ClearIdleTask();
+}
+
+TEST_F(CompilerDispatcherTest, FinishNow) {
+  MockPlatform platform;
+  CompilerDispatcher dispatcher(i_isolate(), &platform, FLAG_stack_size);
+
+  Handle<JSFunction> f = CreateLazyFunction(
+      isolate(), "function g2() { function f2(x) { return x; } return f2; } "
+                 "g2();");
+  Handle<SharedFunctionInfo> shared(f->shared(), i_isolate());
+
+  ASSERT_TRUE(dispatcher.Enqueue(f));
+  ASSERT_TRUE(dispatcher.FinishNow(shared));
+  // Finishing removes the job from the queue.
+  ASSERT_FALSE(dispatcher.IsEnqueued(shared));
+  ASSERT_TRUE(shared->is_compiled());
+  ASSERT_TRUE(shared->HasBytecodeArray());
+
+  platform.ClearIdleTask();
+}
+
+TEST_F(CompilerDispatcherTest, IdleTaskFinishesJob) {
+  MockPlatform platform;
+  CompilerDispatcher dispatcher(i_isolate(), &platform, FLAG_stack_size);
+
+  Handle<JSFunction> f = CreateLazyFunction(
+      isolate(), "function g3() { function f3(x) { return x; } return f3; } "
+                 "g3();");
+  Handle<SharedFunctionInfo> shared(f->shared(), i_isolate());
+
+  ASSERT_TRUE(dispatcher.Enqueue(f));
+  ASSERT_TRUE(platform.IdleTaskPending());
+
+  // The source isn't external, so the main thread does everything except
+  // generating bytecode.
+  platform.RunIdleTask(1000.0, 0.0);
+  ASSERT_TRUE(dispatcher.IsEnqueued(shared));
+  ASSERT_TRUE(dispatcher.jobs_.begin()->second->status() ==
+              CompileJobStatus::kReadyToCompile);
+  ASSERT_TRUE(platform.BackgroundTasksPending());
+
+  platform.RunBackgroundTasks();
+  ASSERT_TRUE(dispatcher.jobs_.begin()->second->status() ==
+              CompileJobStatus::kCompiled);
+
+  platform.RunIdleTask(1000.0, 0.0);
+  ASSERT_FALSE(dispatcher.IsEnqueued(shared));
+  ASSERT_TRUE(shared->is_compiled());
+  ASSERT_FALSE(platform.IdleTaskPending());
+}
+
+TEST_F(CompilerDispatcherTest, IdleTaskRespectsDeadline) {
+  MockPlatform platform;
+  CompilerDispatcher dispatcher(i_isolate(), &platform, FLAG_stack_size);
+
+  Handle<JSFunction> f = CreateLazyFunction(
+      isolate(), "function g4() { function f4(x) { return x; } return f4; } "
+                 "g4();");
+  Handle<SharedFunctionInfo> shared(f->shared(), i_isolate());
+
+  ASSERT_TRUE(dispatcher.Enqueue(f));
+
+  // Every step takes a second, so the idle task only has time for one step
+  // and posts another idle task.
+  platform.RunIdleTask(1.5, 1.0);
+  ASSERT_TRUE(dispatcher.IsEnqueued(shared));
+  ASSERT_FALSE(shared->is_compiled());
+  ASSERT_TRUE(platform.IdleTaskPending());
+
+  dispatcher.AbortAll();
+  platform.ClearIdleTask();
+}
+
+TEST_F(CompilerDispatcherTest, AbortAll) {
+  MockPlatform platform;
+  CompilerDispatcher dispatcher(i_isolate(), &platform, FLAG_stack_size);
+
+  Handle<JSFunction> f = CreateLazyFunction(
+      isolate(), "function g5() { function f5(x) { return x; } return f5; } "
+                 "g5();");
+  Handle<SharedFunctionInfo> shared(f->shared(), i_isolate());
+
+  ASSERT_TRUE(dispatcher.Enqueue(f));
+  platform.RunIdleTask(1000.0, 0.0);
+  ASSERT_TRUE(platform.BackgroundTasksPending());
+
+  // Aborting drops the job before the background task got to it.
+  dispatcher.AbortAll();
+  ASSERT_FALSE(dispatcher.IsEnqueued(shared));
+  platform.RunBackgroundTasks();
+  ASSERT_FALSE(shared->is_compiled());
+
+  platform.ClearIdleTask();
+}
+
+TEST_F(CompilerDispatcherTest, RequiresIdleTasks) {
+  MockPlatform platform;
+  platform.set_idle_tasks_enabled(false);
+  CompilerDispatcher dispatcher(i_isolate(), &platform, FLAG_stack_size);
+
+  Handle<JSFunction> f = CreateLazyFunction(
+      isolate(), "function g6() { function f6(x) { return x; } return f6; } "
+                 "g6();");
+  Handle<SharedFunctionInfo> shared(f->shared(), i_isolate());
+
+  // Without idle tasks, the job would only finish when the function is called.
+  ASSERT_FALSE(dispatcher.Enqueue(f));
+  ASSERT_FALSE(dispatcher.IsEnqueued(shared));
+  ASSERT_FALSE(platform.IdleTaskPending());
+}
+
+TEST_F(CompilerDispatcherTest, LimitsNumberOfJobs) {
+  MockPlatform platform;
+  CompilerDispatcher dispatcher(i_isolate(), &platform, FLAG_stack_size);
+
+  std::string source = "var fs7 = [";
+  for (size_t i = 0; i <= CompilerDispatcher::kMaxJobs; ++i) {
+    source += "function(x) { return x; },";
+  }
+  source += "];";
+  RunJS(isolate(), source.c_str());
+
+  for (size_t i = 0; i <= CompilerDispatcher::kMaxJobs; ++i) {
+    std::string element = "fs7[" + std::to_string(i) + "];";
+    Handle<JSFunction> f = CreateLazyFunction(isolate(), element.c_str());
+    ASSERT_EQ(i < CompilerDispatcher::kMaxJobs, dispatcher.Enqueue(f));
+  }
+  ASSERT_EQ(CompilerDispatcher::kMaxJobs, dispatcher.jobs_.size());
+
+  dispatcher.AbortAll();
+  platform.ClearIdleTask();
+}
+
+TEST_F(CompilerDispatcherTest, DropsJobsOfCollectedClosures) {
+  MockPlatform platform;
+  CompilerDispatcher dispatcher(i_isolate(), &platform, FLAG_stack_size);
+
+  Handle<SharedFunctionInfo> shared;
+  {
+    HandleScope scope(i_isolate());
+    Handle<JSFunction> f = CreateLazyFunction(
+        isolate(), "function g8() { function f8(x) { return x; } return f8; } "
+                   "g8();");
+    ASSERT_TRUE(dispatcher.Enqueue(f));
+    shared = scope.CloseAndEscape(handle(f->shared(), i_isolate()));
+  }
+
+  // The job doesn't keep the closure alive.
+  i_isolate()->heap()->CollectAllAvailableGarbage();
+  ASSERT_FALSE(dispatcher.IsEnqueued(shared));
+
+  // The next idle task drops the job without compiling the function.
+  platform.RunIdleTask(1000.0, 0.0);
+  ASSERT_TRUE(dispatcher.jobs_.empty());
+  ASSERT_FALSE(shared->is_compiled());
+  ASSERT_FALSE(platform.IdleTaskPending());
+}
+
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,128 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <vector>
+
+#include "include/v8.h"
+#include "src/api.h"
+#include "src/base/platform/semaphore.h"
+#include "src/compiler-dispatcher/optimizing-compile-dispatcher.h"
+#include "src/compiler.h"
+#include "src/flags.h"
+#include "src/handles.h"
+#include "src/isolate-inl.h"
+#include "src/parsing/parser.h"
+#include "test/unittests/test-utils.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace v8 {
+namespace internal {
+
+typedef TestWithContext OptimizingCompileDispatcherTest;
+
+namespace {
+
+// Records the order in which the dispatcher optimizes jobs.
+class RecordingCompilationJob : public CompilationJob {
+ public:
+  RecordingCompilationJob(Isolate* isolate, Handle<JSFunction> function,
+                          int id, std::vector<int>* order,
+                          base::Semaphore* optimized)
+      : CompilationJob(&info_, "Recording"),
+        zone_(isolate->allocator()),
+        parse_info_(&zone_, function),
+        info_(&parse_info_, function),
+        id_(id),
+        order_(order),
+        optimized_(optimized) {}
+
+ protected:
+  Status CreateGraphImpl() override { return SUCCEEDED; }
+
+  Status OptimizeGraphImpl() override {
+    order_->push_back(id_);
+    optimized_->Signal();
+    return SUCCEEDED;
+  }
+
+  Status GenerateCodeImpl() override {
+    UNREACHABLE();
+    return FAILED;
+  }
+
+ private:
+  Zone zone_;
+  ParseInfo parse_info_;
+  CompilationInfo info_;
+  int id_;
+  std::vector<int>* order_;
+  base::Semaphore* optimized_;
+
+  DISALLOW_COPY_AND_ASSIGN(RecordingCompilationJob);
+};
+
+Handle<JSFunction> CreateFunction(v8::Isolate* isolate, const char* source) {
+  return Handle<JSFunction>::cast(Utils::OpenHandle(
+      *v8::Script::Compile(isolate->GetCurrentContext(),
+                           v8::String::NewFromUtf8(isolate, source,
+                                                   v8::NewStringType::kNormal)
+                               .ToLocalChecked())
+           .ToLocalChecked()
+           ->Run(isolate->GetCurrentContext())
+           .ToLocalChecked()));
+}
+
+}  // namespace
+
+TEST_F(OptimizingCompileDispatcherTest, MaxTasks) {
+  int old_tasks = FLAG_concurrent_recompilation_tasks;
+  FLAG_concurrent_recompilation_tasks = 3;
+  {
+    OptimizingCompileDispatcher dispatcher(i_isolate());
+    ASSERT_EQ(3, dispatcher.max_tasks());
+  }
+  FLAG_concurrent_recompilation_tasks = 0;
+  {
+    OptimizingCompileDispatcher dispatcher(i_isolate());
+    ASSERT_LE(1, dispatcher.max_tasks());
+  }
+  FLAG_concurrent_recompilation_tasks = old_tasks;
+}
+
+TEST_F(OptimizingCompileDispatcherTest, HotterFunctionsFirst) {
+  bool old_block = FLAG_block_concurrent_recompilation;
+  int old_tasks = FLAG_concurrent_recompilation_tasks;
+  FLAG_block_concurrent_recompilation = true;
+  FLAG_concurrent_recompilation_tasks = 1;
+
+  OptimizingCompileDispatcher dispatcher(i_isolate());
+  std::vector<int> order;
+  base::Semaphore optimized(0);
+  const int kTicks[] = {1, 5, 3, 5};
+  const int kJobs = arraysize(kTicks);
+  for (int i = 0; i < kJobs; i++) {
+    Handle<JSFunction> function = CreateFunction(isolate(), "(function() {})");
+    function->shared()->set_profiler_ticks(kTicks[i]);
+    ASSERT_TRUE(dispatcher.IsQueueAvailable());
+    dispatcher.QueueForOptimization(new RecordingCompilationJob(
+        i_isolate(), function, i, &order, &optimized));
+  }
+
+  // A single task takes the jobs by priority and in queue order otherwise.
+  dispatcher.Unblock();
+  for (int i = 0; i < kJobs; i++) optimized.Wait();
+  dispatcher.Stop();
+
+  ASSERT_EQ(static_cast<size_t>(kJobs), order.size());
+  ASSERT_EQ(1, order[0]);
+  ASSERT_EQ(3, order[1]);
+  ASSERT_EQ(2, order[2]);
+  ASSERT_EQ(0, order[3]);
+
+  FLAG_block_concurrent_recompilation = old_block;
+  FLAG_concurrent_recompilation_tasks = old_tasks;
+}
+
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,114 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/compiler/bounds-check-elimination.h"
+#include "src/compiler/loop-variable-optimizer.h"
+#include "src/compiler/node-properties.h"
+#include "src/compiler/node.h"
+#include "src/compiler/simplified-operator.h"
+#include "test/unittests/compiler/graph-reducer-unittest.h"
+#include "test/unittests/compiler/graph-unittest.h"
+#include "test/unittests/compiler/node-test-utils.h"
+#include "testing/gmock-support.h"
+
+using testing::_;
+using testing::StrictMock;
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+class BoundsCheckEliminationTest : public TypedGraphTest {
+ public:
+  BoundsCheckEliminationTest() : TypedGraphTest(3), simplified_(zone()) {}
+  ~BoundsCheckEliminationTest() override {}
+
+ protected:
+  // Builds {for (i = 0; i < bound; ++i) CheckBounds(i, length)} and returns
+  // the bounds check.
+  Node* NewCountedLoop(Type* index_type, Node* bound, Node* length) {
+    Node* loop = graph()->NewNode(common()->Loop(2), start(), start());
+    Node* phi =
+        graph()->NewNode(common()->Phi(MachineRepresentation::kTagged, 2),
+                         NumberConstant(0), NumberConstant(0), loop);
+    NodeProperties::SetType(phi, index_type);
+    Node* inc =
+        graph()->NewNode(simplified()->NumberAdd(), phi, NumberConstant(1));
+    phi->ReplaceInput(1, inc);
+    Node* effect_phi =
+        graph()->NewNode(common()->EffectPhi(2), start(), start(), loop);
+    Node* cmp = graph()->NewNode(simplified()->NumberLessThan(), phi, bound);
+    Node* branch = graph()->NewNode(common()->Branch(), cmp, loop);
+    Node* if_true = graph()->NewNode(common()->IfTrue(), branch);
+    Node* check = graph()->NewNode(simplified()->CheckBounds(), phi, length,
+                                   effect_phi, if_true);
+    effect_phi->ReplaceInput(1, check);
+    loop->ReplaceInput(1, if_true);
+    return check;
+  }
+
+  Reduction Reduce(AdvancedReducer::Editor* editor, Node* node) {
+    LoopVariableOptimizer induction_vars(graph(), common(), zone());
+    induction_vars.Run();
+    BoundsCheckElimination reducer(editor, &induction_vars);
+    return reducer.Reduce(node);
+  }
+
+  SimplifiedOperatorBuilder* simplified() { return &simplified_; }
+
+ private:
+  SimplifiedOperatorBuilder simplified_;
+};
+
+TEST_F(BoundsCheckEliminationTest, CheckBoundsAgainstLoopBound) {
+  Node* length = Parameter(Type::Range(0, 1000, zone()), 0);
+  Node* check = NewCountedLoop(Type::Range(0, 1000, zone()), length, length);
+  Node* index = NodeProperties::GetValueInput(check, 0);
+
+  StrictMock<MockAdvancedReducerEditor> editor;
+  EXPECT_CALL(editor, ReplaceWithValue(check, index,
+                                       NodeProperties::GetEffectInput(check),
+                                       _));
+  Reduction r = Reduce(&editor, check);
+  ASSERT_TRUE(r.Changed());
+  EXPECT_EQ(index, r.replacement());
+}
+
+TEST_F(BoundsCheckEliminationTest, CheckBoundsAgainstSmallerLoopBound) {
+  Node* bound = Parameter(Type::Range(0, 10, zone()), 0);
+  Node* length = Parameter(Type::Range(10, 100, zone()), 1);
+  Node* check = NewCountedLoop(Type::Range(0, 10, zone()), bound, length);
+  Node* index = NodeProperties::GetValueInput(check, 0);
+
+  StrictMock<MockAdvancedReducerEditor> editor;
+  EXPECT_CALL(editor, ReplaceWithValue(check, index,
+                                       NodeProperties::GetEffectInput(check),
+                                       _));
+  Reduction r = Reduce(&editor, check);
+  ASSERT_TRUE(r.Changed());
+  EXPECT_EQ(index, r.replacement());
+}
+
+TEST_F(BoundsCheckEliminationTest, CheckBoundsAgainstLargerLoopBound) {
+  Node* bound = Parameter(Type::Range(0, 100, zone()), 0);
+  Node* length = Parameter(Type::Range(10, 100, zone()), 1);
+  Node* check = NewCountedLoop(Type::Range(0, 100, zone()), bound, length);
+
+  StrictMock<MockAdvancedReducerEditor> editor;
+  Reduction r = Reduce(&editor, check);
+  ASSERT_FALSE(r.Changed());
+}
+
+TEST_F(BoundsCheckEliminationTest, CheckBoundsWithNegativeIndex) {
+  Node* length = Parameter(Type::Range(0, 1000, zone()), 0);
+  Node* check = NewCountedLoop(Type::Range(-1, 1000, zone()), length, length);
+
+  StrictMock<MockAdvancedReducerEditor> editor;
+  Reduction r = Reduce(&editor, check);
+  ASSERT_FALSE(r.Changed());
+}
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,132 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/compiler/global-value-numbering.h"
+#include "src/compiler/access-builder.h"
+#include "src/compiler/graph.h"
+#include "src/compiler/node-properties.h"
+#include "src/compiler/node.h"
+#include "src/compiler/scheduler.h"
+#include "src/compiler/simplified-operator.h"
+#include "test/unittests/compiler/graph-unittest.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+class GlobalValueNumberingTest : public GraphTest {
+ public:
+  GlobalValueNumberingTest() : GraphTest(3), simplified_(zone()) {}
+  ~GlobalValueNumberingTest() override {}
+
+ protected:
+  // Returns {value} from {effect} and {control} and ends the graph there.
+  Node* Return(Node* value, Node* effect, Node* control) {
+    Node* ret = graph()->NewNode(common()->Return(), value, effect, control);
+    graph()->SetEnd(graph()->NewNode(common()->End(1), ret));
+    return ret;
+  }
+
+  size_t RunGlobalValueNumbering() {
+    Schedule* schedule =
+        Scheduler::ComputeSchedule(zone(), graph(), Scheduler::kNoFlags);
+    GlobalValueNumbering gvn(graph(), schedule, zone());
+    gvn.Run();
+    return gvn.eliminated_count();
+  }
+
+  Node* LoadLength(Node* object, Node* effect, Node* control) {
+    return graph()->NewNode(
+        simplified()->LoadField(AccessBuilder::ForJSArrayLength(FAST_ELEMENTS)),
+        object, effect, control);
+  }
+
+  SimplifiedOperatorBuilder* simplified() { return &simplified_; }
+
+ private:
+  SimplifiedOperatorBuilder simplified_;
+};
+
+TEST_F(GlobalValueNumberingTest, ReusesLoadAfterDiamond) {
+  Node* object = Parameter(0);
+  Node* load = LoadLength(object, start(), start());
+  Node* branch = graph()->NewNode(common()->Branch(), Parameter(1), start());
+  Node* if_true = graph()->NewNode(common()->IfTrue(), branch);
+  Node* if_false = graph()->NewNode(common()->IfFalse(), branch);
+  Node* merge = graph()->NewNode(common()->Merge(2), if_true, if_false);
+  Node* effect =
+      graph()->NewNode(common()->EffectPhi(2), load, load, merge);
+  Node* reload = LoadLength(object, effect, merge);
+  Node* ret = Return(reload, reload, merge);
+
+  EXPECT_EQ(1u, RunGlobalValueNumbering());
+  EXPECT_EQ(load, NodeProperties::GetValueInput(ret, 0));
+  EXPECT_EQ(effect, NodeProperties::GetEffectInput(ret));
+}
+
+TEST_F(GlobalValueNumberingTest, KeepsLoadAfterStoreOnOnePath) {
+  Node* object = Parameter(0);
+  Node* load = LoadLength(object, start(), start());
+  Node* branch = graph()->NewNode(common()->Branch(), Parameter(1), start());
+  Node* if_true = graph()->NewNode(common()->IfTrue(), branch);
+  Node* store = graph()->NewNode(
+      simplified()->StoreField(AccessBuilder::ForJSArrayLength(FAST_ELEMENTS)),
+      object, Parameter(2), load, if_true);
+  Node* if_false = graph()->NewNode(common()->IfFalse(), branch);
+  Node* merge = graph()->NewNode(common()->Merge(2), if_true, if_false);
+  Node* effect =
+      graph()->NewNode(common()->EffectPhi(2), store, load, merge);
+  Node* reload = LoadLength(object, effect, merge);
+  Node* ret = Return(reload, reload, merge);
+
+  EXPECT_EQ(0u, RunGlobalValueNumbering());
+  EXPECT_EQ(reload, NodeProperties::GetValueInput(ret, 0));
+}
+
+TEST_F(GlobalValueNumberingTest, KeepsLoadInLoopWithStore) {
+  Node* object = Parameter(0);
+  Node* load = LoadLength(object, start(), start());
+  Node* loop = graph()->NewNode(common()->Loop(2), start(), start());
+  Node* effect_phi =
+      graph()->NewNode(common()->EffectPhi(2), load, load, loop);
+  Node* reload = LoadLength(object, effect_phi, loop);
+  Node* branch = graph()->NewNode(common()->Branch(), Parameter(1), loop);
+  Node* if_true = graph()->NewNode(common()->IfTrue(), branch);
+  Node* store = graph()->NewNode(
+      simplified()->StoreField(AccessBuilder::ForJSArrayLength(FAST_ELEMENTS)),
+      object, Parameter(2), reload, if_true);
+  effect_phi->ReplaceInput(1, store);
+  loop->ReplaceInput(1, if_true);
+  Node* if_false = graph()->NewNode(common()->IfFalse(), branch);
+  Node* ret = Return(reload, reload, if_false);
+
+  EXPECT_EQ(0u, RunGlobalValueNumbering());
+  EXPECT_EQ(reload, NodeProperties::GetValueInput(ret, 0));
+}
+
+TEST_F(GlobalValueNumberingTest, RemovesCheckAfterDiamond) {
+  Node* condition = Parameter(2);
+  Node* frame_state = EmptyFrameState();
+  Node* check = graph()->NewNode(
+      common()->DeoptimizeUnless(DeoptimizeReason::kWrongMap), condition,
+      frame_state, start(), start());
+  Node* branch = graph()->NewNode(common()->Branch(), Parameter(1), check);
+  Node* if_true = graph()->NewNode(common()->IfTrue(), branch);
+  Node* if_false = graph()->NewNode(common()->IfFalse(), branch);
+  Node* merge = graph()->NewNode(common()->Merge(2), if_true, if_false);
+  Node* effect =
+      graph()->NewNode(common()->EffectPhi(2), check, check, merge);
+  Node* recheck = graph()->NewNode(
+      common()->DeoptimizeUnless(DeoptimizeReason::kSmi), condition,
+      frame_state, effect, merge);
+  Node* ret = Return(Parameter(0), recheck, recheck);
+
+  EXPECT_EQ(1u, RunGlobalValueNumbering());
+  EXPECT_EQ(effect, NodeProperties::GetEffectInput(ret));
+  EXPECT_EQ(merge, NodeProperties::GetControlInput(ret));
+}
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,87 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/compiler/instruction-scheduler.h"
+#include "test/unittests/test-utils.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+class InstructionSchedulerPPCTest : public TestWithIsolateAndZone {
+ public:
+  InstructionSchedulerPPCTest()
+      : blocks_(1,
+                new (zone()) InstructionBlock(zone(), RpoNumber::FromInt(0),
+                                              RpoNumber::Invalid(),
+                                              RpoNumber::Invalid(), false,
+                                              false),
+                zone()),
+        sequence_(isolate(), zone(), &blocks_),
+        scheduler_(zone(), &sequence_),
+        parameter_(sequence_.NextVirtualRegister()) {}
+
+ protected:
+  InstructionSequence* sequence() { return &sequence_; }
+
+  void StartBlock() { scheduler_.StartBlock(RpoNumber::FromInt(0)); }
+  void EndBlock() { scheduler_.EndBlock(RpoNumber::FromInt(0)); }
+
+  // Adds an instruction with a single input and output, and returns the
+  // virtual register it defines.
+  int Emit(ArchOpcode opcode, int input) {
+    int output = sequence_.NextVirtualRegister();
+    InstructionOperand outputs[] = {
+        UnallocatedOperand(UnallocatedOperand::MUST_HAVE_REGISTER, output)};
+    InstructionOperand inputs[] = {
+        UnallocatedOperand(UnallocatedOperand::MUST_HAVE_REGISTER, input)};
+    scheduler_.AddInstruction(Instruction::New(
+        zone(), opcode, arraysize(outputs), outputs, arraysize(inputs), inputs,
+        0, nullptr));
+    return output;
+  }
+
+  int parameter() const { return parameter_; }
+
+  ArchOpcode OpcodeAt(int index) {
+    return sequence_.InstructionAt(index)->arch_opcode();
+  }
+
+ private:
+  InstructionBlocks blocks_;
+  InstructionSequence sequence_;
+  InstructionScheduler scheduler_;
+  int parameter_;
+};
+
+
+TEST_F(InstructionSchedulerPPCTest, DivideBeforeIndependentAdd) {
+  StartBlock();
+  Emit(kPPC_Add, parameter());
+  int quotient = Emit(kPPC_Div64, parameter());
+  Emit(kPPC_Sub, quotient);
+  EndBlock();
+  EXPECT_EQ(kPPC_Div64, OpcodeAt(0));
+  EXPECT_EQ(kPPC_Add, OpcodeAt(1));
+  EXPECT_EQ(kPPC_Sub, OpcodeAt(2));
+}
+
+
+TEST_F(InstructionSchedulerPPCTest, LongestChainFirst) {
+  StartBlock();
+  int product = Emit(kPPC_Mul32, parameter());
+  Emit(kPPC_Add, product);
+  int sum = Emit(kPPC_AddDouble, parameter());
+  Emit(kPPC_SqrtDouble, sum);
+  int load = Emit(kPPC_LoadWord64, parameter());
+  Emit(kPPC_Xor, load);
+  EndBlock();
+  EXPECT_EQ(kPPC_AddDouble, OpcodeAt(0));
+  EXPECT_EQ(kPPC_Mul32, OpcodeAt(1));
+  EXPECT_EQ(kPPC_LoadWord64, OpcodeAt(2));
+}
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
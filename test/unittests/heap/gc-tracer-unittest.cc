@@ -45,5 +45,47 @@ TEST(GCTracer, AverageSpeed) {
       GCTracer::AverageSpeed(buffer, MakeBytesAndDuration(0, 0), buffer.kSize));
 }
 
+TEST(GCTracer, PauseHistogramBuckets) {
+  for (uint32_t i = 0; i < PauseHistogram::kLinearBuckets; i++) {
+    EXPECT_EQ(static_cast<int>(i), PauseHistogram::BucketIndex(i));
+  }
+  // Every value falls into a bucket whose bound is above the value and at
+  // most 12.5% away from it.
+  int previous_index = PauseHistogram::BucketIndex(0);
+  for (uint32_t value = 1; value < 1000000; value = value * 9 / 8 + 1) {
+    int index = PauseHistogram::BucketIndex(value);
+    EXPECT_LE(previous_index, index);
+    EXPECT_LT(value, PauseHistogram::BucketLimit(index));
+    EXPECT_LE(PauseHistogram::BucketLimit(index), value + value / 8 + 1);
+    previous_index = index;
+  }
+  EXPECT_EQ(PauseHistogram::kNumBuckets - 1,
+            PauseHistogram::BucketIndex(std::numeric_limits<uint32_t>::max()));
+}
+
+TEST(GCTracer, PauseHistogramPercentiles) {
+  PauseHistogram histogram;
+  EXPECT_EQ(0, histogram.count());
+  EXPECT_EQ(0, histogram.Percentile(50));
+  for (int i = 1; i <= 100; i++) {
+    histogram.AddSample(i);
+  }
+  EXPECT_EQ(100, histogram.count());
+  EXPECT_EQ(5050, histogram.total_ms());
+  EXPECT_EQ(100, histogram.max_ms());
+  EXPECT_LE(50, histogram.Percentile(50));
+  EXPECT_GE(50 * 1.125, histogram.Percentile(50));
+  EXPECT_LE(90, histogram.Percentile(90));
+  EXPECT_GE(90 * 1.125, histogram.Percentile(90));
+  EXPECT_LE(99, histogram.Percentile(99));
+  EXPECT_GE(100, histogram.Percentile(99));
+  EXPECT_EQ(100, histogram.Percentile(100));
+  histogram.AddSample(0.0005);
+  EXPECT_EQ(0.001, histogram.Percentile(0));
+  histogram.Reset();
+  EXPECT_EQ(0, histogram.count());
+  EXPECT_EQ(0, histogram.max_ms());
+}
+
 }  // namespace internal
 }  // namespace v8
@@ -110,6 +110,55 @@ TEST(Marking, TransitionWhiteGreyBlackGrey) {
   free(bitmap);
 }
 
+TEST(Marking, AtomicTransitionWhiteGreyBlack) {
+  Bitmap* bitmap = reinterpret_cast<Bitmap*>(
+      calloc(Bitmap::kSize / kPointerSize, kPointerSize));
+  const int kLocationsSize = 3;
+  int position[kLocationsSize] = {
+      Bitmap::kBitsPerCell - 2, Bitmap::kBitsPerCell - 1, Bitmap::kBitsPerCell};
+  for (int i = 0; i < kLocationsSize; i++) {
+    MarkBit mark_bit = bitmap->MarkBitFromIndex(position[i]);
+    CHECK(Marking::IsWhite<MarkBit::ATOMIC>(mark_bit));
+    CHECK(Marking::TryWhiteToGrey<MarkBit::ATOMIC>(mark_bit));
+    CHECK(Marking::IsGrey(mark_bit));
+    CHECK(!Marking::TryWhiteToGrey<MarkBit::ATOMIC>(mark_bit));
+    CHECK(Marking::TryGreyToBlack<MarkBit::ATOMIC>(mark_bit));
+    CHECK(Marking::IsBlack<MarkBit::ATOMIC>(mark_bit));
+    CHECK(!Marking::TryGreyToBlack<MarkBit::ATOMIC>(mark_bit));
+    CHECK(!Marking::IsImpossible(mark_bit));
+    Marking::MarkWhite(mark_bit);
+    CHECK(Marking::IsWhite<MarkBit::ATOMIC>(mark_bit));
+  }
+  free(bitmap);
+}
+
+TEST(Marking, NonAtomicTryWhiteToGrey) {
+  Bitmap* bitmap = reinterpret_cast<Bitmap*>(
+      calloc(Bitmap::kSize / kPointerSize, kPointerSize));
+  MarkBit mark_bit = bitmap->MarkBitFromIndex(Bitmap::kBitsPerCell - 1);
+  CHECK(Marking::TryWhiteToGrey<MarkBit::NON_ATOMIC>(mark_bit));
+  CHECK(!Marking::TryWhiteToGrey<MarkBit::NON_ATOMIC>(mark_bit));
+  CHECK(Marking::TryGreyToBlack<MarkBit::NON_ATOMIC>(mark_bit));
+  CHECK(Marking::IsBlack<MarkBit::NON_ATOMIC>(mark_bit));
+  free(bitmap);
+}
+
+TEST(Marking, AtomicAnyToGrey) {
+  Bitmap* bitmap = reinterpret_cast<Bitmap*>(
+      calloc(Bitmap::kSize / kPointerSize, kPointerSize));
+  MarkBit mark_bit = bitmap->MarkBitFromIndex(Bitmap::kBitsPerCell - 1);
+  CHECK(!Marking::AnyToGrey<MarkBit::ATOMIC>(mark_bit));
+  CHECK(Marking::IsGrey<MarkBit::ATOMIC>(mark_bit));
+  CHECK(!Marking::AnyToGrey<MarkBit::ATOMIC>(mark_bit));
+  Marking::MarkBlack<MarkBit::ATOMIC>(mark_bit);
+  CHECK(Marking::IsBlack<MarkBit::ATOMIC>(mark_bit));
+  CHECK(Marking::AnyToGrey<MarkBit::ATOMIC>(mark_bit));
+  CHECK(Marking::IsGrey<MarkBit::ATOMIC>(mark_bit));
+  Marking::MarkWhite(mark_bit);
+  CHECK(Marking::IsWhite<MarkBit::ATOMIC>(mark_bit));
+  free(bitmap);
+}
+
 TEST(Marking, SetAndClearRange) {
   Bitmap* bitmap = reinterpret_cast<Bitmap*>(
       calloc(Bitmap::kSize / kPointerSize, kPointerSize));
@@ -124,6 +173,27 @@ TEST(Marking, SetAndClearRange) {
   free(bitmap);
 }
 
+TEST(Marking, SetAndClearRangePreservesNeighbours) {
+  Bitmap* bitmap = reinterpret_cast<Bitmap*>(
+      calloc(Bitmap::kSize / kPointerSize, kPointerSize));
+  uint32_t* cells = reinterpret_cast<uint32_t*>(bitmap);
+  cells[0] = 0x1;
+  cells[2] = 0x80000000;
+  bitmap->SetRange(4, 2 * Bitmap::kBitsPerCell + 4);
+  CHECK_EQ(cells[0], 0xfffffff1);
+  CHECK_EQ(cells[1], 0xffffffff);
+  CHECK_EQ(cells[2], 0x8000000f);
+  bitmap->ClearRange(4, 2 * Bitmap::kBitsPerCell + 4);
+  CHECK_EQ(cells[0], 0x1);
+  CHECK_EQ(cells[1], 0x0);
+  CHECK_EQ(cells[2], 0x80000000);
+  bitmap->SetRange(8, 12);
+  CHECK_EQ(cells[0], 0xf01);
+  bitmap->ClearRange(0, 9);
+  CHECK_EQ(cells[0], 0xe00);
+  free(bitmap);
+}
+
 TEST(Marking, ClearMultipleRanges) {
   Bitmap* bitmap = reinterpret_cast<Bitmap*>(
       calloc(Bitmap::kSize / kPointerSize, kPointerSize));
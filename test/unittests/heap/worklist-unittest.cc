@@ -0,0 +1,100 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/heap/worklist.h"
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace v8 {
+namespace internal {
+
+class SomeObject {};
+
+typedef Worklist<SomeObject*, 64> TestWorklist;
+
+TEST(WorkListTest, SegmentCreate) {
+  TestWorklist worklist;
+  EXPECT_TRUE(worklist.IsLocalEmpty(0));
+  EXPECT_TRUE(worklist.IsGlobalEmpty());
+}
+
+TEST(WorkListTest, PushPopLocal) {
+  TestWorklist worklist;
+  TestWorklist::View view(&worklist, 0);
+  SomeObject dummy;
+  SomeObject* retrieved = nullptr;
+  EXPECT_TRUE(view.Push(&dummy));
+  EXPECT_FALSE(view.IsLocalEmpty());
+  EXPECT_TRUE(view.Pop(&retrieved));
+  EXPECT_EQ(&dummy, retrieved);
+  EXPECT_TRUE(view.IsLocalEmpty());
+  EXPECT_FALSE(view.Pop(&retrieved));
+}
+
+TEST(WorkListTest, LocalEntriesAreNotStolen) {
+  TestWorklist worklist;
+  TestWorklist::View view1(&worklist, 0);
+  TestWorklist::View view2(&worklist, 1);
+  SomeObject dummy;
+  SomeObject* retrieved = nullptr;
+  EXPECT_TRUE(view1.Push(&dummy));
+  EXPECT_FALSE(view2.Pop(&retrieved));
+  EXPECT_TRUE(view1.Pop(&retrieved));
+  EXPECT_EQ(&dummy, retrieved);
+}
+
+TEST(WorkListTest, FullSegmentsArePublished) {
+  TestWorklist worklist;
+  TestWorklist::View view1(&worklist, 0);
+  TestWorklist::View view2(&worklist, 1);
+  SomeObject dummy;
+  SomeObject* retrieved = nullptr;
+  // The first segment fills up and is published once one more entry is
+  // pushed.
+  for (int i = 0; i < TestWorklist::kSegmentCapacity + 1; i++) {
+    EXPECT_TRUE(view1.Push(&dummy));
+  }
+  EXPECT_FALSE(worklist.IsGlobalPoolEmpty());
+  EXPECT_EQ(static_cast<size_t>(TestWorklist::kSegmentCapacity),
+            worklist.GlobalPoolSize());
+  for (int i = 0; i < TestWorklist::kSegmentCapacity; i++) {
+    EXPECT_TRUE(view2.Pop(&retrieved));
+    EXPECT_EQ(&dummy, retrieved);
+  }
+  EXPECT_FALSE(view2.Pop(&retrieved));
+  EXPECT_TRUE(view1.Pop(&retrieved));
+  EXPECT_TRUE(worklist.IsGlobalEmpty());
+}
+
+TEST(WorkListTest, FlushToGlobalMakesEntriesStealable) {
+  TestWorklist worklist;
+  TestWorklist::View view1(&worklist, 0);
+  TestWorklist::View view2(&worklist, 1);
+  SomeObject dummy;
+  SomeObject* retrieved = nullptr;
+  EXPECT_TRUE(view1.Push(&dummy));
+  EXPECT_TRUE(view1.Push(&dummy));
+  view1.FlushToGlobal();
+  EXPECT_TRUE(view1.IsLocalEmpty());
+  EXPECT_FALSE(worklist.IsGlobalPoolEmpty());
+  EXPECT_TRUE(view2.Pop(&retrieved));
+  EXPECT_TRUE(view2.Pop(&retrieved));
+  EXPECT_FALSE(view2.Pop(&retrieved));
+  EXPECT_TRUE(worklist.IsGlobalEmpty());
+}
+
+TEST(WorkListTest, Clear) {
+  TestWorklist worklist;
+  TestWorklist::View view(&worklist, 0);
+  SomeObject dummy;
+  for (int i = 0; i < 3 * TestWorklist::kSegmentCapacity; i++) {
+    EXPECT_TRUE(view.Push(&dummy));
+  }
+  EXPECT_FALSE(worklist.IsGlobalEmpty());
+  worklist.Clear();
+  EXPECT_TRUE(worklist.IsGlobalEmpty());
+}
+
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,119 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <vector>
+
+#include "src/parsing/scanner-kernels.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace v8 {
+namespace internal {
+namespace scanner_kernels {
+
+namespace {
+
+// Longer than two vectors, so that runs end in every part of a vector, in
+// the word-wise tail and in the per-code-unit tail.
+const int kMaxLength = 20;
+
+typedef const uint16_t* (*ScanFunction)(const uint16_t*, const uint16_t*);
+
+template <typename Scan>
+std::vector<ScanFunction> Kernels() {
+  std::vector<ScanFunction> kernels;
+  kernels.push_back(&ScanWords<Scan>);
+#if V8_HOST_ARCH_X64
+  kernels.push_back(&ScanVectors<Scan>);
+#endif
+  kernels.push_back(&ScanBuffer<Scan>);
+  return kernels;
+}
+
+// Scans buffers of every length up to kMaxLength that are filled with
+// |filler| and have |stop| at every position, or nowhere. The buffers are
+// allocated with their exact length, so reads past the end are caught by
+// sanitizers.
+template <typename Scan>
+void CheckRuns(uint16_t filler, uint16_t stop) {
+  ASSERT_FALSE(Scan::Stops(filler));
+  ASSERT_TRUE(Scan::Stops(stop));
+  for (ScanFunction scan : Kernels<Scan>()) {
+    for (int length = 0; length <= kMaxLength; length++) {
+      for (int position = 0; position <= length; position++) {
+        std::vector<uint16_t> buffer(length, filler);
+        if (position < length) buffer[position] = stop;
+        const uint16_t* start = buffer.data();
+        EXPECT_EQ(position, scan(start, start + length) - start)
+            << "length " << length << ", stop at " << position;
+      }
+    }
+  }
+}
+
+// Compares the kernels with Stops() for every code unit, at every position
+// of a block.
+template <typename Scan>
+void CheckAllCodeUnits(uint16_t filler) {
+  ASSERT_FALSE(Scan::Stops(filler));
+  const int kLength = 16;
+  for (ScanFunction scan : Kernels<Scan>()) {
+    for (int position = 0; position < kLength; position++) {
+      uint16_t buffer[kLength];
+      for (int i = 0; i < kLength; i++) buffer[i] = filler;
+      for (int c = 0; c <= 0xFFFF; c++) {
+        uint16_t code_unit = static_cast<uint16_t>(c);
+        buffer[position] = code_unit;
+        int expected = Scan::Stops(code_unit) ? position : kLength;
+        ASSERT_EQ(expected, scan(buffer, buffer + kLength) - buffer)
+            << "code unit " << c << " at " << position;
+      }
+    }
+  }
+}
+
+}  // namespace
+
+TEST(ScannerKernelsTest, LineTerminator) {
+  CheckRuns<LineTerminatorScan>('a', '\n');
+  CheckRuns<LineTerminatorScan>(0x2027, 0x2029);
+  CheckAllCodeUnits<LineTerminatorScan>(' ');
+}
+
+TEST(ScannerKernelsTest, MultiLineComment) {
+  CheckRuns<MultiLineCommentScan>('/', '*');
+  CheckRuns<MultiLineCommentScan>(0xFFFF, 0x2028);
+  CheckAllCodeUnits<MultiLineCommentScan>('x');
+}
+
+TEST(ScannerKernelsTest, Asterisk) {
+  CheckRuns<AsteriskScan>('\n', '*');
+  CheckAllCodeUnits<AsteriskScan>(0x2028);
+}
+
+TEST(ScannerKernelsTest, Space) {
+  CheckRuns<SpaceScan>(' ', '\n');
+  CheckRuns<SpaceScan>('\t', 0x00A0);
+  CheckAllCodeUnits<SpaceScan>(' ');
+  CheckAllCodeUnits<SpaceScan>('\t');
+}
+
+TEST(ScannerKernelsTest, AsciiIdentifier) {
+  CheckRuns<AsciiIdentifierScan>('z', '{');
+  CheckRuns<AsciiIdentifierScan>('$', 0x0100);
+  CheckRuns<AsciiIdentifierScan>('_', '`');
+  CheckAllCodeUnits<AsciiIdentifierScan>('A');
+  CheckAllCodeUnits<AsciiIdentifierScan>('9');
+}
+
+TEST(ScannerKernelsTest, String) {
+  CheckRuns<StringScan<'"'>>('\'', '"');
+  CheckRuns<StringScan<'\''>>('"', '\'');
+  CheckRuns<StringScan<'"'>>(0x7F, 0x80);
+  CheckAllCodeUnits<StringScan<'"'>>('s');
+  CheckAllCodeUnits<StringScan<'\''>>(' ');
+}
+
+}  // namespace scanner_kernels
+}  // namespace internal
+}  // namespace v8
@@ -8,6 +8,7 @@
   'variables': {
     'v8_code': 1,
     'unittests_sources': [  ### gcmole(all) ###
+      'base/accounting-allocator-unittest.cc',
       'base/atomic-utils-unittest.cc',
       'base/bits-unittest.cc',
       'base/cpu-unittest.cc',
@@ -26,6 +27,7 @@
       'base/utils/random-number-generator-unittest.cc',
       'cancelable-tasks-unittest.cc',
       'char-predicates-unittest.cc',
+      'compiler/bounds-check-elimination-unittest.cc',
       'compiler/branch-elimination-unittest.cc',
       'compiler/checkpoint-elimination-unittest.cc',
       'compiler/common-operator-reducer-unittest.cc',
@@ -37,6 +39,7 @@
       'compiler/diamond-unittest.cc',
       'compiler/effect-control-linearizer-unittest.cc',
       'compiler/escape-analysis-unittest.cc',
+      'compiler/global-value-numbering-unittest.cc',
       'compiler/graph-reducer-unittest.cc',
       'compiler/graph-reducer-unittest.h',
       'compiler/graph-trimmer-unittest.cc',
@@ -79,6 +82,8 @@
       'compiler/value-numbering-reducer-unittest.cc',
       'compiler/zone-pool-unittest.cc',
       'compiler-dispatcher/compiler-dispatcher-job-unittest.cc',
+      'compiler-dispatcher/compiler-dispatcher-unittest.cc',
+      'compiler-dispatcher/optimizing-compile-dispatcher-unittest.cc',
       'counters-unittest.cc',
       'eh-frame-iterator-unittest.cc',
       'eh-frame-writer-unittest.cc',
@@ -106,7 +111,9 @@
       'heap/heap-unittest.cc',
       'heap/scavenge-job-unittest.cc',
       'heap/slot-set-unittest.cc',
+      'heap/worklist-unittest.cc',
       'locked-queue-unittest.cc',
+      'parsing/scanner-kernels-unittest.cc',
       'register-configuration-unittest.cc',
       'run-all-unittests.cc',
       'source-position-table-unittest.cc',
@@ -143,6 +150,7 @@
       'compiler/x64/instruction-selector-x64-unittest.cc',
     ],
     'unittests_sources_ppc': [  ### gcmole(arch:ppc) ###
+      'compiler/ppc/instruction-scheduler-ppc-unittest.cc',
       'compiler/ppc/instruction-selector-ppc-unittest.cc',
     ],
     'unittests_sources_s390': [  ### gcmole(arch:s390) ###
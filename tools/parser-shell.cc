@@ -29,6 +29,7 @@
 #include <string.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <memory>
 #include <string>
 #include <vector>
 #include "src/v8.h"
@@ -57,9 +58,32 @@ class StringResource8 : public v8::String::ExternalOneByteStringResource {
   int length_;
 };
 
+// Runs the scanner alone over the source, without parsing it. Since the
+// scanner doesn't know whether a slash starts a regular expression, this is
+// only an approximation of the tokens the parser sees.
+v8::base::TimeDelta RunScanner(Handle<String> source) {
+  source = String::Flatten(source);
+  std::unique_ptr<Utf16CharacterStream> stream;
+  if (source->IsExternalOneByteString()) {
+    stream.reset(new ExternalOneByteStringUtf16CharacterStream(
+        Handle<ExternalOneByteString>::cast(source), 0, source->length()));
+  } else {
+    stream.reset(
+        new GenericStringUtf16CharacterStream(source, 0, source->length()));
+  }
+  UnicodeCache unicode_cache;
+  Scanner scanner(&unicode_cache);
+  v8::base::ElapsedTimer timer;
+  timer.Start();
+  scanner.Initialize(stream.get());
+  while (scanner.Next() != Token::EOS) {
+  }
+  return timer.Elapsed();
+}
+
 std::pair<v8::base::TimeDelta, v8::base::TimeDelta> RunBaselineParser(
     const char* fname, Encoding encoding, int repeat, v8::Isolate* isolate,
-    v8::Local<v8::Context> context) {
+    v8::Local<v8::Context> context, v8::base::TimeDelta* scan_time) {
   int length = 0;
   const byte* source = ReadFileAndRepeat(fname, &length, repeat);
   v8::Local<v8::String> source_handle;
@@ -85,6 +109,7 @@ std::pair<v8::base::TimeDelta, v8::base::TimeDelta> RunBaselineParser(
       break;
     }
   }
+  *scan_time = RunScanner(v8::Utils::OpenHandle(*source_handle));
   v8::base::TimeDelta parse_time1, parse_time2;
   Handle<Script> script =
       reinterpret_cast<i::Isolate*>(isolate)->factory()->NewScript(
@@ -170,16 +195,20 @@ int main(int argc, char* argv[]) {
     DCHECK(!context.IsEmpty());
     {
       v8::Context::Scope scope(context);
+      double scan_total = 0;
       double first_parse_total = 0;
       double second_parse_total = 0;
       for (size_t i = 0; i < fnames.size(); i++) {
+        v8::base::TimeDelta scan_time;
         std::pair<v8::base::TimeDelta, v8::base::TimeDelta> time =
             RunBaselineParser(fnames[i].c_str(), encoding, repeat, isolate,
-                              context);
+                              context, &scan_time);
+        scan_total += scan_time.InMillisecondsF();
         first_parse_total += time.first.InMillisecondsF();
         second_parse_total += time.second.InMillisecondsF();
       }
       if (benchmark.empty()) benchmark = "Baseline";
+      printf("%s(ScanRunTime): %.f ms\n", benchmark.c_str(), scan_total);
       printf("%s(FirstParseRunTime): %.f ms\n", benchmark.c_str(),
              first_parse_total);
       printf("%s(SecondParseRunTime): %.f ms\n", benchmark.c_str(),